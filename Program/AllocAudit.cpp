@@ -0,0 +1,87 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include "AllocAudit.h"
+#include <stdlib.h>
+#include <iostream>
+#include <new>
+
+thread_local long long AllocAudit::nbAllocations = 0 ;
+
+thread_local long long AllocAudit::nbAllocationsGeneration = 0 ;
+
+void AllocAudit::finGeneration (int nbIter)
+{
+	long long nbAllocationsFin = nbAllocationsGeneration ;
+	nbAllocationsGeneration = 0 ;
+	if (nbIter >= nbGenerationsWarmup && nbAllocationsFin > 0)
+	{
+		// The audit is a test (see make allocaudit), the program stops with an error status
+		cout << "ALLOCATION AUDIT : " << nbAllocationsFin << " allocations during the generation " << nbIter << " of the HGA" << endl ;
+		exit(1);
+	}
+}
+
+#ifdef ALLOC_AUDIT
+
+// Counting versions of the operators new (the memory is still managed by malloc and free)
+void * operator new (size_t size)
+{
+	AllocAudit::nbAllocations ++ ;
+	void * p = malloc(size > 0 ? size : 1) ;
+	if (p == NULL) throw std::bad_alloc() ;
+	return p ;
+}
+
+void * operator new[] (size_t size)
+{
+	return operator new (size) ;
+}
+
+void * operator new (size_t size, const std::nothrow_t &) noexcept
+{
+	AllocAudit::nbAllocations ++ ;
+	return malloc(size > 0 ? size : 1) ;
+}
+
+void * operator new[] (size_t size, const std::nothrow_t & tag) noexcept
+{
+	return operator new (size, tag) ;
+}
+
+void operator delete (void * p) noexcept
+{
+	free(p) ;
+}
+
+void operator delete[] (void * p) noexcept
+{
+	free(p) ;
+}
+
+void operator delete (void * p, size_t) noexcept
+{
+	free(p) ;
+}
+
+void operator delete[] (void * p, size_t) noexcept
+{
+	free(p) ;
+}
+
+#endif
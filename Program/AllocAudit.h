@@ -0,0 +1,68 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef ALLOC_AUDIT_H
+#define ALLOC_AUDIT_H
+
+#include <string>
+using namespace std ;
+
+// Audit of the memory allocations of the steady-state loop of the HGA, only active when the program is compiled with the flag ALLOC_AUDIT (make ALLOC_AUDIT=1)
+// In this mode, the operators new of the program are replaced by counting versions, and the allocations done during the crossover,
+// Split, local search and repair of each generation are counted (the storage of the individuals in the population is not counted)
+// After the warm-up generations, a generation with an allocation stops the program with an error status (make allocaudit runs this check on the test instances)
+// Otherwise the macros below are empty and the audit has no cost
+class AllocAudit
+{
+
+public:
+
+	// number of allocations done by the current thread
+	static thread_local long long nbAllocations ;
+
+	// number of allocations counted in the current generation
+	static thread_local long long nbAllocationsGeneration ;
+
+	// number of generations without check at the start of each run of the HGA
+	static const int nbGenerationsWarmup = 100 ;
+
+	// end of a generation of the HGA : stops the program if some allocations have been counted after the warm-up
+	static void finGeneration (int nbIter) ;
+};
+
+// Counting of the allocations done from the construction of the object to the end of its scope
+struct AllocScope {
+
+	// number of allocations of the thread at the start of the scope
+	long long debut ;
+
+	AllocScope () { debut = AllocAudit::nbAllocations ; }
+
+	~AllocScope () { AllocAudit::nbAllocationsGeneration += AllocAudit::nbAllocations - debut ; }
+};
+
+// Instrumentation of the loop of the HGA : ALLOC_AUDIT_SCOPE in each counted block, then ALLOC_AUDIT_GENERATION at the end of the generation
+#ifdef ALLOC_AUDIT
+#define ALLOC_AUDIT_SCOPE AllocScope allocScope
+#define ALLOC_AUDIT_GENERATION(nbIter) AllocAudit::finGeneration(nbIter)
+#else
+#define ALLOC_AUDIT_SCOPE
+#define ALLOC_AUDIT_GENERATION(nbIter)
+#endif
+
+#endif
@@ -0,0 +1,101 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include "AnytimeWriter.h"
+
+AnytimeWriter::AnytimeWriter(string nomFichier) : nomFichier(nomFichier)
+{
+	debut = chrono::steady_clock::now() ;
+	termine = false ;
+	nbEcrits = 0 ;
+
+	// Checking that the file can be opened, before starting the search
+	ofstream myfile(nomFichier.c_str(), std::ofstream::trunc);
+	if (!myfile.is_open())
+		throw string ("Impossible to open the anytime solution file : " + nomFichier);
+	myfile.close();
+
+	ecrivain = thread(&AnytimeWriter::run, this);
+}
+
+AnytimeWriter::~AnytimeWriter()
+{
+	{
+		lock_guard <mutex> lock(verrou);
+		termine = true ;
+	}
+	signal.notify_one();
+	ecrivain.join();
+}
+
+void AnytimeWriter::push (const SolutionSnapshot & snapshot)
+{
+	{
+		lock_guard <mutex> lock(verrou);
+		aEcrire.push_back(snapshot);
+	}
+	signal.notify_one();
+}
+
+void AnytimeWriter::run ()
+{
+	SolutionSnapshot snapshot ;
+	ofstream myfile(nomFichier.c_str(), std::ofstream::app);
+	myfile.precision(10);
+
+	while (true)
+	{
+		{
+			unique_lock <mutex> lock(verrou);
+			while (aEcrire.empty() && !termine)
+				signal.wait(lock);
+			if (aEcrire.empty())
+				break ;
+
+			// Only the most recent solution is of interest, the older ones waiting in the queue are skipped
+			snapshot = aEcrire.back() ;
+			aEcrire.clear();
+		}
+		write(myfile, snapshot);
+	}
+	myfile.close();
+}
+
+void AnytimeWriter::write (ofstream & myfile, const SolutionSnapshot & snapshot)
+{
+	// Each solution is a block "SOLUTION number cost nbRoutes time(s)", followed by one line per route and "END"
+	// Each route line gives : depot, day, index of the route, total demand, number of services, and the services in visiting order
+	int compteur = 1 ;
+	int lastDay = -1 ;
+	int lastDepot = -1 ;
+	nbEcrits ++ ;
+	myfile << "SOLUTION " << nbEcrits << " " << snapshot.cost << " " << snapshot.nbRoutes << " " << chrono::duration<double>(snapshot.time - debut).count() << endl ;
+	for (int r=0 ; r < (int)snapshot.routes.size() ; r++)
+	{
+		if (snapshot.routes[r].day != lastDay || snapshot.routes[r].depot != lastDepot) compteur = 1 ;
+		lastDay = snapshot.routes[r].day ;
+		lastDepot = snapshot.routes[r].depot ;
+		myfile << " " << snapshot.routes[r].depot << " " << snapshot.routes[r].day << " " << compteur << " " << snapshot.routes[r].load << " " << (int)snapshot.routes[r].services.size() ;
+		for (int j=0 ; j < (int)snapshot.routes[r].services.size() ; j++)
+			myfile << " " << snapshot.routes[r].services[j] ;
+		myfile << endl ;
+		compteur ++ ;
+	}
+	myfile << "END" << endl ;
+	myfile.flush();
+}
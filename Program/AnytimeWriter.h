@@ -0,0 +1,81 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef ANYTIME_WRITER_H
+#define ANYTIME_WRITER_H
+
+#include <string>
+#include <deque>
+#include <fstream>
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include "Individu.h"
+
+using namespace std ;
+
+// Background writer for the anytime reporting of the solutions
+// Each new best solution is handed out as a compact snapshot, which is written to the file by a separate thread,
+// such that the search never waits for the disk and never needs to re-run the education to print a solution
+class AnytimeWriter
+{
+
+private:
+
+	// path of the output file
+	string nomFichier ;
+
+	// wall-clock time at the creation of the writer, used to report the elapsed time
+	chrono::steady_clock::time_point debut ;
+
+	// snapshots waiting to be written
+	deque <SolutionSnapshot> aEcrire ;
+
+	// protection of the queue, and signal when a new snapshot arrives
+	mutex verrou ;
+	condition_variable signal ;
+
+	// says if the writer must stop (once the queue is empty)
+	bool termine ;
+
+	// number of snapshots written up to now
+	int nbEcrits ;
+
+	// writing thread
+	thread ecrivain ;
+
+	// main loop of the writing thread
+	void run ();
+
+	// writes one snapshot at the end of the file
+	void write (ofstream & myfile, const SolutionSnapshot & snapshot);
+
+public:
+
+	// hands out a new solution, never blocks on the file operations
+	void push (const SolutionSnapshot & snapshot);
+
+	// Constructor, the file is truncated and the writing thread is started
+	AnytimeWriter(string nomFichier);
+
+	// Destructor, writes the remaining snapshots and stops the thread
+	~AnytimeWriter();
+};
+
+#endif
@@ -0,0 +1,126 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+using namespace std ;
+
+// Appends raw values at the end of a buffer
+struct BinaryWriter
+{
+	vector <char> & buffer ;
+
+	BinaryWriter(vector <char> & buffer):buffer(buffer){}
+
+	template <class T> void put (const T & value)
+	{
+		const char * p = (const char *)&value ;
+		buffer.insert(buffer.end(), p, p + sizeof(T));
+	}
+
+	template <class T> void putVector (const vector <T> & values)
+	{
+		put((uint64_t)values.size());
+		if (!values.empty())
+		{
+			const char * p = (const char *)&values[0] ;
+			buffer.insert(buffer.end(), p, p + values.size()*sizeof(T));
+		}
+	}
+
+	template <class T> void putMatrix (const vector < vector <T> > & values)
+	{
+		put((uint64_t)values.size());
+		for (int i=0 ; i < (int)values.size() ; i++)
+			putVector(values[i]);
+	}
+};
+
+// Extracts raw values from a buffer, with bound checks
+// (after a failure, "ok" stays false and all further reads are ignored)
+struct BinaryReader
+{
+	const char * cour ;
+	const char * fin ;
+	bool ok ;
+
+	BinaryReader(const char * data, size_t size):cour(data),fin(data+size),ok(true){}
+
+	bool has (uint64_t nbBytes)
+	{
+		if (ok && (uint64_t)(fin - cour) < nbBytes) ok = false ;
+		return ok ;
+	}
+
+	template <class T> void get (T & value)
+	{
+		if (!has(sizeof(T))) return ;
+		memcpy(&value, cour, sizeof(T));
+		cour += sizeof(T) ;
+	}
+
+	template <class T> void getVector (vector <T> & values)
+	{
+		uint64_t nb = 0 ;
+		get(nb);
+		if (!ok || nb > (uint64_t)(fin - cour)/sizeof(T) || !has(nb*sizeof(T))) { ok = false ; return ; }
+		values.resize(nb);
+		if (nb > 0) memcpy(&values[0], cour, nb*sizeof(T));
+		cour += nb*sizeof(T) ;
+	}
+
+	template <class T> void getMatrix (vector < vector <T> > & values)
+	{
+		uint64_t nb = 0 ;
+		get(nb);
+		if (!ok || nb > (uint64_t)(fin - cour)) { ok = false ; return ; }
+		values.resize(nb);
+		for (uint64_t i=0 ; i < nb && ok ; i++)
+			getVector(values[i]);
+	}
+};
+
+// Writes a buffer in a file, through a temporary file (specific to this process) and a rename
+// such that a reader never sees a partially written file, returns false in case of failure
+inline bool writeFileAtomically (string nomFichier, const vector <char> & buffer)
+{
+	ostringstream nomTemporaire ;
+	nomTemporaire << nomFichier << ".tmp" << getpid() ;
+	ofstream myfile ;
+	myfile.open(nomTemporaire.str().c_str(), ios::out | ios::binary | ios::trunc);
+	if (!myfile.is_open()) return false ;
+	if (!buffer.empty()) myfile.write(&buffer[0], buffer.size());
+	myfile.close();
+	if (myfile.fail() || rename(nomTemporaire.str().c_str(), nomFichier.c_str()) != 0)
+	{
+		remove(nomTemporaire.str().c_str());
+		return false ;
+	}
+	return true ;
+}
+
+#endif
@@ -0,0 +1,360 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include "Checkpoint.h"
+#include "Genetic.h"
+
+Checkpoint::Checkpoint(string nomFichier, double intervalle) : nomFichier(nomFichier)
+{
+	this->intervalle = chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(intervalle)) ;
+	dernierSave = chrono::steady_clock::now() ;
+	debutGenetic = 0 ;
+	phase = 0 ;
+	veh = -1 ;
+	distConstraint = 1.e30 ;
+	nbOverallLoop = 0 ;
+	hashInstance = 0 ;
+	type = -1 ;
+	nbClients = -1 ;
+	nbDepots = -1 ;
+	nbDepotsProches = -1 ;
+	isLoaded = false ;
+}
+
+void Checkpoint::saveIndividu (BinaryWriter & w, Individu * indiv)
+{
+	w.putMatrix(indiv->chromT);
+	w.putVector(indiv->chromP);
+	w.putMatrix(indiv->chromR);
+	w.put(indiv->coutSol);
+	w.put(indiv->nbRoutes);
+	w.put(indiv->maxRoute);
+	w.put(indiv->estValide);
+	w.put(indiv->isFitnessComputed);
+	w.put(indiv->age);
+	w.put(indiv->fitnessEtendu);
+	w.put(indiv->divRank);
+	w.put(indiv->fitRank);
+	w.putMatrix(indiv->suivants);
+	w.putMatrix(indiv->precedents);
+}
+
+void Checkpoint::loadIndividu (BinaryReader & r, Individu * indiv)
+{
+	r.getMatrix(indiv->chromT);
+	r.getVector(indiv->chromP);
+	indiv->updateChargeJour();
+	r.getMatrix(indiv->chromR);
+	r.get(indiv->coutSol);
+	r.get(indiv->nbRoutes);
+	r.get(indiv->maxRoute);
+	r.get(indiv->estValide);
+	r.get(indiv->isFitnessComputed);
+	r.get(indiv->age);
+	r.get(indiv->fitnessEtendu);
+	r.get(indiv->divRank);
+	r.get(indiv->fitRank);
+	r.getMatrix(indiv->suivants);
+	r.getMatrix(indiv->precedents);
+}
+
+void Checkpoint::savePopulation (BinaryWriter & w, Population * pop)
+{
+	// The block starts with its size, such that it can be skipped when reading
+	size_t debutBloc = w.buffer.size() ;
+	w.put((uint64_t)0);
+
+	// Characteristics of the problem solved by this population
+	w.put(pop->params->nbVehiculesPerDep);
+	w.put(pop->params->ordreVehicules[1][0].maxRouteTime);
+	w.put(pop->params->penalityCapa);
+	w.put(pop->params->penalityLength);
+
+	// History of feasibility, and individuals
+	vector <char> liste ;
+	w.put(pop->timeBest);
+	liste.assign(pop->listeValiditeCharge.begin(), pop->listeValiditeCharge.end());
+	w.putVector(liste);
+	liste.assign(pop->listeValiditeTemps.begin(), pop->listeValiditeTemps.end());
+	w.putVector(liste);
+	w.put(pop->valides->nbIndiv);
+	for (int i=0 ; i < pop->valides->nbIndiv ; i++)
+		saveIndividu(w, pop->valides->individus[i]);
+	w.put(pop->invalides->nbIndiv);
+	for (int i=0 ; i < pop->invalides->nbIndiv ; i++)
+		saveIndividu(w, pop->invalides->individus[i]);
+
+	uint64_t tailleBloc = (uint64_t)(w.buffer.size() - debutBloc - sizeof(uint64_t)) ;
+	memcpy(&w.buffer[debutBloc], &tailleBloc, sizeof(uint64_t));
+}
+
+void Checkpoint::loadPopulation (BinaryReader & r, Population * pop)
+{
+	int nbVeh = 0 ;
+	int nbIndiv = 0 ;
+	double maxRouteTime = 0 ;
+	vector <char> liste ;
+	SousPop * souspop ;
+	Individu * indiv ;
+
+	r.get(nbVeh);
+	r.get(maxRouteTime);
+	r.get(pop->params->penalityCapa);
+	r.get(pop->params->penalityLength);
+	if (!r.ok || nbVeh != pop->params->nbVehiculesPerDep)
+		throw string("Checkpoint : the fleet size of the population does not correspond");
+
+	r.get(pop->timeBest);
+	r.getVector(liste);
+	pop->listeValiditeCharge.assign(liste.begin(), liste.end());
+	r.getVector(liste);
+	pop->listeValiditeTemps.assign(liste.begin(), liste.end());
+
+	// The individuals of the population are containers, they get the chromosome structures of a complete individual
+	// They are placed in the same order as in the saved population, and their proximity structures are rebuilt
+	Individu * modele = new Individu(pop->params, true);
+	pop->clear();
+	for (int s=0 ; s < 2 && r.ok ; s++)
+	{
+		souspop = (s == 0) ? pop->valides : pop->invalides ;
+		r.get(nbIndiv);
+		for (int i=0 ; i < nbIndiv && r.ok ; i++)
+		{
+			indiv = new Individu(pop->params, false);
+			indiv->recopieIndividu(indiv, modele);
+			loadIndividu(r, indiv);
+			souspop->individus.push_back(indiv);
+			souspop->nbIndiv ++ ;
+			pop->updateProximity(souspop, indiv);
+		}
+	}
+	delete modele ;
+
+	if (!r.ok)
+		throw string("Checkpoint : the content of the file is corrupted");
+}
+
+void Checkpoint::save (Genetic * genetic)
+{
+	Params * params = genetic->params ;
+	vector <char> buffer ;
+	BinaryWriter w(buffer);
+
+	// Header, identifying the instance
+	char magic [8] = "HGSCKPT" ;
+	w.put(magic);
+	w.put((int)CHECKPOINT_VERSION);
+	w.put(params->hashInstance);
+	w.put(params->type);
+	w.put(params->nbClients);
+	w.put(params->nbDepots);
+	w.put(params->nbDepotsProches);
+
+	// Position in the main program
+	w.put(phase);
+	w.put(veh);
+	w.put(distConstraint);
+	w.put(nbOverallLoop);
+	w.put((int)populationsPrecedentes.size());
+	for (int i=0 ; i < (int)populationsPrecedentes.size() ; i++)
+		savePopulation(w, populationsPrecedentes[i]);
+
+	// Current population, and state of the HGA
+	savePopulation(w, genetic->population);
+	w.put(genetic->nbIter);
+	w.put(genetic->nbIterNonProd);
+	w.put(genetic->place2);
+	w.put(genetic->bestSolFeasibility);
+	w.put(genetic->tempsEcoule());
+	w.put(params->penalityCapa);
+	w.put(params->penalityLength);
+	w.put(params->borne);
+	w.put(params->nbSplits);
+	w.put(params->nbEvaluationsLS);
+
+	// Orders of evaluation of the LS (the lists of close services are shuffled in place at each LS)
+	for (int i=0 ; i < params->nbClients + params->nbDepots ; i++)
+	{
+		w.putVector(params->cli[i].sommetsVoisins);
+		w.putVector(params->cli[i].sommetsVoisinsAvant);
+	}
+	w.putVector(params->ordreRangs);
+	w.putVector(params->granulariteNoeud);
+	w.putVector(params->succesRang);
+	w.put(params->nbLSDepuisAdaptation);
+	w.put(params->ordonnanceur.evaluationsRecentes);
+	w.put(params->ordonnanceur.succesRecents);
+	w.put(params->ordonnanceur.nbEvaluations);
+	w.put(params->ordonnanceur.nbSucces);
+	w.put(params->ordonnanceur.nbIgnores);
+	w.putVector(genetic->rejeton->localSearch->ordreParcours[0]);
+	w.putVector(genetic->population->trainer->localSearch->ordreParcours[0]);
+
+	// Statistics on the moves, for the traces
+	LocalSearch * ls = genetic->rejeton->localSearch ;
+	w.put(ls->nbTotalRISinceBeginning);
+	w.put(ls->nbTotalPISinceBeginning);
+	w.put(ls->nbInterSwap);
+	w.put(ls->nbIntraSwap);
+	w.put(ls->nbInter2Opt);
+	w.put(ls->nbIntra2Opt);
+	w.put(ls->nbSwapStar);
+
+	// State of the random number generator
+	// setstate on the buffer in use records the current position of the generator inside the buffer
+	setstate(Params::etatRNG);
+	w.put(Params::etatRNG);
+
+	if (!writeFileAtomically(nomFichier, buffer))
+		cout << "WARNING : impossible to write the checkpoint file " << nomFichier << endl ;
+	dernierSave = chrono::steady_clock::now() ;
+}
+
+void Checkpoint::load (string nomCheckpoint)
+{
+	InstanceReader fichier ;
+	if (!fichier.open(nomCheckpoint))
+		throw string("Impossible to open the checkpoint file " + nomCheckpoint);
+	contenu.assign(fichier.data(), fichier.data() + fichier.size());
+	fichier.close();
+
+	char magic [8] ;
+	int version = 0 ;
+	int nbPrecedentes = 0 ;
+	uint64_t tailleBloc ;
+	BinaryReader r(contenu.empty() ? NULL : &contenu[0], contenu.size());
+	r.get(magic);
+	r.get(version);
+	if (!r.ok || strncmp(magic, "HGSCKPT", 8) != 0 || version != CHECKPOINT_VERSION)
+		throw string("The file " + nomCheckpoint + " is not a valid checkpoint file");
+	r.get(hashInstance);
+	r.get(type);
+	r.get(nbClients);
+	r.get(nbDepots);
+	r.get(nbDepotsProches);
+
+	r.get(phase);
+	r.get(veh);
+	r.get(distConstraint);
+	r.get(nbOverallLoop);
+	r.get(nbPrecedentes);
+
+	// Locating the blocks of the populations, the fleet size and distance constraint are at the beginning of each block
+	debutPopulations.clear();
+	vehPrecedentes.clear();
+	distConstraintPrecedentes.clear();
+	for (int i=0 ; i <= nbPrecedentes && r.ok ; i++)
+	{
+		r.get(tailleBloc);
+		if (!r.has(tailleBloc) || tailleBloc < sizeof(int) + sizeof(double)) break ;
+		debutPopulations.push_back((size_t)(r.cour - &contenu[0]));
+		if (i < nbPrecedentes)
+		{
+			vehPrecedentes.push_back(0);
+			distConstraintPrecedentes.push_back(0);
+			memcpy(&vehPrecedentes[i], r.cour, sizeof(int));
+			memcpy(&distConstraintPrecedentes[i], r.cour + sizeof(int), sizeof(double));
+		}
+		r.cour += tailleBloc ;
+	}
+	if (!r.ok || (int)debutPopulations.size() != nbPrecedentes + 1)
+		throw string("The checkpoint file " + nomCheckpoint + " is corrupted");
+	debutGenetic = (size_t)(r.cour - &contenu[0]) ;
+	isLoaded = true ;
+}
+
+void Checkpoint::checkInstance (Params * params)
+{
+	// (the restriction to the closest depots must be the same, as the services have no SeqData on the depots outside of it)
+	if (hashInstance != params->hashInstance || type != params->type || nbClients != params->nbClients || nbDepots != params->nbDepots
+		|| nbDepotsProches != params->nbDepotsProches)
+		throw string("The checkpoint file does not correspond to this instance and problem type");
+}
+
+void Checkpoint::restorePopulation (int i, Population * pop)
+{
+	checkInstance(pop->params);
+	BinaryReader r(&contenu[debutPopulations[i]], contenu.size() - debutPopulations[i]);
+	loadPopulation(r, pop);
+}
+
+void Checkpoint::restore (Genetic * genetic)
+{
+	Params * params = genetic->params ;
+	double ecoule = 0 ;
+	char etat [128] ;
+	static char etatTemporaire [128] ;
+
+	checkInstance(params);
+	restorePopulation((int)debutPopulations.size()-1, genetic->population);
+
+	// State of the HGA
+	BinaryReader r(&contenu[debutGenetic], contenu.size() - debutGenetic);
+	r.get(genetic->nbIter);
+	r.get(genetic->nbIterNonProd);
+	r.get(genetic->place2);
+	r.get(genetic->bestSolFeasibility);
+	r.get(ecoule);
+	r.get(params->penalityCapa);
+	r.get(params->penalityLength);
+	r.get(params->borne);
+	r.get(params->nbSplits);
+	r.get(params->nbEvaluationsLS);
+	for (int i=0 ; i < params->nbClients + params->nbDepots ; i++)
+	{
+		r.getVector(params->cli[i].sommetsVoisins);
+		r.getVector(params->cli[i].sommetsVoisinsAvant);
+	}
+	r.getVector(params->ordreRangs);
+	r.getVector(params->granulariteNoeud);
+	r.getVector(params->succesRang);
+	r.get(params->nbLSDepuisAdaptation);
+	r.get(params->ordonnanceur.evaluationsRecentes);
+	r.get(params->ordonnanceur.succesRecents);
+	r.get(params->ordonnanceur.nbEvaluations);
+	r.get(params->ordonnanceur.nbSucces);
+	r.get(params->ordonnanceur.nbIgnores);
+	r.getVector(genetic->rejeton->localSearch->ordreParcours[0]);
+	r.getVector(genetic->population->trainer->localSearch->ordreParcours[0]);
+	LocalSearch * ls = genetic->rejeton->localSearch ;
+	r.get(ls->nbTotalRISinceBeginning);
+	r.get(ls->nbTotalPISinceBeginning);
+	r.get(ls->nbInterSwap);
+	r.get(ls->nbIntraSwap);
+	r.get(ls->nbInter2Opt);
+	r.get(ls->nbIntra2Opt);
+	r.get(ls->nbSwapStar);
+	r.get(etat);
+	if (!r.ok || r.cour != r.fin)
+		throw string("The checkpoint file is corrupted");
+
+	// The elapsed time is counted from the start of the HGA, before the interruption
+	genetic->debut = chrono::steady_clock::now() - chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(ecoule)) ;
+	genetic->isResumed = true ;
+
+	// State of the random number generator
+	// setstate first stores the position of the generator in the buffer which is left, so the saved state
+	// is activated from a temporary buffer before being copied in the buffer of Params
+	memcpy(etatTemporaire, etat, sizeof(etat));
+	setstate(etatTemporaire);
+	memcpy(Params::etatRNG, etatTemporaire, sizeof(etat));
+	setstate(Params::etatRNG);
+
+	isLoaded = false ;
+	dernierSave = chrono::steady_clock::now() ;
+}
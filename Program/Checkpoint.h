@@ -0,0 +1,126 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <string>
+#include <vector>
+#include <time.h>
+#include <chrono>
+#include <stdint.h>
+#include "BinaryIO.h"
+using namespace std ;
+
+class Params ;
+class Population ;
+class Genetic ;
+class Individu ;
+
+// Version of the format of the checkpoint files
+#define CHECKPOINT_VERSION 7
+
+// Periodic snapshots of the state of the search, to stop a run and continue it later (possibly on another machine)
+// A checkpoint contains the populations (chromosomes, costs, feasibility history), the penalty coefficients,
+// the counters of the HGA, the elapsed time, the orders of evaluation, the granularity and the statistics of the neighbourhoods of the LS, the state of the random number generator,
+// as well as the position of the run in the loops on the fleet size or distance constraint (PCARP and MM-kWRPP)
+class Checkpoint
+{
+
+private:
+
+	// path of the checkpoint file
+	string nomFichier ;
+
+	// wall-clock time between two snapshots
+	chrono::steady_clock::duration intervalle ;
+
+	// wall-clock time of the last snapshot
+	chrono::steady_clock::time_point dernierSave ;
+
+	// content of the checkpoint file which has been loaded, and position of the blocks in this content
+	vector <char> contenu ;
+	vector <size_t> debutPopulations ;
+	size_t debutGenetic ;
+
+	// characteristics of the instance in the loaded checkpoint
+	uint64_t hashInstance ;
+	int type ;
+	int nbClients ;
+	int nbDepots ;
+	int nbDepotsProches ;
+
+	// throws an error if the loaded checkpoint does not correspond to the instance
+	void checkInstance (Params * params);
+
+	// writing and reading an individual
+	void saveIndividu (BinaryWriter & w, Individu * indiv);
+	void loadIndividu (BinaryReader & r, Individu * indiv);
+
+	// writing and reading a population, with the characteristics of its problem
+	void savePopulation (BinaryWriter & w, Population * pop);
+	void loadPopulation (BinaryReader & r, Population * pop);
+
+public:
+
+	/* POSITION OF THE RUN IN THE MAIN PROGRAM */
+	/* (set by the main program before each run of the HGA, and restored by load) */
+
+	// 0 : single run minimizing the distance
+	// 1 : loop with a decreasing fleet size or distance constraint
+	// 2 : last run minimizing the distance, with the final fleet size (PCARP)
+	int phase ;
+
+	// fleet size and distance constraint of the current run
+	int veh ;
+	double distConstraint ;
+
+	// number of subproblems solved up to now in the loop
+	int nbOverallLoop ;
+
+	// previous populations which are still needed by the main program after the current run (saved with the checkpoint)
+	vector <Population *> populationsPrecedentes ;
+
+	// fleet size and distance constraint of the previous populations in the loaded checkpoint
+	vector <int> vehPrecedentes ;
+	vector <double> distConstraintPrecedentes ;
+
+	// says if a checkpoint has been loaded and still needs to be restored in the search
+	bool isLoaded ;
+
+	// says if a new snapshot is due
+	bool isDue () { return chrono::steady_clock::now() - dernierSave >= intervalle ; }
+
+	// writes a snapshot of the search performed by the genetic algorithm
+	void save (Genetic * genetic);
+
+	// reads a checkpoint file, throws an error if it cannot be read
+	void load (string nomCheckpoint);
+
+	// restores one of the previous populations of the loaded checkpoint (empty population with its Params already built)
+	void restorePopulation (int i, Population * pop);
+
+	// restores the current population and the state of the search in a newly created Genetic
+	// (this is done last, as the creation of all data structures consumes random numbers)
+	void restore (Genetic * genetic);
+
+	// Constructor, with the time between two snapshots in seconds
+	Checkpoint(string nomFichier, double intervalle);
+};
+
+#endif
@@ -148,6 +148,9 @@ class Client
 	// For a customer, ordered list of depots by increasing distance 
 	vector <int> ordreProximiteDepots ;
 
+	// (MDCARP) says for each depot if the customer can be serviced from it (empty if all depots are possible)
+	vector <bool> isDepotProche ;
+
 	// For a customer i, list of close customers j by proximity
 	vector <int> sommetsVoisins ;
 
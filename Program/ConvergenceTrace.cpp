@@ -0,0 +1,177 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include "ConvergenceTrace.h"
+
+ConvergenceTrace::ConvergenceTrace(string nomFichier, int intervalle) : intervalle(intervalle)
+{
+	debut = chrono::steady_clock::now() ;
+	run = 0 ;
+	nbRecords = 0 ;
+	debutRun = 0 ;
+	runFinal = 0 ;
+	isFinalValide = false ;
+	bestFinal = 0 ;
+	tempsBestFinal = 0 ;
+	integraleFinale = 0 ;
+	isJSONL = (nomFichier.length() >= 6 && nomFichier.substr(nomFichier.length()-6) == ".jsonl") ;
+
+	// The buffer must be given to the stream before the file is opened
+	tampon.resize(1 << 16);
+	fichier.rdbuf()->pubsetbuf(&tampon[0],tampon.size());
+	fichier.open(nomFichier.c_str(), std::ofstream::trunc);
+	if (!fichier.is_open())
+		throw string ("Impossible to open the convergence trace file : " + nomFichier);
+	fichier.precision(10);
+
+	if (!isJSONL)
+		fichier << "wall_time,cpu_time,run,iteration,event,best_feasible,best_infeasible,penalty_capa,penalty_length,feasible_load,feasible_length,diversity_feasible,diversity_infeasible" << "\n" ;
+}
+
+ConvergenceTrace::~ConvergenceTrace()
+{
+	close();
+}
+
+double ConvergenceTrace::tempsEcoule ()
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - debut).count() ;
+}
+
+void ConvergenceTrace::nouveauRun ()
+{
+	if (run > 0) termineRun();
+	run ++ ;
+	debutRun = tempsEcoule() ;
+}
+
+void ConvergenceTrace::termineRun ()
+{
+	double tempsFin = tempsEcoule() ;
+	double integrale = tempsFin - debutRun ;
+	double reference = 0 ;
+	double gap ;
+
+	// Primal integral of the run, with a gap of 1 until its first feasible solution, and its final solution as a reference
+	if (!historique.empty())
+	{
+		reference = historique.back().second ;
+		integrale = historique[0].first - debutRun ;
+		for (int i=0 ; i+1 < (int)historique.size() ; i++)
+		{
+			gap = fabs(historique[i].second - reference) / max(fabs(historique[i].second),fabs(reference)) ;
+			integrale += gap * (historique[i+1].first - historique[i].first) ;
+		}
+	}
+
+	if (isJSONL)
+	{
+		fichier << "{\"event\":\"run_summary\",\"wall_time\":" << tempsFin << ",\"run\":" << run ;
+		ecrireValeur("best_feasible", !historique.empty(), reference) ;
+		ecrireValeur("time_best", !historique.empty(), historique.empty() ? 0 : historique.back().first) ;
+		fichier << ",\"primal_integral\":" << integrale << "}" << "\n" ;
+	}
+	else
+	{
+		fichier << "# run " << run << " : wall_time " << tempsFin ;
+		if (!historique.empty()) fichier << " | best_feasible " << reference << " | time_best " << historique.back().first ;
+		else fichier << " | best_feasible NONE" ;
+		fichier << " | primal_integral " << integrale << "\n" ;
+	}
+
+	// The final solution comes from the last run which found a feasible solution (or from the last run if there is none)
+	if (!historique.empty() || !isFinalValide)
+	{
+		runFinal = run ;
+		isFinalValide = !historique.empty() ;
+		bestFinal = reference ;
+		tempsBestFinal = historique.empty() ? 0 : historique.back().first ;
+		integraleFinale = integrale ;
+	}
+	historique.clear();
+}
+
+void ConvergenceTrace::ecrireValeur (const char * nom, bool existe, double valeur)
+{
+	if (isJSONL)
+	{
+		fichier << ",\"" << nom << "\":" ;
+		if (existe) fichier << valeur ;
+		else fichier << "null" ;
+	}
+	else
+	{
+		fichier << "," ;
+		if (existe) fichier << valeur ;
+	}
+}
+
+void ConvergenceTrace::record (Population * population, int nbIter, const char * evenement)
+{
+	double temps = tempsEcoule() ;
+	double tempsCPU = (double)clock()/(double)CLOCKS_PER_SEC ;
+	Individu * bestValide = population->getIndividuBestValide() ;
+	Individu * bestInvalide = population->getIndividuBestInvalide() ;
+	Params * params = population->params ;
+
+	// Keeping track of the successive best feasible solutions for the primal integral
+	if (bestValide != NULL && (historique.empty() || bestValide->coutSol.evaluation != historique.back().second))
+		historique.push_back(pair <double,double> (temps,bestValide->coutSol.evaluation));
+
+	if (isJSONL)
+		fichier << "{\"wall_time\":" << temps << ",\"cpu_time\":" << tempsCPU << ",\"run\":" << run << ",\"iteration\":" << nbIter << ",\"event\":\"" << evenement << "\"" ;
+	else
+		fichier << temps << "," << tempsCPU << "," << run << "," << nbIter << "," << evenement ;
+
+	// The diversity is only defined for a subpopulation with at least two individuals
+	ecrireValeur("best_feasible", bestValide != NULL, (bestValide != NULL) ? bestValide->coutSol.evaluation : 0) ;
+	ecrireValeur("best_infeasible", bestInvalide != NULL, (bestInvalide != NULL) ? bestInvalide->coutSol.evaluation : 0) ;
+	ecrireValeur("penalty_capa", true, params->penalityCapa) ;
+	ecrireValeur("penalty_length", true, params->penalityLength) ;
+	ecrireValeur("feasible_load", true, population->fractionValidesCharge()) ;
+	ecrireValeur("feasible_length", true, population->fractionValidesTemps()) ;
+	ecrireValeur("diversity_feasible", population->valides->nbIndiv >= 2, (population->valides->nbIndiv >= 2) ? population->getDiversity(population->valides) : 0) ;
+	ecrireValeur("diversity_infeasible", population->invalides->nbIndiv >= 2, (population->invalides->nbIndiv >= 2) ? population->getDiversity(population->invalides) : 0) ;
+
+	if (isJSONL) fichier << "}" ;
+	fichier << "\n" ;
+	nbRecords ++ ;
+}
+
+void ConvergenceTrace::close ()
+{
+	if (run > 0) termineRun();
+	double tempsFin = tempsEcoule() ;
+
+	if (isJSONL)
+	{
+		fichier << "{\"event\":\"summary\",\"wall_time\":" << tempsFin << ",\"cpu_time\":" << (double)clock()/(double)CLOCKS_PER_SEC << ",\"runs\":" << run << ",\"records\":" << nbRecords << ",\"final_run\":" << runFinal ;
+		ecrireValeur("best_feasible", isFinalValide, bestFinal) ;
+		ecrireValeur("time_best", isFinalValide, tempsBestFinal) ;
+		fichier << ",\"primal_integral\":" << integraleFinale << "}" << "\n" ;
+	}
+	else
+	{
+		// The summaries are comment lines, such that the file stays a valid CSV table
+		fichier << "# summary : wall_time " << tempsFin << " | cpu_time " << (double)clock()/(double)CLOCKS_PER_SEC << " | runs " << run << " | records " << nbRecords << " | final_run " << runFinal ;
+		if (isFinalValide) fichier << " | best_feasible " << bestFinal << " | time_best " << tempsBestFinal ;
+		else fichier << " | best_feasible NONE" ;
+		fichier << " | primal_integral " << integraleFinale << "\n" ;
+	}
+	fichier.close();
+}
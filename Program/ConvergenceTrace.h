@@ -0,0 +1,101 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef CONVERGENCE_TRACE_H
+#define CONVERGENCE_TRACE_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <chrono>
+#include <math.h>
+#include "Population.h"
+
+using namespace std ;
+
+// Machine-readable trace of the convergence of the search, for the tuning of the method and the regression tracking
+// One record is written at the start and the end of each run of the HGA, at each improvement, and every "intervalle" iterations
+// Format : CSV, or JSON lines if the name of the file ends with ".jsonl"
+// The records are written through a large buffer, such that the search does not wait for the disk
+// The end of each run of the HGA is summarized with its primal integral : the integral over the wall-clock time of the run of the gap
+// of its best feasible solution with respect to its final solution, this gap being 1 as long as no feasible solution is known
+// (each run of the PCARP and MM-kWRPP solves a different problem, such that the runs can not be compared with each other)
+// The last line summarizes the resolution, with the primal integral of the run giving the final solution (the last run which found a feasible solution)
+class ConvergenceTrace
+{
+
+private:
+
+	// output file, and its buffer
+	ofstream fichier ;
+	vector <char> tampon ;
+
+	// says if the records are written as JSON lines (CSV otherwise)
+	bool isJSONL ;
+
+	// wall-clock time at the creation of the trace (start of the resolution)
+	chrono::steady_clock::time_point debut ;
+
+	// index of the current run of the HGA (several runs for the PCARP and MM-kWRPP), and number of records written
+	int run ;
+	int nbRecords ;
+
+	// wall-clock time at the start of the current run
+	double debutRun ;
+
+	// successive values of the best feasible solution of the current run, with the wall-clock time when they have been found (for the primal integral)
+	vector < pair <double,double> > historique ;
+
+	// summary of the run giving the final solution : index, best feasible solution (if any), time when it has been found, and primal integral
+	int runFinal ;
+	bool isFinalValide ;
+	double bestFinal ;
+	double tempsBestFinal ;
+	double integraleFinale ;
+
+	// wall-clock time elapsed since the creation of the trace, in seconds
+	double tempsEcoule () ;
+
+	// writes one optional value of a record (empty field or null if it does not exist)
+	void ecrireValeur (const char * nom, bool existe, double valeur) ;
+
+	// writes the summary of the current run, and resets its history
+	void termineRun () ;
+
+	// writes the summary line, and closes the file
+	void close () ;
+
+public:
+
+	// number of iterations between two periodic records (0 for no periodic record)
+	int intervalle ;
+
+	// signals the start of a new run of the HGA
+	void nouveauRun () ;
+
+	// writes one record describing the status of the population, "evenement" being "start", "improvement", "interval" or "end"
+	void record (Population * population, int nbIter, const char * evenement) ;
+
+	// Constructor, the file is truncated and the header is written
+	ConvergenceTrace(string nomFichier, int intervalle);
+
+	// Destructor, the summary line is written and the buffer is flushed
+	~ConvergenceTrace();
+};
+
+#endif
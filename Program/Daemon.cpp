@@ -0,0 +1,314 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include "Daemon.h"
+#include "InstanceCache.h"
+#include <iostream>
+#include <sstream>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+// Reads a line (without the end of line) on a socket, returns false at the end of the stream or in case of error
+static bool lireLigne (int fd, string & ligne)
+{
+	char c ;
+	ligne = "" ;
+	while (true)
+	{
+		ssize_t n = read(fd, &c, 1);
+		if (n < 0 && errno == EINTR) continue ;
+		if (n <= 0) return false ;
+		if (c == '\n') return true ;
+		ligne += c ;
+		if (ligne.size() > 100000) return false ;
+	}
+}
+
+// Reads exactly "size" bytes on a socket
+static bool lireDonnees (int fd, char * data, size_t size)
+{
+	while (size > 0)
+	{
+		ssize_t n = read(fd, data, size);
+		if (n < 0 && errno == EINTR) continue ;
+		if (n <= 0) return false ;
+		data += n ;
+		size -= n ;
+	}
+	return true ;
+}
+
+// Writes a message to a client (used only for the errors detected by the daemon, the jobs write directly on the socket)
+static void ecrireMessage (int fd, string message)
+{
+	message += "\n" ;
+	const char * data = message.data() ;
+	size_t size = message.size() ;
+	while (size > 0)
+	{
+		ssize_t n = write(fd, data, size);
+		if (n < 0 && errno == EINTR) continue ;
+		if (n <= 0) return ;
+		data += n ;
+		size -= n ;
+	}
+}
+
+Daemon::Daemon(string pathToSocket, int nbWorkers, int capaciteCache, int (*job) (int argc, char * argv[])) : pathToSocket(pathToSocket), nbWorkers(nbWorkers), job(job)
+{
+	nbRequetes = 0 ;
+	serveur = -1 ;
+	if (nbWorkers < 1) throw string("The daemon needs at least one worker");
+	if (pathToSocket.size() >= sizeof(((struct sockaddr_un *)0)->sun_path)) throw string("The path of the socket is too long");
+	InstanceCache::capaciteMemoire = capaciteCache ;
+}
+
+bool Daemon::lireRequete (int client, string & repertoire, vector <string> & arguments, string & nomFichierTemp)
+{
+	string ligne ;
+	int nbArguments ;
+	long long taille ;
+	nomFichierTemp = "" ;
+	arguments.clear();
+
+	if (!lireLigne(client, ligne) || ligne != DAEMON_MAGIC) return false ;
+	if (!lireLigne(client, repertoire) || repertoire == "") return false ;
+	if (!lireLigne(client, ligne)) return false ;
+	nbArguments = atoi(ligne.c_str());
+	if (nbArguments < 1 || nbArguments > 100) return false ;
+	for (int i=0 ; i < nbArguments ; i++)
+	{
+		if (!lireLigne(client, ligne)) return false ;
+		arguments.push_back(ligne);
+	}
+
+	// Content of the instance file, written in a temporary file which replaces the instance path in the arguments
+	if (!lireLigne(client, ligne)) return false ;
+	taille = atoll(ligne.c_str());
+	if (taille < 0) return false ;
+	if (taille > 0)
+	{
+		vector <char> contenu (taille) ;
+		if (!lireDonnees(client, contenu.data(), taille)) return false ;
+		char nomTemp [] = "/tmp/gencarp-instance-XXXXXX" ;
+		int fd = mkstemp(nomTemp);
+		if (fd < 0) return false ;
+		nomFichierTemp = nomTemp ;
+		bool isWritten = (write(fd, contenu.data(), taille) == taille) ;
+		close(fd);
+		if (!isWritten)
+		{
+			unlink(nomFichierTemp.c_str());
+			nomFichierTemp = "" ;
+			return false ;
+		}
+		arguments[0] = nomFichierTemp ;
+	}
+	return true ;
+}
+
+void Daemon::lancerJob (int client, const string & repertoire, const vector <string> & arguments, const string & nomFichierTemp)
+{
+	int tubes [2] ;
+	pid_t pid = -1 ;
+	cout.flush();
+	if (pipe(tubes) == 0)
+	{
+		pid = fork();
+		if (pid < 0)
+		{
+			close(tubes[0]);
+			close(tubes[1]);
+		}
+	}
+	if (pid < 0)
+	{
+		ecrireMessage(client, "ERROR : the daemon could not start the job");
+		if (nomFichierTemp != "") unlink(nomFichierTemp.c_str());
+		return ;
+	}
+
+	if (pid == 0)
+	{
+		// Child process : the output of the search goes to the client, and the relative paths are those of the client
+		// The instances preprocessed by the job are sent back to the daemon through the pipe
+		signal(SIGPIPE, SIG_DFL);
+		close(serveur);
+		close(tubes[0]);
+		for (map < int, JobDaemon >::iterator it = jobsEnCours.begin() ; it != jobsEnCours.end() ; ++it)
+			if (it->second.tube >= 0) close(it->second.tube);
+		InstanceCache::sortieMemoire = tubes[1] ;
+		dup2(client, 1);
+		dup2(client, 2);
+		close(client);
+		if (chdir(repertoire.c_str()) != 0)
+		{
+			cout << "ERROR : the daemon could not access the directory " << repertoire << endl ;
+			_exit(1);
+		}
+		vector <char *> argv ;
+		argv.push_back((char *)"gencarp");
+		for (int i=0 ; i < (int)arguments.size() ; i++)
+			argv.push_back((char *)arguments[i].c_str());
+		argv.push_back(NULL);
+		int code = job((int)arguments.size() + 1, argv.data());
+		cout.flush();
+		_exit(code);
+	}
+
+	close(tubes[1]);
+	fcntl(tubes[0], F_SETFL, fcntl(tubes[0], F_GETFL) | O_NONBLOCK);
+	jobsEnCours[pid].nomFichierTemp = nomFichierTemp ;
+	jobsEnCours[pid].tube = tubes[0] ;
+	cout << "Request " << nbRequetes << " | instance : " << arguments[0] << " | job " << pid << " | running jobs : " << jobsEnCours.size() << endl ;
+}
+
+void Daemon::lireRapports (JobDaemon & jobDaemon)
+{
+	char tampon [1 << 16] ;
+	while (jobDaemon.tube >= 0)
+	{
+		ssize_t n = read(jobDaemon.tube, tampon, sizeof(tampon));
+		if (n < 0 && errno == EINTR) continue ;
+		if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break ;
+		if (n <= 0)
+		{
+			// end of the job (or error on the pipe), an incomplete report is discarded
+			close(jobDaemon.tube);
+			jobDaemon.tube = -1 ;
+			jobDaemon.rapports.clear();
+			break ;
+		}
+		jobDaemon.rapports.insert(jobDaemon.rapports.end(), tampon, tampon + n);
+		size_t utilises = InstanceCache::applyReports(jobDaemon.rapports.data(), jobDaemon.rapports.size());
+		jobDaemon.rapports.erase(jobDaemon.rapports.begin(), jobDaemon.rapports.begin() + utilises);
+	}
+}
+
+void Daemon::attendreJobs ()
+{
+	int status ;
+	pid_t pid ;
+	while (!jobsEnCours.empty() && (pid = waitpid(-1, &status, WNOHANG)) != 0)
+	{
+		if (pid < 0)
+		{
+			if (errno == EINTR) continue ;
+			return ;
+		}
+		map < int, JobDaemon >::iterator it = jobsEnCours.find(pid);
+		if (it != jobsEnCours.end())
+		{
+			// the reports still in the pipe are read before forgetting the job
+			if (it->second.tube >= 0)
+			{
+				fcntl(it->second.tube, F_SETFL, fcntl(it->second.tube, F_GETFL) & ~O_NONBLOCK);
+				lireRapports(it->second);
+			}
+			if (it->second.nomFichierTemp != "") unlink(it->second.nomFichierTemp.c_str());
+			jobsEnCours.erase(it);
+		}
+	}
+}
+
+void Daemon::run ()
+{
+	struct sockaddr_un adresse ;
+	string repertoire ;
+	string nomFichierTemp ;
+	vector <string> arguments ;
+
+	// The jobs detect the clients which disconnected through the errors on the socket
+	signal(SIGPIPE, SIG_IGN);
+
+	serveur = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (serveur < 0) throw string("The daemon could not create its socket");
+	memset(&adresse, 0, sizeof(adresse));
+	adresse.sun_family = AF_UNIX ;
+	strncpy(adresse.sun_path, pathToSocket.c_str(), sizeof(adresse.sun_path) - 1);
+	unlink(pathToSocket.c_str()); // socket left by a previous daemon
+	if (bind(serveur, (struct sockaddr *)&adresse, sizeof(adresse)) != 0 || listen(serveur, 64) != 0)
+	{
+		close(serveur);
+		throw string("The daemon could not listen on the socket " + pathToSocket);
+	}
+	cout << "Daemon listening on " << pathToSocket << " | workers : " << nbWorkers << " | instances in memory : " << InstanceCache::capaciteMemoire << endl ;
+
+	while (true)
+	{
+		// Waiting for a request when a worker is free, and for the reports of the running jobs (collecting regularly the finished jobs)
+		// The end of a job closes its pipe, the job is then collected shortly after
+		attendreJobs();
+		vector <struct pollfd> attente ;
+		vector <int> pids ;
+		int attenteMax = 1000 ;
+		for (map < int, JobDaemon >::iterator it = jobsEnCours.begin() ; it != jobsEnCours.end() ; ++it)
+		{
+			if (it->second.tube < 0)
+			{
+				attenteMax = 10 ;
+				continue ;
+			}
+			struct pollfd tube ;
+			tube.fd = it->second.tube ;
+			tube.events = POLLIN ;
+			tube.revents = 0 ;
+			attente.push_back(tube);
+			pids.push_back(it->first);
+		}
+		bool isWorkerLibre = ((int)jobsEnCours.size() < nbWorkers) ;
+		if (isWorkerLibre)
+		{
+			struct pollfd ecoute ;
+			ecoute.fd = serveur ;
+			ecoute.events = POLLIN ;
+			ecoute.revents = 0 ;
+			attente.push_back(ecoute);
+		}
+		if (poll(attente.data(), attente.size(), attenteMax) <= 0) continue ;
+		for (int i=0 ; i < (int)pids.size() ; i++)
+			if (attente[i].revents != 0)
+				lireRapports(jobsEnCours[pids[i]]);
+		if (!isWorkerLibre || attente.back().revents == 0) continue ;
+		int client = accept(serveur, NULL, NULL);
+		if (client < 0) continue ;
+
+		// A slow or stuck client should not block the daemon
+		struct timeval delai ;
+		delai.tv_sec = 10 ;
+		delai.tv_usec = 0 ;
+		setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &delai, sizeof(delai));
+
+		nbRequetes ++ ;
+		if (lireRequete(client, repertoire, arguments, nomFichierTemp))
+			lancerJob(client, repertoire, arguments, nomFichierTemp);
+		else
+			ecrireMessage(client, "ERROR : the daemon could not read the request");
+		close(client);
+	}
+}
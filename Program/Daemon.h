@@ -0,0 +1,99 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include <string>
+#include <vector>
+#include <map>
+using namespace std ;
+
+// First line of a request, to detect foreign clients or different versions of the protocol
+#define DAEMON_MAGIC "HGSCARP-DAEMON 1"
+
+// Persistent solver process, listening on a local (Unix domain) socket
+// Each request contains the working directory of the client and the arguments of a gencarp commandline, and possibly the content of the instance file
+// The requests are solved in child processes (at most nbWorkers at the same time), whose output is sent back to the client.
+// The separate processes are needed as the random number generator and the traces of the search are global to a process.
+// The daemon keeps the preprocessed instances in memory (see InstanceCache), such that the jobs skip the parsing and pre-processing of the known instances.
+// The unknown instances are preprocessed by the jobs themselves, which send the data back to the daemon through a pipe,
+// such that the daemon keeps accepting the requests while a large instance is preprocessed.
+// Format of a request (text lines) :
+// DAEMON_MAGIC
+// working directory of the client
+// number of arguments, followed by one argument per line (without the name of the program)
+// size of the instance content in bytes (0 if the instance file should be read by the job), followed by the content
+// Job running in a child process
+struct JobDaemon
+{
+	// temporary instance file (empty if the instance was not given inline)
+	string nomFichierTemp ;
+
+	// pipe on which the job reports its uses and additions of the in-memory cache (-1 once the job has closed it)
+	int tube ;
+
+	// bytes received on the pipe and not yet applied to the in-memory cache
+	vector <char> rapports ;
+};
+
+class Daemon
+{
+
+private:
+
+	// path of the socket
+	string pathToSocket ;
+
+	// listening socket
+	int serveur ;
+
+	// maximum number of jobs running at the same time
+	int nbWorkers ;
+
+	// function solving a request, with the same arguments as the main function of gencarp
+	int (*job) (int argc, char * argv[]) ;
+
+	// running jobs, by process number
+	map < int, JobDaemon > jobsEnCours ;
+
+	// number of requests received
+	int nbRequetes ;
+
+	// reads a request, returns false if the request is not correct
+	bool lireRequete (int client, string & repertoire, vector <string> & arguments, string & nomFichierTemp);
+
+	// starts a job in a child process, its output is sent to the client
+	void lancerJob (int client, const string & repertoire, const vector <string> & arguments, const string & nomFichierTemp);
+
+	// reads the data available on the pipe of a job, and applies its complete reports to the in-memory cache
+	void lireRapports (JobDaemon & jobDaemon);
+
+	// collects the finished jobs, without waiting
+	void attendreJobs ();
+
+public:
+
+	// constructor
+	Daemon (string pathToSocket, int nbWorkers, int capaciteCache, int (*job) (int argc, char * argv[]));
+
+	// listens and serves the requests, only returns in case of error
+	void run ();
+};
+
+#endif
@@ -17,6 +17,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //  ---------------------------------------------------------------------- */
 
 #include "Genetic.h"
+#include "Checkpoint.h"
+#include "IslandExchange.h"
+#include "LowerBound.h"
+#include "Profiler.h"
+#include "AllocAudit.h"
+#include <string.h>
 
 void Genetic::evolve (int maxIterNonProd, int nbRec)
 {
@@ -32,45 +38,67 @@ void Genetic::evolveHGA (int maxIterNonProd, int nbRec)
 	// Main code of the HGA 
 	Individu * parent1 ;
 	Individu * parent2 ;
-	int place, place2 ;
-	place2 = 10000 ;
-	nbIterNonProd = 1 ;
-	nbIter = 0 ;
+	int place ;
 	string temp ;
 	double fitBeforeRepair ;
-	CoutSol bestSolFeasibility ;
-	clock_t debut = clock() ; // When iterating several time the HGA (e.g. PCARP, the time limit applies to one iteration -- fleet size or max distance value)
 
-	if (population->getIndividuBestValide() != NULL) bestSolFeasibility = population->getIndividuBestValide()->coutSol ;
-	else bestSolFeasibility = population->getIndividuBestInvalide()->coutSol ;
-	for (int i=0 ; i<population->invalides->nbIndiv ; i++)
-		if (population->invalides->individus[i]->coutSol.isBetterFeas(bestSolFeasibility)) bestSolFeasibility = population->invalides->individus[i]->coutSol ;
+	// When resuming from a checkpoint, the counters, the best solution in terms of feasibility and the elapsed time have been restored
+	if (!isResumed)
+	{
+		rejeton->localSearch->nbTotalRISinceBeginning = 0 ;
+		rejeton->localSearch->nbTotalPISinceBeginning = 0 ;
+		place2 = 10000 ;
+		nbIterNonProd = 1 ;
+		nbIter = 0 ;
+		coutPublie = 1.e30 ;
+		debut = chrono::steady_clock::now() ; // When iterating several time the HGA (e.g. PCARP, the time limit applies to one iteration -- fleet size or max distance value)
+
+		if (population->getIndividuBestValide() != NULL) bestSolFeasibility = population->getIndividuBestValide()->coutSol ;
+		else bestSolFeasibility = population->getIndividuBestInvalide()->coutSol ;
+		for (int i=0 ; i<population->invalides->nbIndiv ; i++)
+			if (population->invalides->individus[i]->coutSol.isBetterFeas(bestSolFeasibility)) bestSolFeasibility = population->invalides->individus[i]->coutSol ;
+	}
+	isResumed = false ;
 
-	rejeton->localSearch->nbTotalRISinceBeginning = 0 ;
-	rejeton->localSearch->nbTotalPISinceBeginning = 0 ;
+	if (traces) cout << "| Start of GA | NbNodes : " << params->nbClients << " | NbVehicles : " << params->nbVehiculesPerDep << " | " << endl ;
 
-	cout << "| Start of GA | NbNodes : " << params->nbClients << " | NbVehicles : " << params->nbVehiculesPerDep << " | " << endl ;
+	// The best solution of the initial population is already a valid answer
+	if (anytimeWriter != NULL && population->getIndividuBestValide() != NULL)
+	{
+		population->getIndividuBestValide()->exportSnapshot(snapshot);
+		anytimeWriter->push(snapshot);
+	}
 
-	while (nbIterNonProd < maxIterNonProd && (clock() - debut <= ticks) && (!params->isSearchingFeasible || population->getIndividuBestValide() == NULL))
+	if (trace != NULL)
 	{
-		// CROSSOVER
-		parent1 = population->getIndividuBinT(); // Pick two individuals per binary tournament
-		parent2 = population->getIndividuBinT(); // Pick two individuals per binary tournament
-		rejeton->recopieIndividu(rejeton,parent1); // Put them in adequate data structures
-		rejeton2->recopieIndividu(rejeton2,parent2); // Put them in adequate data structures
-
-		if (!params->periodique && !params->multiDepot) 
-			crossOX(); // Pick OX crossover if its a single-period problem
-		else 
-			crossPIX() ; // Otherwise PIX (see Vidal et al 2012 -- OR)
-
-		// SPLIT
-		rejeton->generalSplit();
+		trace->nouveauRun();
+		trace->record(population,nbIter,"start");
+	}
 
-		// LOCAL SEARCH
-		rejeton->updateLS();
-		rejeton->localSearch->runSearchTotal();
-		rejeton->updateIndiv();
+	while (nbIterNonProd < maxIterNonProd && !isTimeOver() && !isBudgetOver() && !isOptimal() && (!params->isSearchingFeasible || population->getIndividuBestValide() == NULL))
+	{
+		{
+			ALLOC_AUDIT_SCOPE ;
+
+			// CROSSOVER
+			parent1 = population->getIndividuBinT(); // Pick two individuals per binary tournament
+			parent2 = population->getIndividuBinT(); // Pick two individuals per binary tournament
+			rejeton->recopieIndividu(rejeton,parent1); // Put them in adequate data structures
+			rejeton2->recopieIndividu(rejeton2,parent2); // Put them in adequate data structures
+
+			if (!params->periodique && !params->multiDepot) 
+				crossOX(); // Pick OX crossover if its a single-period problem
+			else 
+				crossPIX() ; // Otherwise PIX (see Vidal et al 2012 -- OR)
+
+			// SPLIT
+			rejeton->generalSplit();
+
+			// LOCAL SEARCH
+			rejeton->updateLS();
+			rejeton->localSearch->runSearchTotal();
+			rejeton->updateIndiv();
+		}
 		population->updateNbValides(rejeton);
 		place = population->addIndividu(rejeton) ;
 
@@ -80,7 +108,10 @@ void Genetic::evolveHGA (int maxIterNonProd, int nbRec)
 			fitBeforeRepair = rejeton->coutSol.evaluation ;
 			if (rand() % 2 == 0) // 50% chance to do repair on an infeasible individual
 			{
-				reparer();
+				{
+					ALLOC_AUDIT_SCOPE ;
+					reparer();
+				}
 				if (rejeton->coutSol.evaluation < fitBeforeRepair - 0.01 || rejeton->coutSol.evaluation > fitBeforeRepair + 0.01 || rejeton->estValide) 
 					place2 = population->addIndividu(rejeton) ;
 				if (rejeton->estValide)
@@ -95,10 +126,17 @@ void Genetic::evolveHGA (int maxIterNonProd, int nbRec)
 		{	
 			if (traces && population->valides->nbIndiv > 0) 
 				cout << "NEW BEST FEASIBLE " << place << " " << population->getIndividuBestValide()->coutSol.evaluation << " distance : " << rejeton->coutSol.distance << " nbRoutes : " << rejeton->coutSol.routes << " capaViol : " << rejeton->coutSol.capacityViol << " lengthViol : " << rejeton->coutSol.lengthViol << endl << endl ;
+			if (anytimeWriter != NULL && rejeton->estValide && place == 0)
+			{
+				population->getIndividuBestValide()->exportSnapshot(snapshot);
+				anytimeWriter->push(snapshot);
+			}
 			if (traces && population->valides->nbIndiv == 0 ) 
 				cout << "NEW BEST INFEASIBLE "<< place << " " << rejeton->coutSol.evaluation                            << " distance : " << rejeton->coutSol.distance << " nbRoutes : " << rejeton->coutSol.routes << " capaViol : " << rejeton->coutSol.capacityViol << " lengthViol : " << rejeton->coutSol.lengthViol << endl << endl ;
 			if (rejeton->coutSol.isBetterFeas(bestSolFeasibility)) 
 				bestSolFeasibility = rejeton->coutSol ;
+			if (trace != NULL)
+				trace->record(population,nbIter,"improvement");
 			nbIterNonProd = 1 ; 
 		}
 		else nbIterNonProd ++ ;
@@ -111,10 +149,21 @@ void Genetic::evolveHGA (int maxIterNonProd, int nbRec)
 			population->diversify();
 		}
 
+		// DECOMPOSITION PHASE
+		if (nbRec > 0 && decompositionSize > 0 && decompositionInterval > 0 && nbIter > 0 && nbIter % decompositionInterval == 0)
+			decomposition(nbRec);
+
+		// MIGRATION WITH THE OTHER ISLANDS
+		if (islands != NULL && nbRec > 0 && migrationInterval > 0 && nbIter % migrationInterval == 0)
+			migration();
+
 		// PENALTY MANAGEMENT
 		if (nbIter % 30 == 0) 
 			gererPenalites () ;
 
+		// AUDIT OF THE ALLOCATIONS OF THE GENERATION (only with the flag ALLOC_AUDIT)
+		ALLOC_AUDIT_GENERATION(nbIter);
+
 		// MORE TRACES
 		if (traces && nbIter % 500 == 0)
 		{
@@ -124,18 +173,30 @@ void Genetic::evolveHGA (int maxIterNonProd, int nbRec)
 			cout << " | intraSwap " << rejeton->localSearch->nbIntraSwap ;
 			cout << " | inter2opt " << rejeton->localSearch->nbInter2Opt ;
 			cout << " | intra2opt " << rejeton->localSearch->nbIntra2Opt ;
+			cout << " | swapStar " << rejeton->localSearch->nbSwapStar ;
 			cout << " | " << endl ;
 			cout << " | CPU Time : " <<  (double)clock()/(double)CLOCKS_PER_SEC << " seconds " << endl ;
 			cout << endl ;
 		}
 		nbIter ++ ;
+
+		if (trace != NULL && trace->intervalle > 0 && nbIter % trace->intervalle == 0)
+			trace->record(population,nbIter,"interval");
+
+		// PERIODIC SAVING OF THE STATE OF THE SEARCH
+		if (checkpoint != NULL && checkpoint->isDue())
+			checkpoint->save(this);
 	}
 
 	// END OF THE ALGORITHM
+	if (trace != NULL)
+		trace->record(population,nbIter,"end");
+
 	if (traces)
 	{
 		cout << "Time Elapsed : " << clock() << endl ;
 		cout << "Number of Iterations : " << nbIter << endl ;
+		if (isOptimal()) cout << "The best solution reaches the lower bound " << borneInferieure << " : it is optimal" << endl ;
 	}
 }
 
@@ -150,7 +211,7 @@ void Genetic::evolveILS ()
 	rejeton->localSearch->nbTotalRISinceBeginning = 0 ;
 	rejeton->localSearch->nbTotalPISinceBeginning = 0 ;
 	nbIter = 0 ;
-	clock_t debut = clock();
+	debut = chrono::steady_clock::now();
 	rejetonBestFoundAll->coutSol.evaluation = 1.e30 ;
 
 	cout << "| Debut evolution ILS | NbNodes : " << params->nbClients << " | NbVehicles : " << params->nbVehiculesPerDep << " | " << endl ;
@@ -167,7 +228,7 @@ void Genetic::evolveILS ()
 		rejetonBestFound->coutSol.evaluation = 1.e30 ;
 		isFirstLoop = true ;
 		
-		for (int nbGenerationNonProd = 0 ; nbGenerationNonProd < nbILS && (clock() - debut <= ticks) ; nbGenerationNonProd ++)
+		for (int nbGenerationNonProd = 0 ; nbGenerationNonProd < nbILS && !isTimeOver() ; nbGenerationNonProd ++)
 		{
 			if (!isFirstLoop)
 			{
@@ -206,6 +267,11 @@ void Genetic::evolveILS ()
 					{
 						cout << "NEW BEST EVER : " << rejetonBestFound->coutSol.evaluation << endl ;
 						rejetonBestFoundAll->recopieIndividu(rejetonBestFoundAll,rejetonBestFound);
+						if (anytimeWriter != NULL)
+						{
+							rejetonBestFoundAll->exportSnapshot(snapshot);
+							anytimeWriter->push(snapshot);
+						}
 						timeBest2 = population->timeBest ;
 					}
 					else
@@ -226,6 +292,7 @@ void Genetic::evolveILS ()
 				cout << " | intraSwap " << rejeton->localSearch->nbIntraSwap ;
 				cout << " | inter2opt " << rejeton->localSearch->nbInter2Opt ;
 				cout << " | intra2opt " << rejeton->localSearch->nbIntra2Opt ;
+				cout << " | swapStar " << rejeton->localSearch->nbSwapStar ;
 				cout << " | " << endl ;
 				cout << " | CPU Time : " <<  (double)clock()/(double)CLOCKS_PER_SEC << " seconds " << endl ;
 				cout << endl ;
@@ -245,6 +312,293 @@ void Genetic::evolveILS ()
 	population->timeBest = timeBest2 ;
 }
 
+void Genetic::decomposition (int nbRec)
+{
+	int debut, fin, nbRoutes, nbRoutesGroupe, nbNonGroupees, germe, r, place ;
+	double dist ;
+	bool isImproved = false ;
+	vector <int> services, tour ;
+	vector < pair <double,int> > candidats ;
+	vector < vector <int> > routes ;
+	vector < vector <double> > barycentres ;
+	Individu * best = population->getIndividuBestValide() ;
+	int nbLandmarks = (int)params->landmarks.size() ;
+
+	// The subproblems are defined over the shortest paths between the nodes, with a single depot and a single period
+	// (no decomposition for the other problems, or when the problem is not larger than a subproblem)
+	if (best == NULL || (params->type != 30 && params->type != 31) || params->nbClients <= decompositionSize) 
+		return ;
+
+	// Routes of the best solution, and their barycentres in the space of the distances from the landmarks
+	for (int i=0 ; i < params->nombreVehicules[1] ; i++)
+	{
+		debut = best->chromR[1][i] ;
+		fin = (i == params->nombreVehicules[1]-1) ? (int)best->chromT[1].size() : best->chromR[1][i+1] ;
+		if (fin > debut)
+		{
+			routes.push_back(vector <int> (best->chromT[1].begin() + debut, best->chromT[1].begin() + fin));
+			barycentres.push_back(vector <double> (nbLandmarks,0.));
+			for (int j=debut ; j < fin ; j++)
+				for (int l=0 ; l < nbLandmarks ; l++)
+					barycentres.back()[l] += params->landmarkFrom[best->chromT[1][j]*nbLandmarks + l] / (double)(fin-debut) ;
+		}
+	}
+	nbRoutes = (int)routes.size() ;
+	if (nbRoutes < 2) 
+		return ;
+
+	if (traces) cout << "Decomposition of the best solution : " << nbRoutes << " routes" << endl ;
+
+	// Grouping the routes : a random route which is not grouped yet, with the closest routes until the group has about "decompositionSize" services
+	// The distance between two routes is the largest difference between the distances of their barycentres from a landmark
+	vector <bool> isGroupee (nbRoutes,false) ;
+	nbNonGroupees = nbRoutes ;
+	while (nbNonGroupees > 0)
+	{
+		r = rand() % nbNonGroupees ;
+		for (germe = 0 ; isGroupee[germe] || r > 0 ; germe++)
+			if (!isGroupee[germe]) r-- ;
+
+		candidats.clear();
+		for (int i=0 ; i < nbRoutes ; i++)
+		{
+			if (!isGroupee[i] && i != germe)
+			{
+				dist = 0. ;
+				for (int l=0 ; l < nbLandmarks ; l++)
+					dist = max(dist,fabs(barycentres[i][l] - barycentres[germe][l])) ;
+				candidats.push_back(pair <double,int> (dist,i));
+			}
+		}
+		sort(candidats.begin(),candidats.end());
+
+		services = routes[germe] ;
+		isGroupee[germe] = true ;
+		nbNonGroupees -- ;
+		nbRoutesGroupe = 1 ;
+		for (int c=0 ; c < (int)candidats.size() && (int)services.size() < decompositionSize ; c++)
+		{
+			services.insert(services.end(),routes[candidats[c].second].begin(),routes[candidats[c].second].end());
+			isGroupee[candidats[c].second] = true ;
+			nbNonGroupees -- ;
+			nbRoutesGroupe ++ ;
+		}
+
+		// A group with a single route (or any group once the run should finish) is kept as it is
+		if (nbRoutesGroupe < 2 || isTimeOver() || isBudgetOver() || isOptimal())
+			tour.insert(tour.end(),services.begin(),services.end());
+		else if (solveSubproblem(services,nbRoutesGroupe,nbRec,tour))
+			isImproved = true ;
+	}
+
+	if (!isImproved) 
+		return ;
+
+	// Reassembling the routes : the giant tour is split again and improved by the local search before entering the population
+	rejeton->recopieIndividu(rejeton,best);
+	rejeton->chromT[1] = tour ;
+	rejeton->generalSplit();
+	rejeton->updateLS();
+	rejeton->localSearch->runSearchTotal();
+	rejeton->updateIndiv();
+	population->updateNbValides(rejeton);
+	place = population->addIndividu(rejeton) ;
+
+	if (rejeton->estValide && place == 0)
+	{
+		if (traces) 
+			cout << "NEW BEST FEASIBLE (decomposition) " << rejeton->coutSol.evaluation << " distance : " << rejeton->coutSol.distance << " nbRoutes : " << rejeton->coutSol.routes << endl << endl ;
+		if (anytimeWriter != NULL)
+		{
+			population->getIndividuBestValide()->exportSnapshot(snapshot);
+			anytimeWriter->push(snapshot);
+		}
+		if (rejeton->coutSol.isBetterFeas(bestSolFeasibility)) 
+			bestSolFeasibility = rejeton->coutSol ;
+		if (trace != NULL)
+			trace->record(population,nbIter,"improvement");
+		nbIterNonProd = 1 ;
+	}
+}
+
+void Genetic::migration ()
+{
+	double cost ;
+	int place ;
+	Individu * best = population->getIndividuBestValide() ;
+
+	if (best != NULL && best->coutSol.evaluation < coutPublie - 0.0001)
+	{
+		islands->publier(best,best->coutSol.evaluation);
+		coutPublie = best->coutSol.evaluation ;
+	}
+
+	// The migrants only contain the giant tours and the patterns : they are split again and improved by the local search
+	while (islands->lireMigrant(rejeton,cost))
+	{
+		rejeton->updateChargeJour();
+		rejeton->generalSplit();
+		rejeton->updateLS();
+		rejeton->localSearch->runSearchTotal();
+		rejeton->updateIndiv();
+		population->updateNbValides(rejeton);
+		place = population->addIndividu(rejeton) ;
+
+		if (rejeton->estValide && place == 0)
+		{
+			if (traces) 
+				cout << "NEW BEST FEASIBLE (migration) " << rejeton->coutSol.evaluation << " distance : " << rejeton->coutSol.distance << " nbRoutes : " << rejeton->coutSol.routes << " cost on its island : " << cost << endl << endl ;
+			if (anytimeWriter != NULL)
+			{
+				population->getIndividuBestValide()->exportSnapshot(snapshot);
+				anytimeWriter->push(snapshot);
+			}
+			if (rejeton->coutSol.isBetterFeas(bestSolFeasibility)) 
+				bestSolFeasibility = rejeton->coutSol ;
+			if (trace != NULL)
+				trace->record(population,nbIter,"improvement");
+			nbIterNonProd = 1 ;
+		}
+	}
+}
+
+bool Genetic::solveSubproblem (vector <int> & services, int nbRoutes, int nbRec, vector <int> & tour)
+{
+	int nbServices = (int)services.size() ;
+	int seedSubproblem ;
+	double dist01, dist10, coutInitial ;
+	bool isImproved ;
+	InstanceInput instance ;
+	ServiceInput service ;
+	LinkInput link ;
+	vector <int> noeuds ;
+	vector <int> numero (params->ar_distanceNodes.size(),0) ;
+	char etat [sizeof(Params::etatRNG)] ;
+	char etatTemporaire [sizeof(Params::etatRNG)] ;
+
+	// Nodes of the subproblem : the depot and the extremities of the services, numbered from 1
+	noeuds.push_back(params->cli[0].ar_nodesExtr0);
+	numero[noeuds.back()] = 1 ;
+	for (int s=0 ; s < nbServices ; s++)
+	{
+		Client & myCli = params->cli[services[s]] ;
+		if (numero[myCli.ar_nodesExtr0] == 0)
+		{
+			noeuds.push_back(myCli.ar_nodesExtr0);
+			numero[myCli.ar_nodesExtr0] = (int)noeuds.size() ;
+		}
+		if (numero[myCli.ar_nodesExtr1] == 0)
+		{
+			noeuds.push_back(myCli.ar_nodesExtr1);
+			numero[myCli.ar_nodesExtr1] = (int)noeuds.size() ;
+		}
+	}
+	instance.nbNodes = (int)noeuds.size() ;
+	instance.depots.push_back(1);
+	instance.nbVehicles = nbRoutes ;
+	instance.capacity = params->vehicleCapacity ;
+
+	// Services, in the order of the routes
+	for (int s=0 ; s < nbServices ; s++)
+	{
+		Client & myCli = params->cli[services[s]] ;
+		service.nodeType = myCli.ar_nodeType ;
+		service.node0 = numero[myCli.ar_nodesExtr0] ;
+		service.node1 = numero[myCli.ar_nodesExtr1] ;
+		service.demand = myCli.demand ;
+		service.serviceCost01 = myCli.ar_serviceCost01 ;
+		service.serviceCost10 = myCli.ar_serviceCost10 ;
+		service.travelCost01 = params->ar_distanceNodes[myCli.ar_nodesExtr0][myCli.ar_nodesExtr1] ;
+		service.travelCost10 = params->ar_distanceNodes[myCli.ar_nodesExtr1][myCli.ar_nodesExtr0] ;
+		service.freq = 1 ;
+		instance.services.push_back(service);
+	}
+
+	// Links : the shortest paths of the complete network between the nodes of the subproblem
+	// (such that the distances between the services of the subproblem are the same as in the complete problem)
+	for (int a=0 ; a < instance.nbNodes ; a++)
+	{
+		for (int b=a+1 ; b < instance.nbNodes ; b++)
+		{
+			dist01 = params->ar_distanceNodes[noeuds[a]][noeuds[b]] ;
+			dist10 = params->ar_distanceNodes[noeuds[b]][noeuds[a]] ;
+			link.isArc = (dist01 != dist10) ;
+			link.node0 = a+1 ;
+			link.node1 = b+1 ;
+			link.cost01 = dist01 ;
+			link.cost10 = dist10 ;
+			if (dist01 < 1.e20) instance.links.push_back(link);
+			if (link.isArc && dist10 < 1.e20)
+			{
+				link.node0 = b+1 ;
+				link.node1 = a+1 ;
+				link.cost01 = dist10 ;
+				link.cost10 = dist01 ;
+				instance.links.push_back(link);
+			}
+		}
+	}
+
+	// The subproblem initializes the random number generator with its own seed : the state of the generator of the main search is saved and restored afterwards
+	// (for this reason, the subproblems are solved one after the other, the generator being shared by the whole process)
+	seedSubproblem = 1 + rand() % 1000000 ;
+	setstate(Params::etatRNG);
+	memcpy(etat, Params::etatRNG, sizeof(etat));
+
+	Params * subParams = new Params(instance,seedSubproblem,params->type,nbRoutes,false) ;
+	subParams->stopToken = params->stopToken ;
+	subParams->penalityCapa = params->penalityCapa ;
+	subParams->penalityLength = params->penalityLength ;
+	subParams->ordonnanceur.isAdaptatif = params->ordonnanceur.isAdaptatif ;
+	subParams->sizeSD = params->sizeSD ;
+	subParams->isIndividusAlleges = params->isIndividusAlleges ;
+	Population * subPopulation = new Population(subParams,true) ;
+	Genetic * subGenetic = new Genetic(subParams,subPopulation,tempsMax - tempsEcoule(),false) ;
+	subGenetic->nbIterMax = decompositionInterval ;
+	if (nbEvaluationsMax > 0) subGenetic->nbEvaluationsMax = nbEvaluationsMax - params->nbEvaluationsLS ;
+	if (nbSplitsMax > 0) subGenetic->nbSplitsMax = nbSplitsMax - params->nbSplits ;
+
+	// The current routes of the group also enter the initial population of the subproblem
+	Individu * initial = subGenetic->rejeton ;
+	for (int s=0 ; s < nbServices ; s++)
+		initial->chromT[1][s] = subParams->nbDepots + s ;
+	initial->generalSplit();
+	coutInitial = initial->estValide ? initial->coutSol.evaluation : 1.e30 ;
+	initial->updateLS();
+	initial->localSearch->runSearchTotal();
+	initial->updateIndiv();
+	subPopulation->updateNbValides(initial);
+	subPopulation->addIndividu(initial);
+
+	subGenetic->evolve(decompositionInterval,nbRec-1);
+
+	// Giant tour of the best routes of the subproblem, with the services numbered as in the complete problem
+	Individu * subBest = subPopulation->getIndividuBestValide() ;
+	isImproved = (subBest != NULL && subBest->coutSol.evaluation < coutInitial - 0.0001) ;
+	for (int s=0 ; s < nbServices ; s++)
+		tour.push_back(isImproved ? services[subBest->chromT[1][s] - subParams->nbDepots] : services[s]);
+
+	// The work done on the subproblem counts in the budgets of the main search
+	params->nbEvaluationsLS += subParams->nbEvaluationsLS ;
+	params->nbSplits += subParams->nbSplits ;
+	for (int v=0 ; v < NB_VOISINAGES ; v++)
+	{
+		params->ordonnanceur.nbEvaluations[v] += subParams->ordonnanceur.nbEvaluations[v] ;
+		params->ordonnanceur.nbSucces[v] += subParams->ordonnanceur.nbSucces[v] ;
+		params->ordonnanceur.nbIgnores[v] += subParams->ordonnanceur.nbIgnores[v] ;
+	}
+	delete subGenetic ;
+	delete subPopulation ;
+	delete subParams ;
+
+	// Restoring the state of the generator of the main search (see Checkpoint::restore)
+	memcpy(etatTemporaire, etat, sizeof(etat));
+	setstate(etatTemporaire);
+	memcpy(Params::etatRNG, etatTemporaire, sizeof(etat));
+	setstate(Params::etatRNG);
+	return isImproved ;
+}
+
 void Genetic::reparer ()
 {
 	double temp, temp2  ;
@@ -311,6 +665,7 @@ void Genetic::gererPenalites ()
 
 void Genetic::crossOX ()
 {
+	PROFILE_SCOPE(PROF_CROSS_OX);
 	int temp;
 
 	// We pick the beginning and end of the crossover zone
@@ -345,8 +700,12 @@ void Genetic::crossOX ()
 
 void Genetic::crossPIX ()
 {
-	vector < int > vide, garder, joursPerturb, tableauFin, tableauEtat ;
-	vector < vector <int> > garder2 ;
+	PROFILE_SCOPE(PROF_CROSS_PIX);
+	// (the temporary structures are kept in the workspace of the search, to avoid any allocation)
+	vector < int > & garder = params->workspace.garder ;
+	vector < int > & joursPerturb = params->workspace.joursPerturb ;
+	vector < int > & tableauFin = params->workspace.tableauFin ;
+	vector < vector <int> > & garder2 = params->workspace.garder2 ;
 	int jj,i,ii,j,temp,size ;
 	int debut, fin, day ;
 	int j1,j2 ;
@@ -361,6 +720,8 @@ void Genetic::crossPIX ()
 	}
 
 	// We take the days in random order
+	joursPerturb.clear();
+	tableauFin.clear();
 	for (int k=1 ; k <= params->nbDays ; k++ )
 		joursPerturb.push_back(k) ;
 	for (i = 0 ; i < (int)joursPerturb.size() ; i++)
@@ -382,7 +743,7 @@ void Genetic::crossPIX ()
 	}
 
 	for (int k = 0 ; k <= params->nbDays ; k ++ ) 
-		garder2.push_back(vide);
+		garder2[k].clear();
 
 	// Inheriting the visits
 	for (int k = 0 ; k < params->nbDays ; k ++ )
@@ -464,6 +825,9 @@ void Genetic::crossPIX ()
 			rejeton->chromT[k].push_back(garder[iii]);
 	}
 
+	// The patterns of the services have changed (the missing visits receive their pattern during their insertion)
+	rejeton->updateChargeJour();
+
 	rejeton->toPlace.clear();
 	// We gather in "toPlace" those elements with missing visits
 	for (i=0 ; i < params->nbClients + params->nbDepots ; i++ )
@@ -491,22 +855,71 @@ void Genetic::crossPIX ()
 	rejeton->updateIndiv();
 }
 
-Genetic::Genetic(Params * params,Population * population, clock_t ticks, bool traces) : 
-ticks(ticks), traces(traces), population(population), params(params)
+int Genetic::getNbIter ()
 {
+	return nbIter ;
+}
+
+double Genetic::tempsEcoule ()
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - debut).count() ;
+}
+
+bool Genetic::isTimeOver ()
+{
+	return (tempsEcoule() > tempsMax) || (params->stopToken != NULL && params->stopToken->isStopped()) ;
+}
+
+bool Genetic::isBudgetOver ()
+{
+	return (nbIterMax > 0 && nbIter >= nbIterMax)
+		|| (nbEvaluationsMax > 0 && params->nbEvaluationsLS >= nbEvaluationsMax)
+		|| (nbSplitsMax > 0 && params->nbSplits >= nbSplitsMax) ;
+}
+
+bool Genetic::isOptimal ()
+{
+	return LowerBound::isAtteinte(population->getIndividuBestValide() != NULL ? population->getIndividuBestValide()->coutSol.distance : 1.e30,borneInferieure) ;
+}
+
+Genetic::Genetic(Params * params,Population * population, double tempsMax, bool traces) : 
+tempsMax(tempsMax), traces(traces), population(population), params(params)
+{
+	anytimeWriter = NULL ;
+	checkpoint = NULL ;
+	trace = NULL ;
+	nbIterMax = 0 ;
+	nbEvaluationsMax = 0 ;
+	nbSplitsMax = 0 ;
+	borneInferieure = 0 ;
+	decompositionSize = 0 ;
+	decompositionInterval = 5000 ;
+	islands = NULL ;
+	migrationInterval = 100 ;
+	coutPublie = 1.e30 ;
+	isResumed = false ;
+
 	for (int i=0 ; i < params->nbClients + params->nbDepots ; i++ )
 		freqClient.push_back(params->cli[i].freq);
 
 	// Creating the Individuals that serve to perform the Local Search and other operations
 	rejeton = new Individu (params, true) ; 
-	rejeton2 = new Individu(params, true) ; 
-	rejetonP1 = new Individu(params, true) ; 
-	rejetonP2 = new Individu(params, true) ; 
-	rejetonBestFound = new Individu(params, true) ; 
-	rejetonBestFoundAll = new Individu(params, true) ; 
+	rejeton2 = creerConteneur() ; 
+	rejetonP1 = creerConteneur() ; 
+	rejetonP2 = creerConteneur() ; 
+	rejetonBestFound = creerConteneur() ; 
+	rejetonBestFoundAll = creerConteneur() ; 
 	rejeton->localSearch = new LocalSearch(params,rejeton) ;
 } 
 
+Individu * Genetic::creerConteneur ()
+{
+	Individu * indiv = new Individu(params, true) ;
+	if (params->isIndividusAlleges)
+		indiv->libereStructuresSplit();
+	return indiv ;
+}
+
 Genetic::~Genetic(void)
 { 
 	delete rejeton ;
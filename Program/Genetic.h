@@ -22,29 +22,67 @@
 #include "Population.h"
 #include "Params.h"
 #include "Individu.h"
+#include "AnytimeWriter.h"
+#include "ConvergenceTrace.h"
 #include "time.h"
 #include <stdlib.h>
 #include <stdio.h> 
 #include <vector>
 #include <list>
 #include <math.h>
+#include <chrono>
 using namespace std ;
+class Checkpoint ;
+class IslandExchange ;
 
 class Genetic
 {
 
 private:
 
+	// The checkpoints need to save and restore the state of the search
+	friend class Checkpoint ;
+
 	// number of iterations without improvement (during the execution of the HGA)
 	int nbIterNonProd ;
 
 	// number of iterations (during the execution of the HGA)
 	int nbIter ;
 
+	// position of the last repaired individual in the population (during the execution of the HGA)
+	int place2 ;
+
+	// best solution in terms of feasibility (during the execution of the HGA)
+	CoutSol bestSolFeasibility ;
+
+	// wall-clock time at the start of the HGA
+	chrono::steady_clock::time_point debut ;
+
+	// says if the state of the search has been restored from a checkpoint (in this case the HGA continues from this state)
+	bool isResumed ;
+
+	// solves the subproblem made of the services of a group of routes (given in the order of the routes) with a HGA of its own
+	// the giant tour of the best solution of the subproblem (or the initial order, if it is not better) is appended to "tour"
+	// returns true if the subproblem led to an improvement of the routes
+	bool solveSubproblem (vector <int> & services, int nbRoutes, int nbRec, vector <int> & tour) ;
+
+	// cost of the last individual published to the other islands (during the execution of the HGA)
+	double coutPublie ;
+
 public:
 
-	// allowed time
-    clock_t ticks ;
+	// allowed time for this run, in seconds of wall-clock time
+	double tempsMax ;
+
+	// work budgets of this run (0 if no limit) : number of iterations, of move evaluations of the local search, and of calls to Split
+	// unlike the time limit, these budgets lead to the same search trajectory on any machine (for a given seed)
+	int nbIterMax ;
+	long long nbEvaluationsMax ;
+	long long nbSplitsMax ;
+
+	// lower bound on the distance (see LowerBound.h) : the run stops as soon as the best feasible solution reaches it,
+	// this solution being optimal (0 if not used)
+	double borneInferieure ;
 
 	// printing search traces or not
 	bool traces ;
@@ -62,9 +100,25 @@ public:
 	Individu * rejetonBestFound ;
 	Individu * rejetonBestFoundAll ;
 
+	// creates a working individual which only receives copies of solutions (all but rejeton) : with a memory budget,
+	// it does not keep the structures of Split, which are freed before the next individual is created (see MemoryEstimate.h)
+	Individu * creerConteneur () ;
+
 	// Pointer towards the parameters of the problem
 	Params * params ;
 
+	// Optional background writer, receiving each new best feasible solution (NULL if not used)
+	AnytimeWriter * anytimeWriter ;
+
+	// snapshot of the best solution, handed out to the anytimeWriter
+	SolutionSnapshot snapshot ;
+
+	// Optional periodic saving of the state of the search (NULL if not used)
+	Checkpoint * checkpoint ;
+
+	// Optional machine-readable trace of the convergence (NULL if not used)
+	ConvergenceTrace * trace ;
+
     // Running the algorithm until "maxIterations" total iterations have been reached, 
 	// or "maxIterNonProd" consecutive iterations without improvement have been reached
 	// nbRec is a parameter that says if we are in the main loop of the algorithm, or inside a decomposition phase
@@ -89,8 +143,42 @@ public:
 	// regular management of the penalty coefficients
 	void gererPenalites ();
 
+	// decomposition phases (only for the CARP and NEARP, decompositionSize = 0 if not used) : target number of services of each subproblem,
+	// and number of iterations between two phases (also the iteration budget of the HGA on each subproblem)
+	int decompositionSize ;
+	int decompositionInterval ;
+
+	// Decomposition phase : the routes of the best feasible solution are grouped by proximity in the network,
+	// the services of each group form a subproblem solved by another HGA (see solveSubproblem),
+	// and the improved routes are reassembled into a new individual of the population
+	void decomposition (int nbRec) ;
+
+	// Optional exchange of individuals with other processes solving the same instance (NULL if not used),
+	// and number of iterations between two migrations
+	IslandExchange * islands ;
+	int migrationInterval ;
+
+	// Migration : the best feasible individual is published to the other islands if it improved since the last publication,
+	// and the individuals published by the other islands are improved by the local search and inserted in the population
+	void migration () ;
+
+	// number of iterations done by the HGA
+	int getNbIter ();
+
+	// wall-clock time elapsed since the start of the HGA, in seconds
+	double tempsEcoule ();
+
+	// says if the run should finish : allowed time elapsed, or stop of the search requested (see StopToken)
+	bool isTimeOver ();
+
+	// says if one of the work budgets of the run is exhausted
+	bool isBudgetOver ();
+
+	// says if the best feasible solution reaches the lower bound
+	bool isOptimal ();
+
 	// Constructor
-	Genetic(Params * params,Population * population, clock_t ticks, bool traces);
+	Genetic(Params * params,Population * population, double tempsMax, bool traces);
 
 	// Destructor
 	~Genetic(void);
@@ -17,20 +17,17 @@
 //  ---------------------------------------------------------------------- */
 
 #include "Individu.h"
+#include "Profiler.h"
 
 Individu::Individu(Params * params, bool createAllStructures) : params(params)
 {
-	// Initializing some structures that enable to compute the data on subsequences in the Split algorithm
-	myseq = new SeqData(params);
-	for (int i=0 ; i<params->nbClients + params->nbDepots +1 ; i++) 
-		seq.push_back(new SeqData(params)); 
-
 	vector <int> tempVect ;
 	vector <double> tempVectDbl ;
 	pattern p1 ;
 	p1.dep = 0 ;
 	p1.pat = 0 ;
 	localSearch = new LocalSearch() ;
+	myseq = NULL ;
 
 	// Initializing the chromosome structures
 	for (int i = 0 ; i <= params->nbDays ; i++)
@@ -55,6 +52,10 @@ Individu::Individu(Params * params, bool createAllStructures) : params(params)
 		}
 	}
 
+	// Loads of the visits with the current patterns (PCARP)
+	if (params->ancienNbDays > 1)
+		chargeJour = vector <double> ((params->nbDays+1)*(params->nbClients+params->nbDepots),0.);
+
 	// If we wish to also create the individual, the local search and Split structures
 	if (createAllStructures)
 	{
@@ -69,6 +70,15 @@ Individu::Individu(Params * params, bool createAllStructures) : params(params)
 		for (int i = 0 ; i <= params->nbDays ; i++)
 			charge.push_back(0);
 
+		// The chromosomes are reserved to their maximum size (all services on one day, all visits missing)
+		// such that the copies of other individuals and the crossovers do not allocate memory
+		int nbVisites = 0 ;
+		for (int i = 0 ; i < params->nbClients + params->nbDepots ; i++)
+			nbVisites += params->cli[i].freq ;
+		for (int k = 0 ; k <= params->nbDays ; k++)
+			chromT[k].reserve(params->nbClients + params->nbDepots);
+		toPlace.reserve(nbVisites);
+
 		for (int i = params->nbDepots ; i < params->nbClients + params->nbDepots ; i++)
 		{
 			if (params->cli[i].freq != 0)
@@ -85,6 +95,7 @@ Individu::Individu(Params * params, bool createAllStructures) : params(params)
 				}
 			}
 		}
+		updateChargeJour();
 
 		// shuffling
 		for (int k = 1 ; k <= params->nbDays ; k++)
@@ -100,6 +111,11 @@ Individu::Individu(Params * params, bool createAllStructures) : params(params)
 
 		/* CREATING THE SPLIT STRUCTURES */
 
+		// Initializing some structures that enable to compute the data on subsequences in the Split algorithm
+		myseq = new SeqData(params);
+		for (int i=0 ; i<params->nbClients + params->nbDepots +1 ; i++) 
+			seq.push_back(new SeqData(params)); 
+
 		for (int k = 0 ; k <= params->nbDays ; k++)
 		{
 			pred.push_back(tempVect2);
@@ -137,10 +153,21 @@ Individu::Individu(Params * params, bool createAllStructures) : params(params)
 	}
 }
 
+void Individu::libereStructuresSplit ()
+{
+	FreeClear(seq);
+	delete myseq ;
+	myseq = NULL ;
+	vector < vector < CoutSol> > ().swap(potentiels);
+	vector < vector < vector<int> > > ().swap(pred);
+	vector < vector < CoutSol> > ().swap(coutArcsSplit);
+}
+
 void Individu::recopieIndividu (Individu * destination , Individu * source)
 {
 	destination->chromT = source->chromT ;
 	destination->chromP = source->chromP ;
+	destination->chargeJour = source->chargeJour ;
 	destination->chromR = source->chromR ;
 	destination->coutSol.capacityViol = source->coutSol.capacityViol ;
 	destination->coutSol.evaluation = source->coutSol.evaluation ;
@@ -154,12 +181,155 @@ void Individu::recopieIndividu (Individu * destination , Individu * source)
 	destination->precedents = source->precedents ;
 	destination->nbRoutes = source->nbRoutes ;
 	destination->maxRoute = source->maxRoute ;
-	destination->potentiels = source->potentiels ;
-	destination->pred = source->pred ;
+	// (the structures of Split, potentiels and pred, are working memory which is reinitialized by each Split, they are not copied)
 	destination->toPlace.clear();
 	destination->toPlace = source->toPlace ;
 }
 
+void Individu::exportSnapshot (SolutionSnapshot & snapshot)
+{
+	int debut, fin, client ;
+	RouteSnapshot route ;
+	snapshot.routes.clear();
+	snapshot.nbRoutes = 0 ;
+	snapshot.cost = (params->type == 35) ? maxRoute : coutSol.distance ;
+	snapshot.time = chrono::steady_clock::now() ;
+
+	for (int k=1 ; k <= params->nbDays ; k++)
+	{
+		for (int i=0 ; i < params->nombreVehicules[k] ; i++)
+		{
+			// the route i covers the positions chromR[k][i] to chromR[k][i+1]-1 of the giant tour
+			debut = chromR[k][i] ;
+			fin = (i == params->nombreVehicules[k]-1) ? (int)chromT[k].size() : chromR[k][i+1] ;
+			if (fin > debut)
+			{
+				route.depot = params->ordreVehicules[k][i].depotNumber ;
+				route.day = (k-1)%params->ancienNbDays + 1 ;
+				route.load = 0 ;
+				route.services.clear();
+				for (int j=debut ; j < fin ; j++)
+				{
+					client = chromT[k][j] ;
+					route.load += getCharge(client,k) ;
+					route.services.push_back(client);
+				}
+				snapshot.routes.push_back(route);
+				snapshot.nbRoutes ++ ;
+			}
+		}
+	}
+}
+
+void Individu::importSolution (string nomFichier)
+{
+	ifstream fichier ;
+	string mot, visite ;
+	int depot, day, indexRoute, nbVisites, service, k, bitDay ;
+	double load, cost ;
+	int nbRoutesLues = 0 ;
+	int nbNodes = params->nbClients + params->nbDepots ;
+	vector < vector <int> > servicesDay = vector < vector <int> > (params->nbDays + 1) ;
+	vector <int> depotService = vector <int> (nbNodes,-1) ;
+	vector <int> patService = vector <int> (nbNodes,0) ;
+	vector <bool> isCoherent = vector <bool> (nbNodes,true) ;
+	vector <bool> isPlaced = vector <bool> (nbNodes,false) ;
+
+	fichier.open(nomFichier.c_str());
+	if (!fichier.is_open())
+		throw string("Impossible to open the initial solution file " + nomFichier);
+
+	// Skipping the cost, number of routes, and the two CPU times
+	for (int i=0 ; i < 4 ; i++)
+		fichier >> mot ;
+
+	// Reading the routes : depot, day, index, load, cost, number of visits, and the visits (D depot,i,j) or (S service,i,j)
+	// The orientations of the services are not needed, they will be recomputed by Split and the LS
+	while (fichier >> depot >> day >> indexRoute >> load >> cost >> nbVisites)
+	{
+		if (depot < 0 || depot >= params->nbDepots || day < 1 || day > params->ancienNbDays)
+			throw string("Incorrect route in the initial solution file " + nomFichier);
+		k = day + depot * params->ancienNbDays ;
+		bitDay = 1 << (params->ancienNbDays - day) ;
+		for (int j=0 ; j < nbVisites ; j++)
+		{
+			fichier >> mot >> visite ;
+			service = atoi(visite.c_str()) ;
+			if (mot == "(S" && service >= params->nbDepots && service < nbNodes)
+			{
+				servicesDay[k].push_back(service);
+				if ((depotService[service] != -1 && depotService[service] != depot) || (patService[service] & bitDay))
+					isCoherent[service] = false ;
+				depotService[service] = depot ;
+				patService[service] |= bitDay ;
+			}
+		}
+		nbRoutesLues ++ ;
+	}
+	if (nbRoutesLues == 0 || !fichier.eof())
+		throw string("The initial solution file " + nomFichier + " could not be read");
+
+	// Keeping the patterns which are still possible for the instance
+	for (int i = params->nbDepots ; i < nbNodes ; i++)
+	{
+		if (params->cli[i].freq != 0 && isCoherent[i])
+		{
+			for (int p = 0 ; p < (int)params->cli[i].visits.size() && !isPlaced[i] ; p++)
+			{
+				if (params->cli[i].visits[p].pat == patService[i] && params->cli[i].visits[p].dep == depotService[i])
+				{
+					chromP[i] = params->cli[i].visits[p] ;
+					isPlaced[i] = true ;
+				}
+			}
+		}
+	}
+
+	// Giant tours, in the order of the routes of the file
+	for (int kk = 1 ; kk <= params->nbDays ; kk++)
+	{
+		chromT[kk].clear();
+		for (int j=0 ; j < (int)servicesDay[kk].size() ; j++)
+			if (isPlaced[servicesDay[kk][j]])
+				chromT[kk].push_back(servicesDay[kk][j]);
+	}
+
+	// Other services (e.g., new services in the instance), with a random pattern and random insertion positions
+	for (int i = params->nbDepots ; i < nbNodes ; i++)
+	{
+		if (params->cli[i].freq != 0 && !isPlaced[i])
+		{
+			chromP[i] = params->cli[i].visits[rand() % (int)params->cli[i].visits.size()];
+			for (int d = 0 ; d < params->ancienNbDays ; d++)
+			{
+				if ((chromP[i].pat >> d) % 2 == 1)
+				{
+					k = params->ancienNbDays - d + chromP[i].dep * params->ancienNbDays ;
+					chromT[k].insert(chromT[k].begin() + rand() % ((int)chromT[k].size() + 1), i);
+				}
+			}
+		}
+	}
+	updateChargeJour();
+	isFitnessComputed = false ;
+}
+
+void Individu::updateChargeJour (int client)
+{
+	if (params->ancienNbDays == 1) return ;
+	int nbNoeuds = params->nbClients + params->nbDepots ;
+	vector <double> & demandPat = params->cli[client].demandPatDay[chromP[client].pat] ;
+	for (int k = 1 ; k <= params->nbDays ; k++)
+		chargeJour[k*nbNoeuds+client] = demandPat[k] ;
+}
+
+void Individu::updateChargeJour ()
+{
+	if (params->ancienNbDays == 1) return ;
+	for (int i = 0 ; i < params->nbClients + params->nbDepots ; i++)
+		updateChargeJour(i);
+}
+
 void Individu::shakingSwap (int nbShak)
 {
 	// only used in the ILS
@@ -191,6 +361,8 @@ Individu::~Individu()
 
 void Individu::generalSplit()
 {
+	PROFILE_SCOPE(PROF_SPLIT);
+	params->nbSplits ++ ;
 	coutSol.evaluation = 0 ;
 	coutSol.capacityViol = 0 ;
 	coutSol.distance = 0 ;
@@ -528,19 +700,14 @@ void Individu::updateIndiv()
 {
 	// Now, we go through the LS structure to update the individual (its chromosomes)
 	int pos ; 
-	vector < Route * > ordreRoutes ;
 	Noeud * node ;
 
 	for (int kk = 1 ; kk <= params->nbDays ; kk++)
 	{
-		ordreRoutes.clear();
-		for (int ii=0 ; ii < params->nombreVehicules[kk] ; ii++)
-			ordreRoutes.push_back(&localSearch->routes[kk][ii]);
-
 		pos = 0 ;
-		for (int r=0 ; r < (int)ordreRoutes.size() ; r ++)
+		for (int r=0 ; r < params->nombreVehicules[kk] ; r ++)
 		{
-			node = ordreRoutes[r]->depot->suiv ;
+			node = localSearch->routes[kk][r].depot->suiv ;
 			while (!node->estUnDepot)
 			{
 				chromT[kk][pos]= node->cour;
@@ -588,6 +755,10 @@ void Individu::testPatternCorrectness()
 
 	for (int i=params->nbDepots ; i < params->nbClients + params->nbDepots ; i++ )
 		if ( chromP[i].dep < 0 || chromP[i].dep >= params->nbDepots  ) throw string ("Incorrect solution with missing visits") ;
+
+	// (MDCARP) with a restriction to the closest depots, each service is serviced from one of its closest depots
+	for (int i=params->nbDepots ; i < params->nbClients + params->nbDepots ; i++ )
+		if ( !params->cli[i].isDepotProche.empty() && !params->cli[i].isDepotProche[chromP[i].dep] ) throw string ("Incorrect solution with a service assigned to a depot outside of its closest depots") ;
 }
 
 double Individu::distance(Individu * indiv2)
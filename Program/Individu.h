@@ -22,6 +22,8 @@
 #include <vector>
 #include <list>
 #include <iostream> 
+#include <time.h>
+#include <chrono>
 #include "Noeud.h"
 #include "Params.h"
 #include "LocalSearch.h"
@@ -68,6 +70,40 @@ struct CoutSol {
 	}
 };
 
+// Compact description of a route, as given by the Split of an individual
+// (services in visiting order, without the orientations which require the LS structures)
+struct RouteSnapshot {
+
+	// depot at the beginning and end of the route
+	int depot ;
+
+	// day of the route
+	int day ;
+
+	// total demand serviced by the route
+	double load ;
+
+	// services in the order of the visits
+	vector <int> services ;
+};
+
+// Compact description of a complete solution, cheap to build from the chromosomes
+// Used to hand out solutions to other threads without blocking the search
+struct SolutionSnapshot {
+
+	// objective value (distance, or length of the maximum route for the MM-kWRPP)
+	double cost ;
+
+	// number of non-empty routes
+	int nbRoutes ;
+
+	// wall-clock time when the snapshot was taken
+	chrono::steady_clock::time_point time ;
+
+	// non-empty routes of the solution
+	vector <RouteSnapshot> routes ;
+};
+
 // preliminary declaration, because proxData depends on Individu
 class Individu ;
 
@@ -116,6 +152,25 @@ public:
 	// Pattern chromosome of an individual
 	vector < pattern > chromP ;
 
+	// (PCARP) load collected at each visit with the current patterns, stored contiguously for each day
+	// chargeJour[day*(nbClients+nbDepots)+client] = cli[client].demandPatDay[chromP[client].pat][day]
+	// it must be refreshed after each change of the chromP (see updateChargeJour), and stays empty for the single-period problems
+	vector < double > chargeJour ;
+
+	// load collected at the visit of a service on a day (used in the evaluation of all routes)
+	// for the single-period problems, the load does not depend on the pattern and is directly the demand of the service
+	double getCharge (int client, int day)
+	{
+		if (params->ancienNbDays == 1) return params->cli[client].demand ;
+		return chargeJour[day*(params->nbClients+params->nbDepots)+client] ;
+	}
+
+	// refreshes the loads of a service after a change of its pattern
+	void updateChargeJour (int client) ;
+
+	// refreshes the loads of all services
+	void updateChargeJour () ;
+
 	// Indices of the beginning of the routes (if already computed via Split)
 	// chromR[i][j] -> day i, route j, gives the index in the chromT of the first customer in this route
 	vector < vector<int> > chromR ;
@@ -170,9 +225,13 @@ public:
 	LocalSearch * localSearch ;
 
 	// Data structure for preprocessing information on sequences during the Split algorithm
+	// (only for the complete individuals, like the structures of Split above)
 	vector<SeqData *> seq ;
 	SeqData * myseq ;
 
+	// frees the structures of Split of a complete individual which is only used as a container (see MemoryEstimate.h)
+	void libereStructuresSplit () ;
+
 	// Split function
 	// tries first the simple Split without considering the limit on the number of vehicles
 	// if the solution does not respect the number of trips, calls the Split with limited fleet.
@@ -206,12 +265,19 @@ public:
 	// Warning, only copies the chromosomes for storage, not all other structures (potentials and LS)
 	void recopieIndividu (Individu * destination , Individu * source);
 
+	// fills a compact description of the routes, using the chromT and chromR structures (Split must have been computed before)
+	void exportSnapshot (SolutionSnapshot & snapshot);
+
+	// fills the chromT and chromP structures from a solution file, in the format written by Population::ExportBest
+	// the services which do not appear in the file, or with a pattern which is not possible anymore, receive a random pattern and random positions
+	void importSolution (string nomFichier);
+
 	// shaking operator, acting on the chromT structure, used by the ILS version of the code
 	// with nbShak random swaps between two customer visits in randomly chosen days.
 	void shakingSwap (int nbShak);
 
 	// constructor of a random individual
-	// if the flag "createAllStructures" is set to true, all search structures, including the LS are also initialized
+	// if the flag "createAllStructures" is set to true, all search structures, including the LS and Split, are also initialized
 	Individu(Params * params, bool createAllStructures);
 
 	//destructor
@@ -0,0 +1,391 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include "InstanceCache.h"
+#include "BinaryIO.h"
+#include "Params.h"
+#include <string.h>
+#include <stdio.h>
+#include <sstream>
+#include <errno.h>
+#include <unistd.h>
+
+uint64_t InstanceCache::hash (const char * data, size_t size)
+{
+	uint64_t h = 14695981039346656037ULL ;
+	for (size_t i=0 ; i < size ; i++)
+	{
+		h ^= (unsigned char)data[i] ;
+		h *= 1099511628211ULL ;
+	}
+	return h ;
+}
+
+string InstanceCache::fileName (string directory, uint64_t hashInstance, int type, int nbDepots)
+{
+	char hexa [17] ;
+	snprintf(hexa, sizeof(hexa), "%016llx", (unsigned long long)hashInstance);
+	ostringstream nom ;
+	nom << directory ;
+	if (directory != "" && directory[directory.size()-1] != '/') nom << "/" ;
+	nom << hexa << "-t" << type << "-d" << nbDepots << ".bin" ;
+	return nom.str();
+}
+
+// Fills a header with the characteristics of this program and instance
+static void fillHeader (CacheHeader & header, Params * params, uint64_t hashInstance, uint64_t sizeInstance)
+{
+	memset(&header, 0, sizeof(CacheHeader));
+	strcpy(header.magic, "HGSCARP");
+	header.version = CACHE_VERSION ;
+	#ifdef TURN_PENALTIES
+	header.turnPenalties = 1 ;
+	#else
+	header.turnPenalties = 0 ;
+	#endif
+	header.type = params->type ;
+	header.nbDepots = (params->type == 33) ? params->nbDepots : 1 ;
+	header.granularity = params->granularity ;
+	header.sizeofDouble = (int)sizeof(double) ;
+	header.sizeofPattern = (int)sizeof(pattern) ;
+	header.sizeofArc = (int)sizeof(Arc) ;
+	header.hashInstance = hashInstance ;
+	header.sizeInstance = sizeInstance ;
+}
+
+void InstanceCache::serialize (Params * params, uint64_t hashInstance, uint64_t sizeInstance, vector <char> & buffer)
+{
+	int nbNoeuds = params->nbClients + params->nbDepots ;
+	CacheHeader header ;
+	fillHeader(header, params, hashInstance, sizeInstance);
+	buffer.clear();
+	buffer.resize(sizeof(CacheHeader));
+	BinaryWriter w(buffer);
+
+	// Problem characteristics
+	w.put(params->multiDepot);
+	w.put(params->periodique);
+	w.put(params->isTurnPenalties);
+	w.put(params->ar_NodesRequired);
+	w.put(params->ar_NodesNonRequired);
+	w.put(params->ar_EdgesRequired);
+	w.put(params->ar_EdgesNonRequired);
+	w.put(params->ar_ArcsRequired);
+	w.put(params->ar_ArcsNonRequired);
+	w.put(params->ar_nbArcsDistance);
+	w.put(params->ar_nbTurns);
+	w.put(params->ar_maxNbModes);
+	w.put(params->ar_tempIndexDepot);
+	w.put(params->parsing_courNbArcs);
+	w.put(params->nbClients);
+	w.put(params->nbTotalServices);
+	w.put(params->totalDemand);
+	w.put(params->nbDays);
+	w.put(params->ancienNbDays);
+	w.put(params->nbDepots);
+	w.put(params->nbVehiculesFichier);
+	w.put(params->vehicleCapacity);
+
+	// Distances
+	w.putMatrix(params->ar_distanceNodes);
+	w.putVector(params->ar_Arcs);
+	w.putMatrix(params->ar_distanceArcs);
+	for (int i=0 ; i < nbNoeuds ; i++)
+		for (int j=0 ; j < nbNoeuds ; j++)
+			w.put(params->timeCost[i][j]);
+	for (int i=0 ; i < nbNoeuds ; i++)
+		for (int j=0 ; j < nbNoeuds ; j++)
+			w.put((char)params->isCorrelated[i][j]);
+
+	// Services
+	vector <int> modes ;
+	for (int i=0 ; i < nbNoeuds ; i++)
+	{
+		Client * c = &params->cli[i] ;
+		w.put(c->custNum);
+		w.put(c->coord);
+		w.put(c->serviceDuration);
+		w.put(c->demand);
+		w.put(c->freq);
+		w.put(c->codeTravail);
+		w.put((int)c->ar_nodeType);
+		w.put(c->ar_nodesExtr0);
+		w.put(c->ar_nodesExtr1);
+		w.put(c->ar_serviceCost01);
+		w.put(c->ar_serviceCost10);
+		w.put(c->ar_nbModes);
+		modes.clear();
+		for (int k=0 ; k < (int)c->ar_Modes.size() ; k++)
+			modes.push_back((int)(c->ar_Modes[k] - &params->ar_Arcs[0]));
+		w.putVector(modes);
+		w.putVector(c->visits);
+		w.putVector(c->visitsOrigin);
+		w.putVector(c->visitsDyn);
+		w.putMatrix(c->jourSuiv);
+		w.putMatrix(c->demandPatDay);
+		w.putVector(c->ordreProximiteDepots);
+		w.putVector(c->sommetsVoisins);
+		w.putVector(c->sommetsVoisinsAvant);
+	}
+
+	// The header is completed once the size and content of the data are known
+	header.sizeData = (uint64_t)(buffer.size() - sizeof(CacheHeader)) ;
+	header.hashData = hash(&buffer[sizeof(CacheHeader)], (size_t)header.sizeData);
+	memcpy(&buffer[0], &header, sizeof(CacheHeader));
+}
+
+bool InstanceCache::deserialize (Params * params, uint64_t hashInstance, uint64_t sizeInstance, const char * data, size_t size)
+{
+	// Checking that the data corresponds to this instance and this program
+	CacheHeader header ;
+	CacheHeader expected ;
+	if (size < sizeof(CacheHeader)) return false ;
+	memcpy(&header, data, sizeof(CacheHeader));
+	fillHeader(expected, params, hashInstance, sizeInstance);
+	expected.sizeData = header.sizeData ;
+	expected.hashData = header.hashData ;
+	if (memcmp(&header, &expected, sizeof(CacheHeader)) != 0) return false ;
+	if (header.sizeData != (uint64_t)(size - sizeof(CacheHeader))) return false ;
+	if (header.hashData != hash(data + sizeof(CacheHeader), (size_t)header.sizeData)) return false ;
+
+	BinaryReader r(data + sizeof(CacheHeader), (size_t)header.sizeData);
+
+	// Problem characteristics
+	r.get(params->multiDepot);
+	r.get(params->periodique);
+	r.get(params->isTurnPenalties);
+	r.get(params->ar_NodesRequired);
+	r.get(params->ar_NodesNonRequired);
+	r.get(params->ar_EdgesRequired);
+	r.get(params->ar_EdgesNonRequired);
+	r.get(params->ar_ArcsRequired);
+	r.get(params->ar_ArcsNonRequired);
+	r.get(params->ar_nbArcsDistance);
+	r.get(params->ar_nbTurns);
+	r.get(params->ar_maxNbModes);
+	r.get(params->ar_tempIndexDepot);
+	r.get(params->parsing_courNbArcs);
+	r.get(params->nbClients);
+	r.get(params->nbTotalServices);
+	r.get(params->totalDemand);
+	r.get(params->nbDays);
+	r.get(params->ancienNbDays);
+	r.get(params->nbDepots);
+	r.get(params->nbVehiculesFichier);
+	r.get(params->vehicleCapacity);
+	if (!r.ok || params->nbClients < 0 || params->nbDepots < 1) return false ;
+	int nbNoeuds = params->nbClients + params->nbDepots ;
+	if (!r.has((uint64_t)nbNoeuds*nbNoeuds)) return false ;
+
+	// Distances
+	r.getMatrix(params->ar_distanceNodes);
+	r.getVector(params->ar_Arcs);
+	r.getMatrix(params->ar_distanceArcs);
+	params->timeCost = new double * [nbNoeuds];
+	for (int i=0 ; i < nbNoeuds ; i++)
+	{
+		params->timeCost[i] = new double [nbNoeuds];
+		for (int j=0 ; j < nbNoeuds ; j++)
+			r.get(params->timeCost[i][j]);
+	}
+	char correle = 0 ;
+	params->isCorrelated = vector < vector <bool> > (nbNoeuds, vector <bool> (nbNoeuds));
+	for (int i=0 ; i < nbNoeuds ; i++)
+	{
+		for (int j=0 ; j < nbNoeuds ; j++)
+		{
+			r.get(correle);
+			params->isCorrelated[i][j] = (correle != 0) ;
+		}
+	}
+
+	// Services
+	int nodeType = 0 ;
+	vector <int> modes ;
+	params->cli = new Client [nbNoeuds] ;
+	for (int i=0 ; i < nbNoeuds && r.ok ; i++)
+	{
+		Client * c = &params->cli[i] ;
+		r.get(c->custNum);
+		r.get(c->coord);
+		r.get(c->serviceDuration);
+		r.get(c->demand);
+		r.get(c->freq);
+		r.get(c->codeTravail);
+		r.get(nodeType);
+		c->ar_nodeType = (ClientType)nodeType ;
+		r.get(c->ar_nodesExtr0);
+		r.get(c->ar_nodesExtr1);
+		r.get(c->ar_serviceCost01);
+		r.get(c->ar_serviceCost10);
+		r.get(c->ar_nbModes);
+		r.getVector(modes);
+		c->ar_Modes.clear();
+		for (int k=0 ; k < (int)modes.size() && r.ok ; k++)
+		{
+			if (modes[k] < 0 || modes[k] >= (int)params->ar_Arcs.size()) r.ok = false ;
+			else c->ar_Modes.push_back(&params->ar_Arcs[modes[k]]);
+		}
+		r.getVector(c->visits);
+		r.getVector(c->visitsOrigin);
+		r.getVector(c->visitsDyn);
+		r.getMatrix(c->jourSuiv);
+		r.getMatrix(c->demandPatDay);
+		r.getVector(c->ordreProximiteDepots);
+		r.getVector(c->sommetsVoisins);
+		r.getVector(c->sommetsVoisinsAvant);
+	}
+
+	if (!r.ok || r.cour != r.fin)
+	{
+		// Inconsistent content, the data structures are released and will be rebuilt from the instance
+		for (int i=0 ; i < nbNoeuds ; i++)
+			delete [] params->timeCost[i] ;
+		delete [] params->timeCost ;
+		params->timeCost = NULL ;
+		delete [] params->cli ;
+		params->cli = NULL ;
+		params->ar_distanceNodes.clear();
+		params->ar_Arcs.clear();
+		params->ar_distanceArcs.clear();
+		params->isCorrelated.clear();
+		return false ;
+	}
+
+	// The table of arcs between pairs of nodes only contains pointers, it is rebuilt
+	if (!params->ar_Arcs.empty())
+	{
+		int nbNodes = params->ar_NodesNonRequired + params->ar_NodesRequired + 1 ;
+		params->ar_correspondingArc = vector < vector <Arc*> > (nbNodes, vector <Arc*> (nbNodes, (Arc*)NULL));
+		for (int k=1 ; k < params->parsing_courNbArcs && k < (int)params->ar_Arcs.size() ; k++)
+			params->ar_correspondingArc[params->ar_Arcs[k].nodeBegin][params->ar_Arcs[k].nodeEnd] = &params->ar_Arcs[k] ;
+	}
+
+	return true ;
+}
+
+bool InstanceCache::save (Params * params, uint64_t hashInstance, uint64_t sizeInstance, string nomFichier)
+{
+	vector <char> buffer ;
+	serialize(params, hashInstance, sizeInstance, buffer);
+	return writeFileAtomically(nomFichier, buffer);
+}
+
+bool InstanceCache::load (Params * params, uint64_t hashInstance, uint64_t sizeInstance, string nomFichier)
+{
+	InstanceReader fichierCache ;
+	if (!fichierCache.open(nomFichier)) return false ;
+	bool isLoaded = deserialize(params, hashInstance, sizeInstance, fichierCache.data(), fichierCache.size());
+	fichierCache.close();
+	return isLoaded ;
+}
+
+list < pair < string, vector <char> > > InstanceCache::memoire ;
+
+int InstanceCache::capaciteMemoire = 0 ;
+
+int InstanceCache::sortieMemoire = -1 ;
+
+// Writes exactly "size" bytes on a descriptor
+static bool ecrireDonnees (int fd, const char * data, size_t size)
+{
+	while (size > 0)
+	{
+		ssize_t n = write(fd, data, size);
+		if (n < 0 && errno == EINTR) continue ;
+		if (n <= 0) return false ;
+		data += n ;
+		size -= n ;
+	}
+	return true ;
+}
+
+// Reports a use (empty data) or an addition of the in-memory cache on sortieMemoire
+// A failure only means that the daemon will not keep this instance, the descriptor is then abandoned
+static void rapporter (const string & nomFichier, const vector <char> & data)
+{
+	uint64_t tailleNom = nomFichier.size() ;
+	uint64_t tailleDonnees = data.size() ;
+	if (!ecrireDonnees(InstanceCache::sortieMemoire, (const char *)&tailleNom, sizeof(uint64_t))
+		|| !ecrireDonnees(InstanceCache::sortieMemoire, nomFichier.data(), nomFichier.size())
+		|| !ecrireDonnees(InstanceCache::sortieMemoire, (const char *)&tailleDonnees, sizeof(uint64_t))
+		|| !ecrireDonnees(InstanceCache::sortieMemoire, data.data(), data.size()))
+	{
+		close(InstanceCache::sortieMemoire);
+		InstanceCache::sortieMemoire = -1 ;
+	}
+}
+
+void InstanceCache::saveMemory (Params * params, uint64_t hashInstance, uint64_t sizeInstance, string nomFichier)
+{
+	if (capaciteMemoire <= 0) return ;
+	memoire.push_front(pair < string, vector <char> > (nomFichier, vector <char> ()));
+	serialize(params, hashInstance, sizeInstance, memoire.front().second);
+	if (sortieMemoire >= 0) rapporter(nomFichier, memoire.front().second);
+	while ((int)memoire.size() > capaciteMemoire)
+		memoire.pop_back();
+}
+
+bool InstanceCache::loadMemory (Params * params, uint64_t hashInstance, uint64_t sizeInstance, string nomFichier)
+{
+	for (list < pair < string, vector <char> > >::iterator it = memoire.begin() ; it != memoire.end() ; ++it)
+	{
+		if (it->first == nomFichier)
+		{
+			// moving the instance to the front of the list (most recently used)
+			memoire.splice(memoire.begin(), memoire, it);
+			if (sortieMemoire >= 0) rapporter(nomFichier, vector <char> ());
+			return deserialize(params, hashInstance, sizeInstance, memoire.front().second.data(), memoire.front().second.size());
+		}
+	}
+	return false ;
+}
+
+size_t InstanceCache::applyReports (const char * data, size_t size)
+{
+	size_t position = 0 ;
+	uint64_t tailleNom, tailleDonnees ;
+	while (true)
+	{
+		// Checking that the next report is complete
+		if (size - position < sizeof(uint64_t)) return position ;
+		memcpy(&tailleNom, data + position, sizeof(uint64_t));
+		if (size - position - sizeof(uint64_t) < tailleNom + sizeof(uint64_t)) return position ;
+		memcpy(&tailleDonnees, data + position + sizeof(uint64_t) + tailleNom, sizeof(uint64_t));
+		size_t tailleRapport = 2*sizeof(uint64_t) + tailleNom + tailleDonnees ;
+		if (size - position < tailleRapport) return position ;
+
+		string nomFichier (data + position + sizeof(uint64_t), tailleNom) ;
+		const char * donnees = data + position + 2*sizeof(uint64_t) + tailleNom ;
+		position += tailleRapport ;
+
+		// Moving the instance to the front of the list (most recently used), with its new data if the job has preprocessed it
+		list < pair < string, vector <char> > >::iterator it = memoire.begin() ;
+		while (it != memoire.end() && it->first != nomFichier) ++it ;
+		if (it != memoire.end())
+			memoire.splice(memoire.begin(), memoire, it);
+		else if (tailleDonnees > 0)
+			memoire.push_front(pair < string, vector <char> > (nomFichier, vector <char> ()));
+		else
+			continue ;
+		if (tailleDonnees > 0)
+			memoire.front().second.assign(donnees, donnees + tailleDonnees);
+		while ((int)memoire.size() > capaciteMemoire)
+			memoire.pop_back();
+	}
+}
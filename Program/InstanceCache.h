@@ -0,0 +1,102 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef INSTANCE_CACHE_H
+#define INSTANCE_CACHE_H
+
+#include <string>
+#include <vector>
+#include <list>
+#include <stdint.h>
+using namespace std ;
+
+class Params ;
+
+// Version of the binary format, to be increased each time the content of Params or Client changes
+#define CACHE_VERSION 1
+
+// Header of a cache file, used to detect stale or foreign files
+struct CacheHeader {
+	char magic [8] ; // "HGSCARP"
+	int version ; // CACHE_VERSION
+	int turnPenalties ; // 1 if the program was compiled with the flag TURN_PENALTIES
+	int type ; // problem type
+	int nbDepots ; // number of depots
+	int granularity ; // size of the lists of close services
+	int sizeofDouble ; // sanity checks on the binary representation
+	int sizeofPattern ;
+	int sizeofArc ;
+	uint64_t hashInstance ; // hash of the bytes of the instance file
+	uint64_t sizeInstance ; // size of the instance file
+	uint64_t sizeData ; // size of the data following the header
+	uint64_t hashData ; // hash of the data following the header (detects truncated or corrupted files)
+};
+
+// On-disk cache of the preprocessed instance data
+// It contains all the data structures of Params and Client which result from the parsing and the pre-processing
+// (distance matrices, lists of close services, pattern tables), such that a later run on the same instance
+// only needs to map the file in memory and copy the data.
+// The fleet size is not part of the cache, the vehicles are rebuilt at each run from the instance and commandline values.
+// The same data can also be kept in memory, which is used by the daemon (see Daemon.h) to serve several runs from one process.
+// The jobs of the daemon preprocess the instances themselves, and send their new in-memory entries to the daemon through a pipe.
+class InstanceCache
+{
+
+public:
+
+	// in-memory cache, pairs (name of the cache file, serialized data), from the most to the least recently used
+	static list < pair < string, vector <char> > > memoire ;
+
+	// maximum number of instances kept in memory (0 : no in-memory cache)
+	static int capaciteMemoire ;
+
+	// descriptor on which the uses and additions of the in-memory cache are reported (job of the daemon), -1 if they are not reported
+	// Format of a report : size of the name, name, size of the data (0 if the instance has only been used), data
+	static int sortieMemoire ;
+
+	// hash (FNV-1a 64 bits) of a sequence of bytes
+	static uint64_t hash (const char * data, size_t size);
+
+	// name of the cache file associated to an instance, in a given directory
+	static string fileName (string directory, uint64_t hashInstance, int type, int nbDepots);
+
+	// serializes the preprocessed data of the Params into a buffer (header included)
+	static void serialize (Params * params, uint64_t hashInstance, uint64_t sizeInstance, vector <char> & buffer);
+
+	// fills the Params from a buffer, returns false if the buffer does not match the instance and program
+	// (in this case the Params must be filled again from the instance file)
+	static bool deserialize (Params * params, uint64_t hashInstance, uint64_t sizeInstance, const char * data, size_t size);
+
+	// writes the cache file (through a temporary file and a rename, such that concurrent runs never read a partial file)
+	// returns false in case of failure, which is not an error for the search
+	static bool save (Params * params, uint64_t hashInstance, uint64_t sizeInstance, string nomFichier);
+
+	// maps the cache file in memory and fills the Params, returns false if the file does not exist or does not match
+	static bool load (Params * params, uint64_t hashInstance, uint64_t sizeInstance, string nomFichier);
+
+	// stores the data in the in-memory cache, under the name of its cache file (the least recently used instance is dropped if the cache is full)
+	static void saveMemory (Params * params, uint64_t hashInstance, uint64_t sizeInstance, string nomFichier);
+
+	// fills the Params from the in-memory cache, returns false if the instance is not there
+	static bool loadMemory (Params * params, uint64_t hashInstance, uint64_t sizeInstance, string nomFichier);
+
+	// applies to the in-memory cache the complete reports found in a buffer (received from a job), returns the number of bytes used
+	static size_t applyReports (const char * data, size_t size);
+};
+
+#endif
@@ -0,0 +1,277 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include "InstanceReader.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <iterator>
+
+bool InstanceReader::isReference = false ;
+
+InstanceReader::InstanceReader()
+{
+	debut = NULL ;
+	fin = NULL ;
+	cour = NULL ;
+	tailleMapping = 0 ;
+	isOpen = false ;
+	flux = NULL ;
+}
+
+InstanceReader::~InstanceReader()
+{
+	close();
+}
+
+bool InstanceReader::open (string nomFichier)
+{
+	struct stat infos ;
+	close();
+
+	if (isReference)
+	{
+		// Reference mode, the content is kept aside for the hash of the instance, and the parsing goes through the stream
+		ifstream entree(nomFichier.c_str(), ios::binary);
+		if (!entree.is_open())
+			return false ;
+		contenu.assign(istreambuf_iterator<char>(entree), istreambuf_iterator<char>());
+		flux = new ifstream(nomFichier.c_str());
+		debut = contenu.data() ;
+		fin = debut + contenu.size() ;
+		cour = debut ;
+		isOpen = true ;
+		return true ;
+	}
+
+	int fd = ::open(nomFichier.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false ;
+
+	if (fstat(fd, &infos) != 0 || !S_ISREG(infos.st_mode))
+	{
+		::close(fd);
+		return false ;
+	}
+
+	// an empty file can not be mapped, but is a valid (empty) input
+	tailleMapping = (size_t)infos.st_size ;
+	if (tailleMapping > 0)
+	{
+		void * mapping = mmap(NULL, tailleMapping, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping == MAP_FAILED)
+		{
+			::close(fd);
+			tailleMapping = 0 ;
+			return false ;
+		}
+		madvise(mapping, tailleMapping, MADV_SEQUENTIAL);
+		debut = (const char *)mapping ;
+	}
+	else
+		debut = "" ;
+
+	// the mapping stays valid after closing the descriptor
+	::close(fd);
+	fin = debut + tailleMapping ;
+	cour = debut ;
+	isOpen = true ;
+	return true ;
+}
+
+void InstanceReader::close ()
+{
+	if (tailleMapping > 0)
+		munmap((void *)debut, tailleMapping);
+	delete flux ;
+	flux = NULL ;
+	contenu.clear();
+	debut = NULL ;
+	fin = NULL ;
+	cour = NULL ;
+	tailleMapping = 0 ;
+	isOpen = false ;
+}
+
+InstanceReader & InstanceReader::operator >> (int & value)
+{
+	long long result = 0 ;
+	bool negative = false ;
+	if (flux != NULL)
+	{
+		*flux >> value ;
+		return *this ;
+	}
+	skipBlanks();
+	if (cour < fin && (*cour == '-' || *cour == '+'))
+	{
+		negative = (*cour == '-') ;
+		cour ++ ;
+	}
+
+	// as for the streams, the value is set to 0 if no digit can be read
+	while (cour < fin && *cour >= '0' && *cour <= '9')
+	{
+		if (result < 10000000000LL) result = 10*result + (*cour - '0') ;
+		cour ++ ;
+	}
+	if (negative) result = -result ;
+	if (result > 2147483647LL) result = 2147483647LL ;
+	if (result < -2147483648LL) result = -2147483648LL ;
+	value = (int)result ;
+	return *this ;
+}
+
+InstanceReader & InstanceReader::operator >> (double & value)
+{
+	char buffer[64] ;
+	const char * tokenStart ;
+	bool hasDigits = false ;
+	bool isInteger = true ;
+	if (flux != NULL)
+	{
+		*flux >> value ;
+		return *this ;
+	}
+	skipBlanks();
+	tokenStart = cour ;
+
+	// Collecting the characters of the number, with the same grammar as the streams : [sign] digits [. digits] [e [sign] digits]
+	if (cour < fin && (*cour == '-' || *cour == '+')) cour ++ ;
+	while (cour < fin && *cour >= '0' && *cour <= '9') { cour ++ ; hasDigits = true ; }
+	if (cour < fin && *cour == '.')
+	{
+		isInteger = false ;
+		cour ++ ;
+		while (cour < fin && *cour >= '0' && *cour <= '9') { cour ++ ; hasDigits = true ; }
+	}
+	if (hasDigits && cour < fin && (*cour == 'e' || *cour == 'E'))
+	{
+		isInteger = false ;
+		cour ++ ;
+		if (cour < fin && (*cour == '-' || *cour == '+')) cour ++ ;
+		while (cour < fin && *cour >= '0' && *cour <= '9') cour ++ ;
+	}
+
+	size_t length = (size_t)(cour - tokenStart) ;
+	if (!hasDigits)
+		value = 0 ;
+	else if (isInteger && length <= 15)
+	{
+		// Fast path for the integer values, the conversion is exact below 2^53
+		long long result = 0 ;
+		const char * c = tokenStart ;
+		bool negative = (*c == '-') ;
+		if (*c == '-' || *c == '+') c ++ ;
+		for ( ; c < cour ; c++) result = 10*result + (*c - '0') ;
+		value = negative ? -(double)result : (double)result ;
+	}
+	else if (length < sizeof(buffer))
+	{
+		// Otherwise we rely on strtod, as the streams do (the mapped data is not null-terminated, hence the copy)
+		memcpy(buffer, tokenStart, length);
+		buffer[length] = '\0' ;
+		value = strtod(buffer, NULL);
+	}
+	else
+		value = strtod(string(tokenStart, length).c_str(), NULL);
+
+	return *this ;
+}
+
+InstanceReader & InstanceReader::operator >> (bool & value)
+{
+	int temp ;
+	if (flux != NULL)
+	{
+		*flux >> value ;
+		return *this ;
+	}
+	*this >> temp ;
+	value = (temp != 0) ;
+	return *this ;
+}
+
+void InstanceReader::skipWord ()
+{
+	if (flux != NULL)
+	{
+		string mot ;
+		*flux >> mot ;
+		return ;
+	}
+	skipBlanks();
+	while (cour < fin && !isBlank(*cour)) cour++ ;
+}
+
+int InstanceReader::readPrefixedInt ()
+{
+	int value = 0 ;
+	bool negative = false ;
+	if (flux != NULL)
+	{
+		string mot ;
+		*flux >> mot ;
+		return (mot.size() > 0) ? atoi(mot.substr(1,mot.size()).c_str()) : 0 ;
+	}
+	skipBlanks();
+	const char * tokenEnd = cour ;
+	while (tokenEnd < fin && !isBlank(*tokenEnd)) tokenEnd++ ;
+
+	// atoi on the word without its first character
+	if (cour < tokenEnd) cour ++ ;
+	if (cour < tokenEnd && (*cour == '-' || *cour == '+'))
+	{
+		negative = (*cour == '-') ;
+		cour ++ ;
+	}
+	while (cour < tokenEnd && *cour >= '0' && *cour <= '9')
+	{
+		value = 10*value + (*cour - '0') ;
+		cour ++ ;
+	}
+	cour = tokenEnd ;
+	return negative ? -value : value ;
+}
+
+void InstanceReader::skipLine ()
+{
+	if (flux != NULL)
+	{
+		string ligne ;
+		getline(*flux, ligne);
+		return ;
+	}
+	while (cour < fin && *cour != '\n') cour++ ;
+	if (cour < fin) cour++ ;
+}
+
+void InstanceReader::skipUntil (char delimiter)
+{
+	if (flux != NULL)
+	{
+		char myChars [1000] ;
+		flux->getline(myChars,1000,delimiter);
+		return ;
+	}
+	while (cour < fin && *cour != delimiter) cour++ ;
+	if (cour < fin) cour++ ;
+}
@@ -0,0 +1,101 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef INSTANCE_READER_H
+#define INSTANCE_READER_H
+
+#include <string>
+#include <fstream>
+using namespace std ;
+
+// Read-only tokenizer working directly on the bytes of the instance file (mapped in memory)
+// Its operations reproduce the semantics of the ifstream operations previously used by the parsers,
+// (operator >> on int, double and bool, reading and discarding a word, getline with or without delimiter)
+// without creating any string and without the locale and sentry overhead of the streams
+// The original stream operations are kept as a reference mode, used to check the tokenizer on all instances (see parsetest.cpp)
+class InstanceReader
+{
+
+private:
+
+	// beginning, end, and current position in the data
+	const char * debut ;
+	const char * fin ;
+	const char * cour ;
+
+	// size of the mapping (0 if the data is not mapped)
+	size_t tailleMapping ;
+
+	// says if the reader is ready to be used
+	bool isOpen ;
+
+	// reference mode : the file is read through an ifstream with the original stream operations (NULL when the file is mapped)
+	ifstream * flux ;
+
+	// content of the file in reference mode, only used by data() and size()
+	string contenu ;
+
+	// same definition of a blank character as the streams in the "C" locale
+	static bool isBlank (char c) { return (c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r') ; }
+
+public:
+
+	// says if the files are opened in reference mode instead of being mapped (only set by the test of the tokenizer)
+	static bool isReference ;
+
+	// maps a file in memory, returns false if it cannot be opened
+	bool open (string nomFichier);
+
+	// unmaps the file
+	void close ();
+
+	// says if the file is open
+	bool is_open () { return isOpen ; }
+
+	// gives access to the raw content of the file
+	const char * data () { return debut ; }
+	size_t size () { return (size_t)(fin - debut) ; }
+
+	// skips the blank characters
+	void skipBlanks () { if (flux != NULL) *flux >> ws ; else while (cour < fin && isBlank(*cour)) cour++ ; }
+
+	// equivalent to "fichier >> value" (skips blanks, and reads the longest prefix which forms a number)
+	InstanceReader & operator >> (int & value) ;
+	InstanceReader & operator >> (double & value) ;
+	InstanceReader & operator >> (bool & value) ;
+
+	// equivalent to "fichier >> myString", with the word being discarded
+	void skipWord () ;
+
+	// equivalent to reading a word such as "N12" and taking atoi of the word without its first character
+	int readPrefixedInt () ;
+
+	// equivalent to "getline(fichier, myString)", with the line being discarded
+	void skipLine () ;
+
+	// equivalent to "fichier.getline(myChars, size, delimiter)", with the characters being discarded
+	void skipUntil (char delimiter) ;
+
+	// Constructor
+	InstanceReader();
+
+	// Destructor
+	~InstanceReader();
+};
+
+#endif
@@ -0,0 +1,326 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include "IslandExchange.h"
+#include "Params.h"
+#include "Individu.h"
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+#include <thread>
+#include <chrono>
+
+// identifies a segment whose header is complete ("HGSISLE" followed by the version of the layout)
+static const uint64_t ISLAND_MAGIC = 0x48475349534c4502ULL ;
+
+// maximum waiting time (in seconds) for a slot held by another process, before the publication is abandoned
+static const double ISLAND_ATTENTE_MAX = 0.1 ;
+
+IslandSlot * IslandExchange::getSlot (uint64_t numero)
+{
+	return (IslandSlot *)(segment + sizeof(IslandHeader) + (numero % entete->nbSlots) * tailleSlot) ;
+}
+
+bool IslandExchange::isVivant (int pid)
+{
+	// a process of another user would answer EPERM, the segments are only open to their owner anyway
+	return pid > 0 && (kill(pid, 0) == 0 || errno != ESRCH) ;
+}
+
+void IslandExchange::publier (Individu * indiv, double cost)
+{
+	uint64_t sequence ;
+	uint64_t numero = entete->nbPublications.fetch_add(1) ;
+	IslandSlot * slot = getSlot(numero) ;
+	int * donnees = (int *)(slot + 1) ;
+	int ecrivain ;
+	bool isExpire ;
+	chrono::steady_clock::time_point debut = chrono::steady_clock::now() ;
+
+	// Taking the slot : its sequence becomes odd (a process which would still be writing in it, one round of the ring before, finishes first)
+	// The slot of a process which died while writing it is taken over, its sequence staying odd, as well as a slot still without writer
+	// after ISLAND_ATTENTE_MAX (a process which died just after taking it). A slot held longer by a live process is left to it, and this publication is abandoned.
+	sequence = slot->sequence.load(memory_order_relaxed) ;
+	while (true)
+	{
+		if (!(sequence & 1))
+		{
+			if (slot->sequence.compare_exchange_weak(sequence, sequence + 1, memory_order_acquire, memory_order_relaxed))
+			{
+				sequence ++ ;
+				break ;
+			}
+			continue ;
+		}
+		ecrivain = slot->ecrivain.load(memory_order_relaxed) ;
+		isExpire = chrono::duration <double> (chrono::steady_clock::now() - debut).count() > ISLAND_ATTENTE_MAX ;
+		if ((ecrivain != 0 && !isVivant(ecrivain)) || (ecrivain == 0 && isExpire))
+		{
+			if (slot->sequence.compare_exchange_strong(sequence, sequence + 2, memory_order_acquire, memory_order_relaxed))
+			{
+				sequence += 2 ;
+				break ;
+			}
+			continue ;
+		}
+		if (isExpire)
+			return ;
+		this_thread::yield();
+		sequence = slot->sequence.load(memory_order_relaxed) ;
+	}
+	slot->ecrivain.store(identifiant, memory_order_relaxed) ;
+	atomic_thread_fence(memory_order_release);
+
+	slot->numero = numero ;
+	slot->source = identifiant ;
+	slot->cost = cost ;
+	for (int k=1 ; k <= entete->nbDays ; k++)
+		donnees[k-1] = (int)indiv->chromT[k].size() ;
+	donnees += entete->nbDays ;
+	for (int k=1 ; k <= entete->nbDays ; k++)
+	{
+		if (!indiv->chromT[k].empty()) memcpy(donnees, &indiv->chromT[k][0], indiv->chromT[k].size() * sizeof(int));
+		donnees += indiv->chromT[k].size() ;
+	}
+	donnees = (int *)(slot + 1) + entete->nbDays + entete->nbVisites ;
+	for (int i=0 ; i < entete->nbServices ; i++)
+	{
+		donnees[2*i] = indiv->chromP[i].pat ;
+		donnees[2*i+1] = indiv->chromP[i].dep ;
+	}
+
+	// Releasing the slot : the sequence becomes even again (unless the slot has been taken over in the meantime)
+	slot->ecrivain.store(0, memory_order_relaxed) ;
+	slot->sequence.compare_exchange_strong(sequence, sequence + 1, memory_order_release, memory_order_relaxed) ;
+}
+
+bool IslandExchange::lireMigrant (Individu * indiv, double & cost)
+{
+	uint64_t sequence, numero ;
+	uint64_t nbPublications = entete->nbPublications.load(memory_order_acquire) ;
+	int nbDays = entete->nbDays ;
+	int nbVisites, taille ;
+	int source ;
+	int ecrivain ;
+	bool isValide ;
+	IslandSlot * slot ;
+	const int * donnees ;
+
+	// The publications which have been overwritten in the ring are lost
+	if (nbPublications > (uint64_t)entete->nbSlots && prochainNumero < nbPublications - entete->nbSlots)
+		prochainNumero = nbPublications - entete->nbSlots ;
+
+	while (prochainNumero < nbPublications)
+	{
+		numero = prochainNumero ;
+		slot = getSlot(numero) ;
+
+		// The slot is still being written (or not written yet) : the migrant will be read at the next call
+		// (a slot left by a process which died while writing it is skipped)
+		sequence = slot->sequence.load(memory_order_acquire) ;
+		if (sequence & 1)
+		{
+			ecrivain = slot->ecrivain.load(memory_order_relaxed) ;
+			if (ecrivain == 0 || isVivant(ecrivain))
+				return false ;
+			prochainNumero ++ ;
+			continue ;
+		}
+		if (slot->numero != numero)
+			return false ;
+		prochainNumero ++ ;
+
+		source = slot->source ;
+		cost = slot->cost ;
+		if (source == identifiant)
+			continue ;
+
+		// Copying the chromosomes, then checking that the slot has not been modified during the copy
+		donnees = (const int *)(slot + 1) ;
+		nbVisites = 0 ;
+		isValide = true ;
+		for (int k=1 ; k <= nbDays && isValide ; k++)
+		{
+			taille = donnees[k-1] ;
+			if (taille < 0 || nbVisites + taille > entete->nbVisites) 
+				isValide = false ;
+			else
+			{
+				indiv->chromT[k].resize(taille);
+				if (taille > 0) memcpy(&indiv->chromT[k][0], &donnees[nbDays + nbVisites], taille * sizeof(int));
+				nbVisites += taille ;
+			}
+		}
+		donnees += nbDays + entete->nbVisites ;
+		for (int i=0 ; i < entete->nbServices && isValide ; i++)
+		{
+			indiv->chromP[i].pat = donnees[2*i] ;
+			indiv->chromP[i].dep = donnees[2*i+1] ;
+		}
+		atomic_thread_fence(memory_order_acquire);
+		if (!isValide || slot->sequence.load(memory_order_relaxed) != sequence)
+			continue ;
+		return true ;
+	}
+	return false ;
+}
+
+IslandExchange::IslandExchange (string nomSegment, Params * params, int nbSlots) : nomSegment(nomSegment)
+{
+	struct stat infos ;
+	int nbDays = params->nbDays ;
+	int nbServices = params->nbClients + params->nbDepots ;
+	int nbVisites = params->nbTotalServices ;
+	int entree = -1 ;
+	bool isVide = true ;
+
+	// The names of the POSIX shared-memory segments start with a slash
+	if (nomSegment.empty() || nomSegment[0] != '/')
+		this->nomSegment = "/" + nomSegment ;
+	nomSegment = this->nomSegment ;
+
+	// Size of the segment, each slot is aligned on 8 bytes
+	tailleSlot = sizeof(IslandSlot) + (size_t)(nbDays + nbVisites + 2*nbServices) * sizeof(int) ;
+	tailleSlot = (tailleSlot + 7) / 8 * 8 ;
+	tailleSegment = sizeof(IslandHeader) + (size_t)nbSlots * tailleSlot ;
+	prochainNumero = 0 ;
+	identifiant = (int)getpid() ;
+	segment = NULL ;
+
+	// Opening the segment (created empty if needed) and taking its lock : the attachment of this process is exclusive with
+	// the initialization of the segment and with the detachment of the other processes
+	// If the last process has removed the segment between its opening and the lock, the segment is opened again
+	while (true)
+	{
+		descripteur = shm_open(nomSegment.c_str(), O_CREAT | O_RDWR, 0600) ;
+		if (descripteur < 0)
+			throw string("Impossible to open the shared-memory segment of the islands " + nomSegment + " : " + strerror(errno));
+		if (flock(descripteur, LOCK_EX) != 0 || fstat(descripteur, &infos) != 0)
+		{
+			close(descripteur);
+			throw string("Impossible to lock the shared-memory segment of the islands " + nomSegment + " : " + strerror(errno));
+		}
+		if (infos.st_nlink > 0)
+			break ;
+		close(descripteur);
+	}
+
+	// A segment is used by other processes if its header is complete and one of its processes is still running
+	// (otherwise it is new, or it has been left by processes which died without detaching, and it is reinitialized)
+	if (infos.st_size >= (off_t)sizeof(IslandHeader))
+	{
+		void * mapping = mmap(NULL, (size_t)infos.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, descripteur, 0) ;
+		if (mapping == MAP_FAILED)
+		{
+			close(descripteur);
+			throw string("Impossible to map the shared-memory segment of the islands " + nomSegment);
+		}
+		segment = (char *)mapping ;
+		entete = (IslandHeader *)segment ;
+		if (entete->magic.load(memory_order_acquire) == ISLAND_MAGIC)
+			for (int i=0 ; i < ISLAND_MAX_PROCESSUS ; i++)
+				if (isVivant(entete->processus[i])) isVide = false ;
+		if (isVide) munmap(segment, (size_t)infos.st_size);
+		else tailleSegment = (size_t)infos.st_size ;
+	}
+
+	if (isVide)
+		initialiser(params, nbSlots);
+	else if (entete->hashInstance != params->hashInstance || entete->type != params->type || entete->nbDepotsProches != params->nbDepotsProches
+		|| entete->nbServices != nbServices || entete->nbDays != nbDays || entete->nbVisites != nbVisites 
+		|| tailleSegment != sizeof(IslandHeader) + (size_t)entete->nbSlots * tailleSlot)
+	{
+		munmap(segment, tailleSegment);
+		close(descripteur);
+		throw string("The shared-memory segment of the islands " + nomSegment + " does not correspond to this instance and problem type");
+	}
+
+	// Registering this process, in a free entry or in the entry of a process which has died
+	for (int i=0 ; i < ISLAND_MAX_PROCESSUS && entree < 0 ; i++)
+		if (!isVivant(entete->processus[i])) entree = i ;
+	if (entree < 0)
+	{
+		munmap(segment, tailleSegment);
+		close(descripteur);
+		throw string("Too many processes attached to the shared-memory segment of the islands " + nomSegment);
+	}
+	entete->processus[entree] = identifiant ;
+	flock(descripteur, LOCK_UN);
+
+	// The publications made before the arrival of this process are also read
+	uint64_t nbPublications = entete->nbPublications.load(memory_order_acquire) ;
+	prochainNumero = (nbPublications > (uint64_t)entete->nbSlots) ? nbPublications - entete->nbSlots : 0 ;
+}
+
+void IslandExchange::initialiser (Params * params, int nbSlots)
+{
+	// Resizing the segment to zero then to its size fills it with zeros : all slots are free, with an even sequence
+	if (ftruncate(descripteur, 0) != 0 || ftruncate(descripteur, tailleSegment) != 0)
+	{
+		close(descripteur);
+		throw string("Impossible to size the shared-memory segment of the islands " + nomSegment);
+	}
+	void * mapping = mmap(NULL, tailleSegment, PROT_READ | PROT_WRITE, MAP_SHARED, descripteur, 0) ;
+	if (mapping == MAP_FAILED)
+	{
+		close(descripteur);
+		throw string("Impossible to map the shared-memory segment of the islands " + nomSegment);
+	}
+	segment = (char *)mapping ;
+	entete = (IslandHeader *)segment ;
+
+	entete->hashInstance = params->hashInstance ;
+	entete->type = params->type ;
+	entete->nbDepotsProches = params->nbDepotsProches ;
+	entete->nbServices = params->nbClients + params->nbDepots ;
+	entete->nbDays = params->nbDays ;
+	entete->nbVisites = params->nbTotalServices ;
+	entete->nbSlots = nbSlots ;
+	entete->nbPublications.store(0) ;
+	entete->magic.store(ISLAND_MAGIC, memory_order_release) ;
+}
+
+IslandExchange::~IslandExchange ()
+{
+	struct stat infos ;
+	bool isRetire = false ;
+	bool isDernier = true ;
+
+	// Detaching this process under the lock of the segment, the segment is removed if no other process is still running
+	// (the processes which died without detaching are ignored)
+	flock(descripteur, LOCK_EX);
+	for (int i=0 ; i < ISLAND_MAX_PROCESSUS ; i++)
+	{
+		if (!isRetire && entete->processus[i] == identifiant)
+		{
+			entete->processus[i] = 0 ;
+			isRetire = true ;
+		}
+		else if (isVivant(entete->processus[i]))
+			isDernier = false ;
+	}
+	if (isDernier && fstat(descripteur, &infos) == 0 && infos.st_nlink > 0)
+		shm_unlink(nomSegment.c_str());
+	munmap(segment, tailleSegment);
+	close(descripteur);
+}
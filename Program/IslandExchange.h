@@ -0,0 +1,131 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef ISLAND_EXCHANGE_H
+#define ISLAND_EXCHANGE_H
+
+#include <string>
+#include <atomic>
+#include <stdint.h>
+using namespace std ;
+
+class Params ;
+class Individu ;
+
+// maximum number of processes attached to a segment
+#define ISLAND_MAX_PROCESSUS 64
+
+// Header of the shared-memory segment of the islands
+struct IslandHeader
+{
+	// set last by the process which initializes the segment, once the header is complete
+	atomic <uint64_t> magic ;
+
+	// identification of the instance and dimensions of the chromosomes
+	uint64_t hashInstance ;
+	int type ;
+	int nbDepotsProches ;
+	int nbServices ;
+	int nbDays ;
+	int nbVisites ;
+	int nbSlots ;
+
+	// number of individuals published since the creation of the segment
+	atomic <uint64_t> nbPublications ;
+
+	// identifiers of the processes attached to the segment (0 for a free entry), only accessed under the lock of the segment
+	// the last live process removes the segment, and a segment without any live process is reinitialized by the next one
+	int processus [ISLAND_MAX_PROCESSUS] ;
+};
+
+// Header of a slot of the ring, followed by the chromosomes :
+// the number of visits of each day, the giant tours of all days one after the other, and the patterns (code and depot) of each service
+struct IslandSlot
+{
+	// even when the slot is stable, odd while it is being written
+	atomic <uint64_t> sequence ;
+
+	// process which is writing in the slot (0 when the slot is stable)
+	atomic <int> ecrivain ;
+
+	// number of the publication stored in the slot
+	uint64_t numero ;
+
+	// process which published the individual
+	int source ;
+
+	// cost of the individual for this process (distance, or length of the maximum route for the MM-kWRPP)
+	double cost ;
+};
+
+// Island model over several processes : some gencarp processes solve the same instance on the same host (with different seeds)
+// and exchange their best individuals through a ring of compact chromosomes in a POSIX shared-memory segment.
+// There is no lock on the exchanges : each slot is protected by its sequence number, and a migrant which is being written is read later.
+// A slot left odd by a process which died while writing it is taken over by the next publication (and skipped by the readers).
+// The attachment and detachment of the processes are done under a file lock on the segment.
+// Unlike the threads, the processes share no data structure of the search, only this segment.
+class IslandExchange
+{
+
+private:
+
+	// name of the shared-memory segment, and its file descriptor (kept open for the lock of the segment)
+	string nomSegment ;
+	int descripteur ;
+
+	// mapping of the segment, and its size
+	char * segment ;
+	size_t tailleSegment ;
+
+	// header of the segment, and size of each slot
+	IslandHeader * entete ;
+	size_t tailleSlot ;
+
+	// number of the next publication to read
+	uint64_t prochainNumero ;
+
+	// identifier of this process
+	int identifiant ;
+
+	// slot of the ring containing a publication
+	IslandSlot * getSlot (uint64_t numero) ;
+
+	// tests if a process is still running
+	static bool isVivant (int pid) ;
+
+	// initializes an empty segment (or a stale one, left by processes which have all died) for this instance
+	void initialiser (Params * params, int nbSlots) ;
+
+public:
+
+	// publishes an individual (its chromT and chromP) with its cost for this process
+	void publier (Individu * indiv, double cost) ;
+
+	// reads the next individual published by another process into "indiv" (chromT and chromP only)
+	// returns false if there is no new migrant
+	bool lireMigrant (Individu * indiv, double & cost) ;
+
+	// Constructor : attaches the process to the segment "nomSegment", which is created if needed
+	// the segment must correspond to the same instance and problem dimensions
+	IslandExchange (string nomSegment, Params * params, int nbSlots) ;
+
+	// Destructor : detaches the process, and removes the segment if no other live process is attached
+	~IslandExchange () ;
+};
+
+#endif
@@ -18,11 +18,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "LocalSearch.h"
 #include "Individu.h"
+#include "Profiler.h"
 
 void LocalSearch::runSearchTotal ()
 {
-	// Shuffling the order of move evaluations
+	// Shuffling the order of move evaluations, and choosing the neighbourhoods of this LS
 	params->shuffleProches();
+	params->ordonnanceur.debutRecherche();
 	melangeParcours();
 	int nbMoves = 0 ;
 
@@ -52,6 +54,14 @@ void LocalSearch::runSearchTotal ()
 			nbTotalRISinceBeginning += nbMoves ;
 		}
 	}
+
+	// Adapting the granularity to the ranks of the improving moves
+	if (params->isGranulariteAdaptative)
+	{
+		params->nbLSDepuisAdaptation ++ ;
+		if (params->nbLSDepuisAdaptation >= params->periodeAdaptation)
+			params->adapterGranularite();
+	}
 }
 
 int LocalSearch::mutationSameDay (int day)
@@ -66,10 +76,15 @@ int LocalSearch::mutationSameDay (int day)
 	bool routeVideTestee ;
 	Noeud * tempNoeud ;
 	int size2 ;
+	int voisinage ;
 
 	// We search and apply moves until a local minimum is attained
 	while (!rechercheTerminee)
 	{
+		// or until a stop of the search is requested, the solution is then only partially improved
+		if (params->stopToken != NULL && params->stopToken->isStopped())
+			break ;
+
 		rechercheTerminee = true ;
 		moveEffectue = 0 ;
 
@@ -107,25 +122,25 @@ int LocalSearch::mutationSameDay (int day)
 					y = noeudV->suiv ;
 					if (routeV->cour != routeU->cour)
 					{
-						if (moveEffectue != 1)
+						// Inter-route neighbourhoods, in the order chosen for this LS (by default : insertions, 2-Opt*, and 2-Opt* where the routes can be reversed)
+						for (int k = 0 ; k < NB_VOISINAGES_INTER && moveEffectue != 1 ; k++)
 						{
-							tempNoeud = noeudV ;
-							noeudV = noeudV->suiv ;
-							y = noeudV->suiv ;
-							// Testing Relocate, Swap, CROSS and I-CROSS (limited to 2 customers) of nodeU and nodeV 
-							// Case where they are in different routes
-							if (gainWhenRemoving) moveEffectue = interRouteGeneralInsert(); 
-							noeudV = tempNoeud ;
-							y = noeudV->suiv ;
+							voisinage = params->ordonnanceur.ordreInter[k] ;
+							if (voisinage == VOIS_INTER_INSERT)
+							{
+								if (!gainWhenRemoving) continue ;
+								tempNoeud = noeudV ;
+								noeudV = noeudV->suiv ;
+								y = noeudV->suiv ;
+								// Testing Relocate, Swap, CROSS and I-CROSS (limited to 2 customers) of nodeU and nodeV 
+								// Case where they are in different routes
+								moveEffectue = evaluer(VOIS_INTER_INSERT);
+								noeudV = tempNoeud ;
+								y = noeudV->suiv ;
+							}
+							else
+								moveEffectue = evaluer(voisinage);
 						}
-
-						// 2-Opt*
-						if (moveEffectue != 1) 
-							moveEffectue = interRoute2Opt ();
-
-						// 2-Opt* (second type, where the routes can be reversed)
-						if (moveEffectue != 1) 
-							moveEffectue = interRoute2OptInv ();
 					}
 					else
 					{
@@ -136,10 +151,14 @@ int LocalSearch::mutationSameDay (int day)
 						// Testing Relocate, Swap, CROSS and I-CROSS (limited to 2 customers) of nodeU and nodeV 
 						// Case where they are in the same route
 						if (moveEffectue != 1 && gainWhenRemoving) 
-							moveEffectue = intraRouteGeneralInsertDroite();
+							moveEffectue = evaluer(VOIS_INTRA_INSERT);
 						noeudV = tempNoeud ;
 						y = noeudV->suiv ;
 					}
+
+					// Statistics on the ranks of the improving moves, for the adaptive granularity
+					if (moveEffectue == 1)
+						params->succesRang[noeudU->cour*params->nbVoisins + noeudU->movesRang[posV]] ++ ;
 				}
 			}
 
@@ -153,7 +172,7 @@ int LocalSearch::mutationSameDay (int day)
 				{ 
 					// Testing 2-Opt between U and V (if the restriction of the granular search allows) 
 					if (params->isCorrelated[noeudU->pred->cour][noeudV->cour] || params->isCorrelated[noeudU->cour][noeudV->suiv->cour]) 
-						moveEffectue = intraRoute2Opt ();
+						moveEffectue = evaluer(VOIS_INTRA_2OPT);
 					noeudV = noeudV->suiv ;
 					y = noeudV->suiv ;
 				}
@@ -165,7 +184,8 @@ int LocalSearch::mutationSameDay (int day)
 				noeudV = &depots[day][route] ;
 				routeV = noeudV->route ;
 				y = noeudV->suiv ;
-				if ( (!noeudV->route->nodeAndRouteTested[noeudU->cour]) && (!y->estUnDepot || !routeVideTestee))
+				// The non-empty routes which are far from the route of U, according to their network summaries, are skipped
+				if ( (!noeudV->route->nodeAndRouteTested[noeudU->cour]) && (!y->estUnDepot || !routeVideTestee) && (y->estUnDepot || routeV == routeU || !routesFar(routeU,routeV)))
 				{
 					if (y->estUnDepot) routeVideTestee = true ;
 					if (routeV != routeU)
@@ -176,18 +196,18 @@ int LocalSearch::mutationSameDay (int day)
 
 						// Insertion after the depot, in a different route
 						if (gainWhenRemoving && (params->isCorrelated[noeudU->cour][noeudV->cour] || params->isCorrelated[noeudU->cour][y->cour]) && moveEffectue != 1 ) 
-							moveEffectue = interRouteGeneralInsert();
+							moveEffectue = evaluer(VOIS_INTER_INSERT);
 
 						noeudV = noeudV->route->depot ;
 						y = noeudV->suiv ;
 
 						// 2-Opt* after the depot
 						if (params->isCorrelated[noeudU->pred->cour][noeudV->cour] && moveEffectue != 1) 
-							moveEffectue = interRoute2Opt ();
+							moveEffectue = evaluer(VOIS_INTER_2OPT);
 
 						// 2-Opt* after the depot
 						if ((params->isCorrelated[x->cour][y->cour] || params->isCorrelated[y->cour][x->cour]) && moveEffectue != 1) 
-							moveEffectue = interRoute2OptInv ();
+							moveEffectue = evaluer(VOIS_INTER_2OPT_INV);
 
 						noeudV = tempNoeud ;
 						y = noeudV->suiv ;
@@ -200,7 +220,7 @@ int LocalSearch::mutationSameDay (int day)
 
 						// Insertion after the depot, in the same route
 						if ((params->isCorrelated[noeudU->cour][noeudV->cour] || params->isCorrelated[noeudU->cour][y->cour]) && moveEffectue != 1) 
-							moveEffectue = intraRouteGeneralInsertDroite();
+							moveEffectue = evaluer(VOIS_INTRA_INSERT);
 
 						noeudV = tempNoeud ;
 						y = noeudV->suiv ;
@@ -212,12 +232,52 @@ int LocalSearch::mutationSameDay (int day)
 			if (moveEffectue == 0)
 				nodeTestedForEachRoute(noeudU->cour,day);
 		}
+
+		// Once the classic moves are in a local minimum, testing SWAP* between the routes (the search continues in case of success)
+		if (rechercheTerminee)
+			nbMoves += swapStar(day);
 	}
 	// Calling the ejection chains at the end of the LS
-	nbMoves += ejectionChains(day);
+	if (params->ordonnanceur.isActif[VOIS_EJECTION_CHAINS])
+	{
+		moveEffectue = ejectionChains(day) ;
+		params->ordonnanceur.enregistrer(VOIS_EJECTION_CHAINS,moveEffectue == 1) ;
+		nbMoves += moveEffectue ;
+	}
+	else
+	{
+		params->ordonnanceur.nbIgnores[VOIS_EJECTION_CHAINS] ++ ;
+		#ifdef PROFILING
+		Profiler::compteurs[PROF_EJECTION_CHAINS].ignores ++ ;
+		#endif
+	}
 	return nbMoves ;
 }
 
+int LocalSearch::evaluer (int voisinage)
+{
+	if (!params->ordonnanceur.isActif[voisinage])
+	{
+		params->ordonnanceur.nbIgnores[voisinage] ++ ;
+		#ifdef PROFILING
+		Profiler::compteurs[voisinage].ignores ++ ;
+		#endif
+		return 0 ;
+	}
+
+	int moveEffectue = 0 ;
+	switch (voisinage)
+	{
+		case VOIS_INTER_INSERT : moveEffectue = interRouteGeneralInsert() ; break ;
+		case VOIS_INTER_2OPT : moveEffectue = interRoute2Opt() ; break ;
+		case VOIS_INTER_2OPT_INV : moveEffectue = interRoute2OptInv() ; break ;
+		case VOIS_INTRA_INSERT : moveEffectue = intraRouteGeneralInsertDroite() ; break ;
+		case VOIS_INTRA_2OPT : moveEffectue = intraRoute2Opt() ; break ;
+	}
+	params->ordonnanceur.enregistrer(voisinage,moveEffectue == 1) ;
+	return moveEffectue ;
+}
+
 int LocalSearch::mutationDifferentDay ()
 {
 	// Local Search to improve the pattern choices for customers (PCARP and MDCARP)
@@ -244,6 +304,8 @@ int LocalSearch::mutationDifferentDay ()
 
 int LocalSearch::interRouteGeneralInsert()
 {
+	PROFILE_SCOPE(PROF_INTER_INSERT);
+	params->nbEvaluationsLS ++ ;
 	// For a pair of nodes U, V, tests together the Relocate, Swap, and variants of CROSS and I-CROSS limited to two consecutive nodes.
 	// Some route evaluations can be gained (about 40%) by doing these computations is a combined manner
 	int ibest, jbest ;
@@ -342,6 +404,15 @@ int LocalSearch::interRouteGeneralInsert()
 	shouldBeTested[0][0] = true ;
 	resultMoves[0][0] = costZero ;
 
+	#ifdef PROFILING
+	// the call is pruned if the lower bound filters out all moves
+	bool isPruned = true ;
+	for (int i=0 ; i<4 ; i++)
+		for (int j=0 ; j<4 ; j++)
+			if ((i > 0 || j > 0) && shouldBeTested[i][j]) isPruned = false ;
+	if (isPruned) PROFILE_PRUNED ;
+	#endif
+
 	/* AND NOW WE TEST THE MOVES THAT HAVE A CHANCE TO BE IMPROVING */
 	// Exactly the same code as previously, but using "seq->evaluation" instead of "seq->evaluationLB"
 
@@ -464,11 +535,14 @@ int LocalSearch::interRouteGeneralInsert()
 
 	rechercheTerminee = false ; // Not finished the search
 	nbInterSwap ++ ;
+	PROFILE_SUCCESS ;
 	return 1 ; // Return Success
 }
 
 int LocalSearch::interRoute2Opt ()
 {
+	PROFILE_SCOPE(PROF_INTER_2OPT);
+	params->nbEvaluationsLS ++ ;
 	// Testing 2-Opt* between U and V
 	double cost ;
 	SeqData * seq = noeudU->seq0_i ;
@@ -481,7 +555,10 @@ int LocalSearch::interRoute2Opt ()
 	// Lower bound on the move value
 	cost = seq->evaluationLB(noeudU->pred->seq0_i,y->seqi_n,routeU->vehicle) + seq->evaluationLB(noeudV->seq0_i,noeudU->seqi_n,routeV->vehicle) - costZero ;
 	if ( cost  > -EPSILON_LS ) 
+	{
+		PROFILE_PRUNED ;
 		return 0 ; // Exit if no chance of improvement
+	}
 
 	// Exact move evaluation
 	cost = seq->evaluation(noeudU->pred->seq0_i,y->seqi_n,routeU->vehicle) + seq->evaluation(noeudV->seq0_i,noeudU->seqi_n,routeV->vehicle) - costZero ;
@@ -547,12 +624,15 @@ int LocalSearch::interRoute2Opt ()
 	nbInter2Opt ++ ;
 	noeudU = tempU ;
 	x = noeudU->suiv ;
+	PROFILE_SUCCESS ;
 	return 1 ; // Return Success
 }
 
 
 int LocalSearch::interRoute2OptInv()
 {
+	PROFILE_SCOPE(PROF_INTER_2OPT_INV);
+	params->nbEvaluationsLS ++ ;
 	// 2-Opt* with route inversions
 	SeqData * seq = noeudU->seq0_i ;
 	double cost ;
@@ -575,7 +655,10 @@ int LocalSearch::interRoute2OptInv()
 	else  { cost += costTempReverse ; reverseRouteV = true ; }
 
 	if ( cost  > -EPSILON_LS ) 
+	{
+		PROFILE_PRUNED ;
 		return 0 ;  // Exit if no chance of improvement
+	}
 
 	// Test the real move cost
 	cost = - costZero ;
@@ -665,11 +748,14 @@ int LocalSearch::interRoute2OptInv()
 
 	rechercheTerminee = false ; // Not finished the search
 	nbInter2Opt ++ ;
+	PROFILE_SUCCESS ;
 	return 1 ; // Return Success
 }
 
 int LocalSearch::intraRouteGeneralInsertDroite ()
 {
+	PROFILE_SCOPE(PROF_INTRA_INSERT);
+	params->nbEvaluationsLS ++ ;
 	// For a pair of nodes U, V, IN THE SAME ROUTE, tests together the Relocate, Swap, and variants of CROSS and I-CROSS limited to two consecutive nodes.
 	Noeud * tempU = noeudU ;
 	Noeud * tempV = noeudV ;
@@ -905,6 +991,15 @@ int LocalSearch::intraRouteGeneralInsertDroite ()
 	shouldBeTested[0][0] = true  ;
 	resultMoves[0][0] = costZero ;
 
+	#ifdef PROFILING
+	// the call is pruned if the lower bound filters out all moves
+	bool isPruned = true ;
+	for (int i=0 ; i<4 ; i++)
+		for (int j=0 ; j<4 ; j++)
+			if ((i > 0 || j > 0) && shouldBeTested[i][j]) isPruned = false ;
+	if (isPruned) PROFILE_PRUNED ;
+	#endif
+
 
 	// Same procedure as previously, but with "seq->evaluation" instead of "seq->evaluationLB"
 	if (decalage >= 3)
@@ -1183,12 +1278,15 @@ int LocalSearch::intraRouteGeneralInsertDroite ()
 	noeudV = tempV ;
 	x = noeudU->suiv ;
 	y = noeudV->suiv ;
+	PROFILE_SUCCESS ;
 	return 1 ; // Return Success
 }
 
 
 int LocalSearch::intraRoute2Opt ()
 {
+	PROFILE_SCOPE(PROF_INTRA_2OPT);
+	params->nbEvaluationsLS ++ ;
 	// Evaluation procedure for 2-Opt
 	Noeud * nodeNum = noeudU->suiv ;
 	Noeud * nodeUpred = noeudU->pred ;
@@ -1206,7 +1304,10 @@ int LocalSearch::intraRoute2Opt ()
 	// Compute the lower bound on move value and exits if no possible improvement
 	cost = seq->evaluationLB(myseqs,routeU->vehicle) ;
 	if (cost - costZero  > -EPSILON_LS)  
+	{
+		PROFILE_PRUNED ;
 		return 0 ;
+	}
 
 	// Compute the real move value
 	cost = seq->evaluation(myseqs,routeU->vehicle) ;
@@ -1234,11 +1335,221 @@ int LocalSearch::intraRoute2Opt ()
 	setRouteVide(noeudU->jour); // Keep a pointer on the first empty route
 	rechercheTerminee = false ; // Not finished the search
 	nbIntra2Opt ++ ;
+	PROFILE_SUCCESS ;
+	return 1 ; // Return Success
+}
+
+int LocalSearch::swapStar (int day)
+{
+	// Testing SWAP* between the pairs of non-empty routes which have not been tested since their last modification
+	Route * R1 ;
+	Route * R2 ;
+	int isSucces ;
+	for (int r1 = 0 ; r1 < params->nbVehiculesPerDep ; r1 ++)
+	{
+		R1 = depots[day][r1].route ;
+		if (R1->depot->suiv->estUnDepot) continue ;
+		for (int r2 = r1+1 ; r2 < params->nbVehiculesPerDep ; r2 ++)
+		{
+			R2 = depots[day][r2].route ;
+			if (R2->depot->suiv->estUnDepot || R1->swapStarTested[R2->cour]) continue ;
+			if (routesOverlap(R1,R2))
+			{
+				// SWAP* may be skipped by the scheduling of the current LS, the pair is then not marked as tested
+				if (!params->ordonnanceur.isActif[VOIS_SWAP_STAR])
+				{
+					params->ordonnanceur.nbIgnores[VOIS_SWAP_STAR] ++ ;
+					#ifdef PROFILING
+					Profiler::compteurs[PROF_SWAP_STAR].ignores ++ ;
+					#endif
+					continue ;
+				}
+				isSucces = swapStar(R1,R2) ;
+				params->ordonnanceur.enregistrer(VOIS_SWAP_STAR,isSucces == 1) ;
+				if (isSucces) return 1 ;
+			}
+			R1->swapStarTested[R2->cour] = true ;
+			R2->swapStarTested[R1->cour] = true ;
+		}
+	}
+	return 0 ;
+}
+
+bool LocalSearch::routesFar (Route * R1, Route * R2)
+{
+	if (!R1->proximityKnown[R2->cour])
+	{
+		R1->proximityFar[R2->cour] = R1->isFarFrom(R2) ;
+		R2->proximityFar[R1->cour] = R1->proximityFar[R2->cour] ;
+		R1->proximityKnown[R2->cour] = true ;
+		R2->proximityKnown[R1->cour] = true ;
+	}
+	return R1->proximityFar[R2->cour] ;
+}
+
+bool LocalSearch::routesOverlap (Route * R1, Route * R2)
+{
+	// The instances of arc routing problems have no coordinates for the services,
+	// the spatial overlap of the routes is therefore measured with the correlated vertices of the granular search
+	// The pairs of routes which are far apart, according to their network summary, are discarded without examining the services
+	if (routesFar(R1,R2)) return false ;
+
+	for (Noeud * U = R1->depot->suiv ; !U->estUnDepot ; U = U->suiv)
+		for (int i=0 ; i < (int)U->moves.size() ; i++)
+			if (clients[R1->day][U->moves[i]].route == R2) return true ;
+
+	for (Noeud * V = R2->depot->suiv ; !V->estUnDepot ; V = V->suiv)
+		for (int i=0 ; i < (int)V->moves.size() ; i++)
+			if (clients[R2->day][V->moves[i]].route == R1) return true ;
+
+	return false ;
+}
+
+void LocalSearch::preprocessInsertions (Route * R1, Route * R2)
+{
+	// The SeqData of a single service contains its two orientations, so each insertion cost is given for the best orientation
+	SeqData * seq = R1->depot->seq0_i ;
+	for (Noeud * U = R1->depot->suiv ; !U->estUnDepot ; U = U->suiv)
+	{
+		ssRemoval[U->cour] = seq->evaluation(U->pred->seq0_i,U->suiv->seqi_n,R1->vehicle);
+		ssInsertions[U->cour].reset();
+
+		// Insertion after any node of R2, including the depot (the lower bound avoids evaluating the positions which cannot be among the three best)
+		for (Noeud * P = R2->depot ; P != R2->depot->pred ; P = P->suiv)
+			if (seq->evaluationLB(P->seq0_i,U->seq1,P->suiv->seqi_n,R2->vehicle) < ssInsertions[U->cour].cost[2])
+				ssInsertions[U->cour].add(seq->evaluation(P->seq0_i,U->seq1,P->suiv->seqi_n,R2->vehicle),P);
+	}
+}
+
+double LocalSearch::evalRemoveInsert (Noeud * U, Noeud * V, Noeud * placeV)
+{
+	// Cost of the route of U, when U is removed and V is inserted after the node "placeV" of this route
+	SeqData * seq = U->seq0_i ;
+	Vehicle * vehicle = U->route->vehicle ;
+
+	// Insertion in place of U
+	if (placeV == U->pred || placeV == U)
+		return seq->evaluation(U->pred->seq0_i,V->seq1,U->suiv->seqi_n,vehicle);
+
+	myseqs.clear();
+	if (placeV->place < U->place)
+	{
+		// Insertion before U
+		myseqs.push_back(placeV->seq0_i);
+		myseqs.push_back(V->seq1);
+		addSeqDataInPieces(placeV->suiv,U->pred->place - placeV->suiv->place,U->jour);
+		myseqs.push_back(U->suiv->seqi_n);
+	}
+	else
+	{
+		// Insertion after U
+		myseqs.push_back(U->pred->seq0_i);
+		addSeqDataInPieces(U->suiv,placeV->place - U->suiv->place,U->jour);
+		myseqs.push_back(V->seq1);
+		myseqs.push_back(placeV->suiv->seqi_n);
+	}
+	return seq->evaluation(myseqs,vehicle);
+}
+
+int LocalSearch::swapStar (Route * R1, Route * R2)
+{
+	PROFILE_SCOPE(PROF_SWAP_STAR);
+	params->nbEvaluationsLS ++ ;
+	// Exchange of a service U of R1 with a service V of R2, U being inserted at its best position in R2 and V at its best position in R1
+	// The move values are estimated from the preprocessed removal and insertion costs, only the most promising moves are evaluated exactly
+	double costZero = R1->currentRouteCost + R2->currentRouteCost ;
+	double bestCost = costZero - EPSILON_LS ;
+	double costR1, costR2, cost ;
+	Noeud * placeU ;
+	Noeud * placeV ;
+	Noeud * bestU = NULL ;
+	Noeud * bestV = NULL ;
+	Noeud * bestPlaceU = NULL ;
+	Noeud * bestPlaceV = NULL ;
+	#ifdef PROFILING
+	bool isPruned = true ;
+	#endif
+
+	preprocessInsertions(R1,R2);
+	preprocessInsertions(R2,R1);
+
+	for (Noeud * U = R1->depot->suiv ; !U->estUnDepot ; U = U->suiv)
+	{
+		for (Noeud * V = R2->depot->suiv ; !V->estUnDepot ; V = V->suiv)
+		{
+			// Best position of V in R1 : in place of U, or the best preprocessed position which is not adjacent to U
+			// (the cost of the adjacent positions was computed with U in the route)
+			placeV = U->pred ;
+			costR1 = U->seq0_i->evaluation(U->pred->seq0_i,V->seq1,U->suiv->seqi_n,R1->vehicle);
+			for (int k=0 ; k<3 && ssInsertions[V->cour].place[k] != NULL ; k++)
+			{
+				if (ssInsertions[V->cour].place[k] != U->pred && ssInsertions[V->cour].place[k] != U)
+				{
+					cost = ssRemoval[U->cour] + ssInsertions[V->cour].cost[k] - R1->currentRouteCost ;
+					if (cost < costR1) { costR1 = cost ; placeV = ssInsertions[V->cour].place[k] ; }
+					break ;
+				}
+			}
+
+			// Same thing for the position of U in R2
+			placeU = V->pred ;
+			costR2 = V->seq0_i->evaluation(V->pred->seq0_i,U->seq1,V->suiv->seqi_n,R2->vehicle);
+			for (int k=0 ; k<3 && ssInsertions[U->cour].place[k] != NULL ; k++)
+			{
+				if (ssInsertions[U->cour].place[k] != V->pred && ssInsertions[U->cour].place[k] != V)
+				{
+					cost = ssRemoval[V->cour] + ssInsertions[U->cour].cost[k] - R2->currentRouteCost ;
+					if (cost < costR2) { costR2 = cost ; placeU = ssInsertions[U->cour].place[k] ; }
+					break ;
+				}
+			}
+
+			// Exact evaluation of the promising moves, as the removal and insertion costs are not additive with the penalized constraints
+			if (costR1 + costR2 < bestCost)
+			{
+				#ifdef PROFILING
+				isPruned = false ;
+				#endif
+				cost = evalRemoveInsert(U,V,placeV) + evalRemoveInsert(V,U,placeU) ;
+				if (cost < bestCost)
+				{
+					bestCost = cost ;
+					bestU = U ;
+					bestV = V ;
+					bestPlaceU = placeU ;
+					bestPlaceV = placeV ;
+				}
+			}
+		}
+	}
+
+	#ifdef PROFILING
+	if (isPruned) PROFILE_PRUNED ;
+	#endif
+
+	// If no improving move between the two routes, we return
+	if (bestU == NULL)
+		return 0 ;
+
+	/* AN IMPROVING MOVE HAS BEEN DETECTED, IT IS DIRECTLY APPLIED */
+
+	reinitSingleDayMoves(R1); // Say that all moves involving this route must be tested again
+	reinitSingleDayMoves(R2); // Say that all moves involving this route must be tested again
+	insertNoeud(bestU,bestPlaceU);
+	insertNoeud(bestV,bestPlaceV);
+	R1->updateRouteData(false);
+	R2->updateRouteData(false);
+	setRouteVide(R1->day); // Keep a pointer on the first empty route
+
+	rechercheTerminee = false ; // Not finished the search
+	nbSwapStar ++ ;
+	PROFILE_SUCCESS ;
 	return 1 ; // Return Success
 }
 
 int LocalSearch::searchBetterPattern (int client)
 {
+	PROFILE_SCOPE(PROF_BETTER_PATTERN);
 	pattern pattern1 = individu->chromP[client] ;
 	pattern pattern2, meilleurPattern ;
 	int indexMeilleur = -1 ;
@@ -1302,6 +1613,7 @@ int LocalSearch::searchBetterPattern (int client)
 		// (PCARP) Updating the chromP (necessary to do now, not later, otherwise the wrong data is set to pre-process the SeqData)
 		// When adding the nodes in the next block of instructions
 		individu->chromP[client] = meilleurPattern ;
+		individu->updateChargeJour(client);
 
 		// Inserting in the new locations
 		calcul = meilleurPattern.pat ;
@@ -1320,6 +1632,7 @@ int LocalSearch::searchBetterPattern (int client)
 		//cout << "Inserting Node " << client << " With pattern " << meilleurPattern.pat << " Flag is : " << deplacementIntraJour << endl ;
 
 		rechercheTerminee = false ;
+		PROFILE_SUCCESS ;
 		return 1 ;
 	}
 	else return 0 ;
@@ -1359,6 +1672,7 @@ void LocalSearch::computeCoutInsertion(Noeud * client, int pattern)
 
 void LocalSearch::evalInsertClient (Route * R,Noeud * U,int pattern) 
 {
+	params->nbEvaluationsLS ++ ;
 	// Computing the least cost for inserting a client U in a route R
 	SeqData * seq = U->seq0_i ;
 	Noeud * courNoeud ;
@@ -1456,18 +1770,31 @@ void LocalSearch::melangeParcours ()
 
 void LocalSearch::updateMoves ()
 {
-	int client, client2, size ;
+	int client, client2, granularite, r ;
+	const int * voisins ;
+	const int * ordre ;
+	Noeud * noeud ;
 	for (int k=1 ; k<=params->nbDays ; k++)
 	{
 		for (int i=0 ; i<( int)ordreParcours[k].size() ; i++)
 		{
+			// The moves are the first customers of the ranked list of close customers (present on this day), in the shuffled order of evaluation
 			client = ordreParcours[k][i] ;
-			clients[k][client].moves.clear();
-			size = (int)params->cli[client].sommetsVoisinsAvant.size();
-			for (int a1 = 0 ; a1 < size ; a1++ )
+			noeud = &clients[k][client] ;
+			noeud->moves.clear();
+			noeud->movesRang.clear();
+			voisins = &params->voisinsClasses[client*params->nbVoisins] ;
+			ordre = &params->ordreRangs[client*params->nbVoisins] ;
+			granularite = params->granulariteNoeud[client] ;
+			for (int a1 = 0 ; a1 < params->nbVoisins ; a1++ )
 			{
-				client2 = params->cli[client].sommetsVoisinsAvant[a1] ;
-				if (client2 >= params->nbDepots && clients[k][client2].estPresent) clients[k][client].moves.push_back(client2);
+				r = ordre[a1] ;
+				client2 = voisins[r] ;
+				if (r < granularite && client2 >= params->nbDepots && clients[k][client2].estPresent) 
+				{
+					noeud->moves.push_back(client2);
+					noeud->movesRang.push_back(r);
+				}
 			}
 		}
 	}
@@ -1544,6 +1871,7 @@ void LocalSearch::placeManquants ()
 
 		// Updating the chromP with the chosen pattern
 		individu->chromP[k] = meilleurPattern ;
+		individu->updateChargeJour(k);
 
 		// Inserting in the new locations
 		calcul1 = pattern1.pat ;
@@ -1657,14 +1985,55 @@ void LocalSearch::reinitSingleDayMoves(Route * r)
 	for (Noeud * tempNoeud = r->depot->suiv ; !tempNoeud->estUnDepot ; tempNoeud = tempNoeud->suiv)
 		for (int route = 0 ; route < params->nbVehiculesPerDep ; route ++)
 			depots[tempNoeud->jour][route].route->nodeAndRouteTested[tempNoeud->cour] = false ;
+
+	for (int route = 0 ; route < params->nbVehiculesPerDep ; route ++)
+	{
+		r->swapStarTested[route] = false ;
+		depots[r->day][route].route->swapStarTested[r->cour] = false ;
+		r->proximityKnown[route] = false ;
+		depots[r->day][route].route->proximityKnown[r->cour] = false ;
+	}
 }
 
 void LocalSearch::reinitAllSingleDayMoves()
 {
 	for (int k=1 ; k<= params->nbDays ; k++)
 		for (int route = 0 ; route < params->nbVehiculesPerDep ; route ++)
+		{
 			for (int i=0 ; i < params->nbClients + params->nbDepots ; i ++ )
 				depots[k][route].route->nodeAndRouteTested[i] = false ;
+			for (int route2 = 0 ; route2 < params->nbVehiculesPerDep ; route2 ++)
+			{
+				depots[k][route].route->swapStarTested[route2] = false ;
+				depots[k][route].route->proximityKnown[route2] = false ;
+			}
+		}
+}
+
+void LocalSearch::ecExtend (EC_element * labelU, Noeud * avant, Noeud * apres, EC_element * cible, Noeud * insertionPlace)
+{
+	int layer = ec_layer[avant->route->cour] ;
+	double myCost = labelU->cost + avant->seq0_i->evaluation(avant->seq0_i,labelU->myNode->seq1,apres->seqi_n,avant->route->vehicle) - ec_prevCost[layer] ;
+
+	// Insertion closing the chain, on the depot node of the layer
+	if (cible->myNode->estUnDepot)
+	{
+		if (myCost < cible->cost - 0.0001 || (myCost < cible->cost + 0.0001 && labelU->nbCustNodesInChain > cible->nbCustNodesInChain))
+		{
+			cible->cost = myCost ;
+			cible->pred = labelU ;
+			cible->bestInsertionPlace = insertionPlace ;
+			cible->nbCustNodesInChain = labelU->nbCustNodesInChain ;
+		}
+	}
+	// Insertion in place of a customer, which is ejected
+	else if (myCost < cible->cost - 0.0001 || (myCost < cible->cost + 0.0001 && labelU->nbCustNodesInChain >= cible->nbCustNodesInChain))
+	{
+		cible->cost = myCost ;
+		cible->pred = labelU ;
+		cible->bestInsertionPlace = NULL ;
+		cible->nbCustNodesInChain = labelU->nbCustNodesInChain + 1 ;
+	}
 }
 
 bool compPredicateEC(EC_element * i,EC_element * j)
@@ -1674,47 +2043,56 @@ bool compPredicateEC(EC_element * i,EC_element * j)
 
 bool LocalSearch::ejectionChains (int day)
 {
+	PROFILE_SCOPE(PROF_EJECTION_CHAINS);
 	SeqData * seq = depots[day][0].seq0_i ;
-	int myNodeIndex ;
 	int myRouteIndex ;
+	int layerV ;
 	Noeud * myNoeud ;
+	Noeud * noeudU ;
+	Noeud * noeudX ;
+	Noeud * noeudV ;
 	Vehicle * myVehicle ;
-	Noeud * myDepot ;
-	double myPrevCost ;
+	EC_element myElement ;
+	EC_element * labelU ;
 	double myDeltaCost ;
 
 	// 1) CHOOSE AN ORDER FOR THE BINS
-	vector < Noeud * > ordreBins ;
+	vector < Noeud * > & ordreBins = params->workspace.ordreBins ;
+	ordreBins.clear();
 	for (int route = 0 ; route < params->nbVehiculesPerDep ; route ++)
 		ordreBins.push_back(&depots[day][route]);
 	std::random_shuffle(ordreBins.begin(),ordreBins.end());
 
 	// 2) UPDATE THE DATA STRUCTURE WILL ALL NECESSARY INFORMATIONS AND THE GOOD SIZE
+	// (the layers are only filled for the non-empty routes, one after the other in ec_elements whose memory is reserved in the constructor)
+	myElement.cost = 1.e20 ;
+	myElement.pred = NULL ;
+	myElement.bestInsertionPlace = NULL ;
+	myElement.nbCustNodesInChain = 0 ;
 	myRouteIndex = 0 ;
+	ec_elements.clear();
 	for (int route = 0 ; route < params->nbVehiculesPerDep ; route ++)
 	{
 		myNoeud = ordreBins[route] ;
+		ec_layer[myNoeud->route->cour] = -1 ;
 		// if the route is not empty, this makes a new layer in the ejection chains graph
 		if (!myNoeud->suiv->estUnDepot)
 		{
-			ejectionGraph[myRouteIndex][0].myNode = myNoeud ;
-			ejectionGraph[myRouteIndex][0].cost = 1.e20 ;
-			ejectionGraph[myRouteIndex][0].pred = NULL ;
-			ejectionGraph[myRouteIndex][0].nbCustNodesInChain = 0 ;
-			ejectionGraph[myRouteIndex][0].routeID = route ;
+			ec_taille[myRouteIndex] = (int)ec_elements.size() ;
+			ec_layer[myNoeud->route->cour] = myRouteIndex ;
+			ec_prevCost[myRouteIndex] = myNoeud->pred->seq0_i->evaluation(myNoeud->pred->seq0_i,myNoeud->route->vehicle) ;
+			myElement.routeID = route ;
+			myElement.myNode = myNoeud ;
+			ec_elements.push_back(myElement);
 			myNoeud = myNoeud->suiv ;
-			myNodeIndex = 1 ;
 			while (!myNoeud->estUnDepot)
 			{
-				ejectionGraph[myRouteIndex][myNodeIndex].myNode = myNoeud ;
-				ejectionGraph[myRouteIndex][myNodeIndex].cost = 1.e20 ;
-				ejectionGraph[myRouteIndex][myNodeIndex].pred = NULL ;
-				ejectionGraph[myRouteIndex][myNodeIndex].nbCustNodesInChain = 0 ;
-				ejectionGraph[myRouteIndex][myNodeIndex].routeID = route ;
+				myElement.myNode = myNoeud ;
+				ec_elements.push_back(myElement);
 				myNoeud = myNoeud->suiv ;
-				myNodeIndex ++ ;
 			}
-			ec_nbElements[myRouteIndex] = myNodeIndex ;
+			ejectionGraph[myRouteIndex] = &ec_elements[ec_taille[myRouteIndex]] ;
+			ec_taille[myRouteIndex] = (int)ec_elements.size() - ec_taille[myRouteIndex] ;
 			myRouteIndex ++ ;
 		}
 	}
@@ -1727,53 +2105,26 @@ bool LocalSearch::ejectionChains (int day)
 	}
 
 	// 3) SOLVE THE SHORTEST PATH PROBLEM
-	// for each bin in order
+	// for each bin in order, the labels of the bin are complete once the previous bins have been processed
 	for (int r=0 ; r < ec_nbRoutes ; r++)
 	{
-		myDepot = ejectionGraph[r][0].myNode ;
-		myVehicle = myDepot->route->vehicle ;
-		myPrevCost = myDepot->pred->seq0_i->evaluation(myDepot->pred->seq0_i,myVehicle); 
+		myVehicle = ejectionGraph[r][0].myNode->route->vehicle ;
 
-		for (int rPrev=0 ; rPrev < r  ; rPrev ++)
+		// For the depot node, propagate from the previous depot node (which already has the best chain ending in the previous bins)
+		if (r > 0 && (ejectionGraph[r-1][0].cost < ejectionGraph[r][0].cost - 0.0001 || 
+			(ejectionGraph[r-1][0].cost < ejectionGraph[r][0].cost + 0.0001 && ejectionGraph[r-1][0].nbCustNodesInChain > ejectionGraph[r][0].nbCustNodesInChain)))
 		{
-			// For the depot node, propagate from another previous depot node
-			if (ejectionGraph[rPrev][0].cost < ejectionGraph[r][0].cost - 0.0001 || 
-				(ejectionGraph[rPrev][0].cost < ejectionGraph[r][0].cost + 0.0001 && ejectionGraph[rPrev][0].nbCustNodesInChain > ejectionGraph[r][0].nbCustNodesInChain))
-			{
-				ejectionGraph[r][0].cost = ejectionGraph[rPrev][0].cost ;
-				ejectionGraph[r][0].pred = &ejectionGraph[rPrev][0] ;
-				ejectionGraph[r][0].bestInsertionPlace = NULL ;
-				ejectionGraph[r][0].nbCustNodesInChain = ejectionGraph[rPrev][0].nbCustNodesInChain ;
-			}
-
-			// for the depot node, propagate from any predecessor node
-			for (int iiPrev=1 ; iiPrev < ec_nbElements[rPrev] ; iiPrev++)
-			{
-				// for any such predecessor, test the best place of insertion in the route
-				for (int ii=0 ; ii < ec_nbElements[r] ; ii++)
-				{
-					myDeltaCost = seq->evaluation(ejectionGraph[r][ii].myNode->seq0_i,
-						ejectionGraph[rPrev][iiPrev].myNode->seq1,
-						ejectionGraph[r][ii].myNode->suiv->seqi_n,
-						myVehicle) - myPrevCost ; 
-					if (myDeltaCost + ejectionGraph[rPrev][iiPrev].cost < ejectionGraph[r][0].cost - 0.0001 || 
-						(myDeltaCost + ejectionGraph[rPrev][iiPrev].cost < ejectionGraph[r][0].cost + 0.0001 && ejectionGraph[rPrev][iiPrev].nbCustNodesInChain > ejectionGraph[r][0].nbCustNodesInChain))
-					{
-						ejectionGraph[r][0].cost = myDeltaCost + ejectionGraph[rPrev][iiPrev].cost ;
-						ejectionGraph[r][0].pred = &ejectionGraph[rPrev][iiPrev] ;
-						ejectionGraph[r][0].bestInsertionPlace = ejectionGraph[r][ii].myNode ;
-						ejectionGraph[r][0].nbCustNodesInChain = ejectionGraph[rPrev][iiPrev].nbCustNodesInChain ;
-					}
-				}
-			}
+			ejectionGraph[r][0].cost = ejectionGraph[r-1][0].cost ;
+			ejectionGraph[r][0].pred = &ejectionGraph[r-1][0] ;
+			ejectionGraph[r][0].bestInsertionPlace = NULL ;
+			ejectionGraph[r][0].nbCustNodesInChain = ejectionGraph[r-1][0].nbCustNodesInChain ;
 		}
 
-		for (int ii=1 ; ii < ec_nbElements[r] ; ii++)
+		for (int ii=1 ; ii < ec_taille[r] ; ii++)
 		{
 			// for each customer node in the bin, propagate from the general 0 node
-			myDeltaCost = seq->evaluation(ejectionGraph[r][ii].myNode->pred->seq0_i,
-				ejectionGraph[r][ii].myNode->suiv->seqi_n,
-				myVehicle) - myPrevCost ;
+			noeudX = ejectionGraph[r][ii].myNode ;
+			myDeltaCost = seq->evaluation(noeudX->pred->seq0_i,noeudX->suiv->seqi_n,myVehicle) - ec_prevCost[r] ;
 			if (myDeltaCost < ejectionGraph[r][ii].cost - 0.0001)
 			{
 				ejectionGraph[r][ii].cost = myDeltaCost ;
@@ -1782,44 +2133,57 @@ bool LocalSearch::ejectionChains (int day)
 				ejectionGraph[r][ii].nbCustNodesInChain = 1 ;
 			}
 
-			// for each customer node in the bin, propagate from any previous 0 (depot) node.
-			for (int rPrev=0 ; rPrev < r  ; rPrev ++)
+			// for each customer node in the bin, propagate from the previous depot node
+			if (r > 0 && (myDeltaCost + ejectionGraph[r-1][0].cost < ejectionGraph[r][ii].cost - 0.0001 ||
+				(myDeltaCost + ejectionGraph[r-1][0].cost < ejectionGraph[r][ii].cost + 0.0001 && ejectionGraph[r-1][0].nbCustNodesInChain >= ejectionGraph[r][ii].nbCustNodesInChain)))
+			{
+				ejectionGraph[r][ii].cost = myDeltaCost + ejectionGraph[r-1][0].cost ;
+				ejectionGraph[r][ii].pred = &ejectionGraph[r-1][0] ;
+				ejectionGraph[r][ii].bestInsertionPlace = NULL ;
+				ejectionGraph[r][ii].nbCustNodesInChain = ejectionGraph[r-1][0].nbCustNodesInChain + 1 ;
+			}
+		}
+
+		// The chains of negative cost ending with the ejection of a customer U of this bin are extended to the next bins,
+		// by inserting U next to one of its close customers V (the chains of non-negative cost are not extended)
+		for (int ii=1 ; ii < ec_taille[r] ; ii++)
+		{
+			labelU = &ejectionGraph[r][ii] ;
+			if (labelU->cost > -0.0001) continue ;
+			noeudU = labelU->myNode ;
+
+			// V placed before U : insertion after V, or in place of the successor of V
+			for (int a=0 ; a < (int)noeudU->moves.size() ; a++)
 			{
-				if (myDeltaCost + ejectionGraph[rPrev][0].cost < ejectionGraph[r][ii].cost - 0.0001 ||
-					(myDeltaCost + ejectionGraph[rPrev][0].cost < ejectionGraph[r][ii].cost + 0.0001 && ejectionGraph[rPrev][0].nbCustNodesInChain >= ejectionGraph[r][ii].nbCustNodesInChain))
+				noeudV = &clients[day][noeudU->moves[a]] ;
+				layerV = ec_layer[noeudV->route->cour] ;
+				if (layerV > r)
 				{
-					ejectionGraph[r][ii].cost = myDeltaCost + ejectionGraph[rPrev][0].cost ;
-					ejectionGraph[r][ii].pred = &ejectionGraph[rPrev][0] ;
-					ejectionGraph[r][ii].bestInsertionPlace = NULL ;
-					ejectionGraph[r][ii].nbCustNodesInChain = ejectionGraph[rPrev][0].nbCustNodesInChain + 1 ;
+					ecExtend(labelU,noeudV,noeudV->suiv,&ejectionGraph[layerV][0],noeudV);
+					if (!noeudV->suiv->estUnDepot)
+						ecExtend(labelU,noeudV,noeudV->suiv->suiv,&ejectionGraph[layerV][noeudV->suiv->place],NULL);
 				}
 			}
 
-			// for each customer node in the bin, propagate from a previous customer node.
-			for (int rPrev=0 ; rPrev < r  ; rPrev ++)
+			// V placed after U : insertion before V, or in place of the predecessor of V
+			for (int a=0 ; a < (int)params->cli[noeudU->cour].sommetsVoisins.size() ; a++)
 			{
-				for (int iiPrev=1 ; iiPrev < ec_nbElements[rPrev] ; iiPrev++)
+				noeudV = &clients[day][params->cli[noeudU->cour].sommetsVoisins[a]] ;
+				if (noeudV->cour < params->nbDepots || !noeudV->estPresent) continue ;
+				layerV = ec_layer[noeudV->route->cour] ;
+				if (layerV > r)
 				{
-					myDeltaCost = seq->evaluation(ejectionGraph[r][ii].myNode->pred->seq0_i,
-						ejectionGraph[rPrev][iiPrev].myNode->seq1,
-						ejectionGraph[r][ii].myNode->suiv->seqi_n,
-						myVehicle) - myPrevCost ;
-
-					if (myDeltaCost + ejectionGraph[rPrev][iiPrev].cost < ejectionGraph[r][ii].cost - 0.0001 ||
-						(myDeltaCost + ejectionGraph[rPrev][iiPrev].cost < ejectionGraph[r][ii].cost + 0.0001 &&  ejectionGraph[rPrev][iiPrev].nbCustNodesInChain >= ejectionGraph[r][ii].nbCustNodesInChain))
-					{
-						ejectionGraph[r][ii].cost = myDeltaCost + ejectionGraph[rPrev][iiPrev].cost ;
-						ejectionGraph[r][ii].pred = &ejectionGraph[rPrev][iiPrev] ;
-						ejectionGraph[r][ii].bestInsertionPlace = NULL ;
-						ejectionGraph[r][ii].nbCustNodesInChain = ejectionGraph[rPrev][iiPrev].nbCustNodesInChain + 1 ;
-					}
+					ecExtend(labelU,noeudV->pred,noeudV,&ejectionGraph[layerV][0],noeudV->pred);
+					if (!noeudV->pred->estUnDepot)
+						ecExtend(labelU,noeudV->pred->pred,noeudV,&ejectionGraph[layerV][noeudV->pred->place],NULL);
 				}
 			}
 		}
 	}
 
 	// 4) KEEP THE BEST SHORTEST PATHS in increasing order of costs.
-	vector <EC_element *> orderEnds ;
+	vector <EC_element *> & orderEnds = params->workspace.orderEnds ;
+	orderEnds.clear();
 	for (int r=1 ; r < ec_nbRoutes ; r++)
 		orderEnds.push_back(&ejectionGraph[r][0]);
 	std::sort(orderEnds.begin(),orderEnds.end(),compPredicateEC);
@@ -1869,6 +2233,7 @@ bool LocalSearch::ejectionChains (int day)
 			}
 		}
 		setRouteVide(day);
+		PROFILE_SUCCESS ;
 		return true ;
 	}
 	else
@@ -1895,20 +2260,20 @@ void LocalSearch::addReverseSeqDataInPieces (Noeud * node, int length, int day)
 {
 	Noeud * cour = node ;
 	SeqData * courSeq ;
-	list <SeqData*> myseqTemp ;
+	int debutPieces = (int)myseqs.size() ;
 	int courLenght = length + 1 ;
 	int temp ;
 	while (courLenght > 0)
 	{
 		temp = min(courLenght,params->sizeSD) ;
 		courSeq = cour->seqj_i[temp-1];
-		myseqTemp.push_back(courSeq);
+		myseqs.push_back(courSeq);
 		courLenght -= temp ;
 		if (courLenght != 0) cour = clients[day][courSeq->firstNode].suiv ;
 	}
 
-	for ( list<SeqData*>::reverse_iterator it=myseqTemp.rbegin() ; it != myseqTemp.rend() ; it++)
-		myseqs.push_back(*it);
+	// The pieces have been appended in the order of the route, they are traversed in the reverse order
+	reverse(myseqs.begin()+debutPieces,myseqs.end());
 }
 
 LocalSearch::LocalSearch(void)
@@ -1926,6 +2291,7 @@ LocalSearch::LocalSearch(Params * params,Individu * individu) : params (params),
 	nbIntraSwap = 0 ;
 	nbInter2Opt = 0 ;
 	nbIntra2Opt = 0 ;
+	nbSwapStar = 0 ;
 	nbEjectionChains = 0 ;
 	nbEjectionChainsNodes = 0 ;
 	seqdeb = NULL ;
@@ -1948,7 +2314,11 @@ LocalSearch::LocalSearch(Params * params,Individu * individu) : params (params),
 		routes[kk] = new Route [nbVeh] ; 
 
 		for (int i = 0 ; i <  params->nbClients + params->nbDepots ; i ++ )
+		{
 			clients[kk][i] = Noeud(false,i,kk,false,NULL,NULL,NULL,params);
+			clients[kk][i].moves.reserve(params->cli[i].sommetsVoisinsAvant.size());
+			clients[kk][i].movesRang.reserve(params->cli[i].sommetsVoisinsAvant.size());
+		}
 
 		for (int i = 0 ; i < nbVeh ; i++ )
 		{
@@ -1970,27 +2340,44 @@ LocalSearch::LocalSearch(Params * params,Individu * individu) : params (params),
 	for (int day = 0 ; day <= params->nbDays ; day++)
 	{
 		ordreParcours.push_back(temp2);
+		ordreParcours[day].reserve(params->nbClients + params->nbDepots);
 		routeVide.push_back(NULL);
 	}
 
 	for (int i=params->nbDepots ; i < params->nbDepots + params->nbClients ; i++)
 		ordreParcours[0].push_back(i);
 
-	// Initialization for ejection chains
-	for (int v=0 ; v < params->nbVehiculesPerDep ; v ++)
-		ejectionGraph.push_back(vector <EC_element> (params->nbClients+1));
-	ec_nbElements = vector <int> (params->nbVehiculesPerDep);
+	// The sequences of a move evaluation can not be more numerous than the services, with the two depots
+	myseqs.reserve(params->nbClients + params->nbDepots + 2);
+
+	// Initialization for SWAP*
+	ssInsertions = vector < SS_insertions > (params->nbClients + params->nbDepots) ;
+	ssRemoval = vector < double > (params->nbClients + params->nbDepots) ;
 
-	// Initialization of the SeqData structures, for all nodes
+	// Initialization for ejection chains (one layer per non-empty route sized by the route, the layers of a day
+	// share a single buffer which holds all services of the day and one depot node per layer)
+	ec_layer = vector <int> (params->nbVehiculesPerDep);
+	ec_prevCost = vector <double> (params->nbVehiculesPerDep);
+	ec_elements.reserve(params->nbClients + params->nbVehiculesPerDep);
+	ejectionGraph = vector < EC_element * > (params->nbVehiculesPerDep);
+	ec_taille = vector <int> (params->nbVehiculesPerDep);
+
+	// Initialization of the SeqData structures, for all nodes which can be visited on their day
+	// (MDCARP with a restriction to the closest depots, the other nodes are never inserted in a route and do not receive any SeqData)
 	// These structures were designed to stay contiguous in memory (however it had only a negligible impact on performance)
 	int nbSeqsSet = 0 ;
-	int taillemyseqDatas = (params->sizeSD + params->sizeSD + 4)*(params->nbClients + params->nbDepots + 2*params->nbVehiculesPerDep)*params->nbDays ;
+	int nbNoeudsVisitables = 2*params->nbVehiculesPerDep*params->nbDays ;
+	for (int k=1 ; k <= params->nbDays ; k++)
+		for (int i=0 ; i < params->nbClients + params->nbDepots ; i++)
+			if (params->estVisitable(i,k)) nbNoeudsVisitables ++ ;
+	int taillemyseqDatas = (params->sizeSD + params->sizeSD + 4)*nbNoeudsVisitables ;
 	SeqData * myseqDatas = new SeqData [taillemyseqDatas] ;
 	seqdeb = myseqDatas ;
 	for (int k=1 ; k <= params->nbDays ; k++)
 	{
 		for (int i=0 ; i < params->nbClients + params->nbDepots ; i++) 
 		{
+			if (!params->estVisitable(i,k)) continue ;
 			for (int ii=nbSeqsSet ; ii < nbSeqsSet+4+params->sizeSD+params->sizeSD ; ii++)
 				myseqDatas[ii].initialisation(clients[k][i].cour,params,individu,k,false);  
 
@@ -53,6 +53,37 @@ struct EC_element {
 	int routeID ;
 };
 
+// Little structure for SWAP* : three best insertion positions of a service in a route
+struct SS_insertions {
+
+	// Costs of the route after the insertion (1.e30 if there is no such position)
+	double cost [3] ;
+
+	// Nodes after which the service is inserted
+	Noeud * place [3] ;
+
+	// Removes all positions
+	void reset ()
+	{
+		for (int i=0 ; i<3 ; i++) { cost[i] = 1.e30 ; place[i] = NULL ; }
+	}
+
+	// Adds a position, if it is among the three best
+	void add (double myCost, Noeud * myPlace)
+	{
+		if (myCost >= cost[2]) return ;
+		int i = 2 ;
+		while (i > 0 && myCost < cost[i-1])
+		{
+			cost[i] = cost[i-1] ;
+			place[i] = place[i-1] ;
+			i -- ;
+		}
+		cost[i] = myCost ;
+		place[i] = myPlace ;
+	}
+};
+
 // Local Search class
 class LocalSearch
 {
@@ -114,6 +145,17 @@ private:
 	int intraRouteGeneralInsertDroite(); // Intra-Route General Insert (testing all moves together for a customer pair [i,j] enables to gain a few evaluations)
     int intraRoute2Opt (); // Intra-Route 2-Opt
 
+	// SWAP* (Vidal 2022) : exchange of two services between two routes, each service being reinserted at its best position in the other route
+	// Tested once the classic moves are in a local minimum, only for the pairs of routes which overlap
+	int swapStar (int day) ; // Tests all pairs of routes of the day which have not been tested since their last modification
+	int swapStar (Route * R1, Route * R2) ; // Tests the moves between two routes, and applies the best improving one
+	bool routesFar (Route * R1, Route * R2) ; // Two routes are far apart if they have no pair of close services, according to their network summaries
+	bool routesOverlap (Route * R1, Route * R2) ; // Two routes overlap if a service of one route is in the granular neighborhood of a service of the other
+	void preprocessInsertions (Route * R1, Route * R2) ; // Best insertion positions in R2 of the services of R1, and cost of R1 after their removal
+	double evalRemoveInsert (Noeud * U, Noeud * V, Noeud * place) ; // Cost of the route of U, when U is replaced by V inserted after "place"
+	vector < SS_insertions > ssInsertions ; // ssInsertions[i] : three best insertion positions of service i in the other route
+	vector < double > ssRemoval ; // ssRemoval[i] : cost of the route of service i after its removal
+
 	// change the pattern of "client" if its possible to find a better pattern (PI)
 	int searchBetterPattern (int client);
 	void computeCoutInsertion(Noeud * client, int pattern) ; // subprocedures for PI
@@ -136,6 +178,7 @@ public:
 	int nbIntraSwap ;
 	int nbInter2Opt ;
 	int nbIntra2Opt ;
+	int nbSwapStar ;
 	int nbEjectionChains ;
 	int nbEjectionChainsNodes ;
 
@@ -158,6 +201,10 @@ public:
 	// main function for the RI procedure
 	int mutationSameDay (int day);
 
+	// evaluates the move of a neighbourhood of RI between the current nodes U and V (see Voisinage), unless it is skipped
+	// by the scheduling of the current LS (see NeighbourhoodScheduler.h), returns 1 if an improving move has been applied
+	int evaluer (int voisinage);
+
 	// main function for the PI procedure
 	int mutationDifferentDay ();
 
@@ -165,14 +212,23 @@ public:
 	// to avoid testing them again as long as nothing has been modified
 	void nodeTestedForEachRoute (int cli, int day);
 
-	/* O(n) VERSION OF EJECTION CHAINS */
+	/* GRANULAR VERSION OF EJECTION CHAINS */
 	// Picks a random order for the routes
 	// relies on some auxiliary graph structures to solve a shortest path sub-problem */
+	// the graph has one layer per non-empty route (sized by the length of the route), and its arcs only
+	// insert a service next to one of its close services (granular search restriction)
 	int ec_nbRoutes ;
-	vector < int > ec_nbElements ;
-	vector < vector < EC_element > > ejectionGraph ;
+	vector < int > ec_layer ; // layer of each route in the graph (-1 for an empty route)
+	vector < double > ec_prevCost ; // cost of the route of each layer before the chain
+	vector < EC_element > ec_elements ; // elements of all layers, stored layer after layer (at most one element per service and one depot per layer)
+	vector < EC_element * > ejectionGraph ; // first element of each layer in ec_elements (the depot node of the route)
+	vector < int > ec_taille ; // number of elements of each layer
 	bool ejectionChains (int day); 	// returns true in case of success of ejection
 
+	// extends the label of a service U to its insertion between "avant" and "apres" in a later layer,
+	// either closing the chain ("cible" is the depot node of the layer) or ejecting the service between them
+	inline void ecExtend (EC_element * labelU, Noeud * avant, Noeud * apres, EC_element * cible, Noeud * insertionPlace) ;
+
 	/* ROUTINES USED TO MODIFY THE SOLUTION, WHEN APPLYING A MOVE */
 
 	void insertNoeud(Noeud * U, Noeud * V) ; // Inserts client U after V
@@ -0,0 +1,495 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include "LowerBound.h"
+
+void CouplageParfait::updateSlack (int u, int x)
+{
+	if (!slack[x] || dist(g[u][x]) < dist(g[slack[x]][x]))
+		slack[x] = u ;
+}
+
+void CouplageParfait::setSlack (int x)
+{
+	slack[x] = 0 ;
+	for (int u = 1 ; u <= n ; u++)
+		if (g[u][x].w > 0 && st[u] != x && S[st[u]] == 0)
+			updateSlack(u,x);
+}
+
+void CouplageParfait::pushFile (int x)
+{
+	if (x <= n)
+	{
+		file.push(x);
+		return ;
+	}
+	for (int i = 0 ; i < (int)flower[x].size() ; i++)
+		pushFile(flower[x][i]);
+}
+
+void CouplageParfait::setSt (int x, int b)
+{
+	st[x] = b ;
+	if (x <= n) return ;
+	for (int i = 0 ; i < (int)flower[x].size() ; i++)
+		setSt(flower[x][i],b);
+}
+
+int CouplageParfait::getPr (int b, int xr)
+{
+	// position of the sub-blossom xr in the blossom b, the cycle being reversed such that this position is even
+	int pr = (int)(find(flower[b].begin(),flower[b].end(),xr) - flower[b].begin()) ;
+	if (pr % 2 == 1)
+	{
+		reverse(flower[b].begin() + 1,flower[b].end());
+		return (int)flower[b].size() - pr ;
+	}
+	return pr ;
+}
+
+void CouplageParfait::setMatch (int u, int v)
+{
+	mate[u] = g[u][v].v ;
+	if (u <= n) return ;
+	Arete e = g[u][v] ;
+	int xr = flowerFrom[u][e.u] ;
+	int pr = getPr(u,xr) ;
+	for (int i = 0 ; i < pr ; i++)
+		setMatch(flower[u][i],flower[u][i^1]);
+	setMatch(xr,v);
+	rotate(flower[u].begin(),flower[u].begin() + pr,flower[u].end());
+}
+
+void CouplageParfait::augment (int u, int v)
+{
+	int xnv ;
+	while (true)
+	{
+		xnv = st[mate[u]] ;
+		setMatch(u,v);
+		if (!xnv) return ;
+		setMatch(xnv,st[pa[xnv]]);
+		u = st[pa[xnv]] ;
+		v = xnv ;
+	}
+}
+
+int CouplageParfait::getLca (int u, int v)
+{
+	for (stamp++ ; u || v ; swap(u,v))
+	{
+		if (u == 0) continue ;
+		if (vis[u] == stamp) return u ;
+		vis[u] = stamp ;
+		u = st[mate[u]] ;
+		if (u) u = st[pa[u]] ;
+	}
+	return 0 ;
+}
+
+void CouplageParfait::addBlossom (int u, int lca, int v)
+{
+	int b = n + 1 ;
+	int xs ;
+	while (b <= nx && st[b]) b++ ;
+	if (b > nx) nx++ ;
+	lab[b] = 0 ;
+	S[b] = 0 ;
+	mate[b] = mate[lca] ;
+
+	// The blossom is the cycle formed by the paths from u and v to their common ancestor
+	flower[b].clear();
+	flower[b].push_back(lca);
+	for (int x = u, y ; x != lca ; x = st[pa[y]])
+	{
+		flower[b].push_back(x);
+		y = st[mate[x]] ;
+		flower[b].push_back(y);
+		pushFile(y);
+	}
+	reverse(flower[b].begin() + 1,flower[b].end());
+	for (int x = v, y ; x != lca ; x = st[pa[y]])
+	{
+		flower[b].push_back(x);
+		y = st[mate[x]] ;
+		flower[b].push_back(y);
+		pushFile(y);
+	}
+	setSt(b,b);
+
+	// Its edges are the best edges of its sub-blossoms
+	for (int x = 1 ; x <= nx ; x++)
+	{
+		g[b][x].w = 0 ;
+		g[x][b].w = 0 ;
+	}
+	for (int x = 1 ; x <= n ; x++)
+		flowerFrom[b][x] = 0 ;
+	for (int i = 0 ; i < (int)flower[b].size() ; i++)
+	{
+		xs = flower[b][i] ;
+		for (int x = 1 ; x <= nx ; x++)
+		{
+			if (g[b][x].w == 0 || dist(g[xs][x]) < dist(g[b][x]))
+			{
+				g[b][x] = g[xs][x] ;
+				g[x][b] = g[x][xs] ;
+			}
+		}
+		for (int x = 1 ; x <= n ; x++)
+			if (flowerFrom[xs][x]) flowerFrom[b][x] = xs ;
+	}
+	setSlack(b);
+}
+
+void CouplageParfait::expandBlossom (int b)
+{
+	int xs, xns ;
+	for (int i = 0 ; i < (int)flower[b].size() ; i++)
+		setSt(flower[b][i],flower[b][i]);
+
+	// The sub-blossoms on the even path from the entry of the tree to the base stay in the tree, the others become free
+	int xr = flowerFrom[b][g[b][pa[b]].u] ;
+	int pr = getPr(b,xr) ;
+	for (int i = 0 ; i < pr ; i += 2)
+	{
+		xs = flower[b][i] ;
+		xns = flower[b][i+1] ;
+		pa[xs] = g[xns][xs].u ;
+		S[xs] = 1 ;
+		S[xns] = 0 ;
+		slack[xs] = 0 ;
+		setSlack(xns);
+		pushFile(xns);
+	}
+	S[xr] = 1 ;
+	pa[xr] = pa[b] ;
+	for (int i = pr + 1 ; i < (int)flower[b].size() ; i++)
+	{
+		xs = flower[b][i] ;
+		S[xs] = -1 ;
+		setSlack(xs);
+	}
+	st[b] = 0 ;
+}
+
+bool CouplageParfait::onFoundEdge (const Arete & e)
+{
+	int u = st[e.u] ;
+	int v = st[e.v] ;
+	int nu, lca ;
+	if (S[v] == -1)
+	{
+		// v and its mate enter the tree
+		pa[v] = e.u ;
+		S[v] = 1 ;
+		nu = st[mate[v]] ;
+		slack[v] = 0 ;
+		slack[nu] = 0 ;
+		S[nu] = 0 ;
+		pushFile(nu);
+	}
+	else if (S[v] == 0)
+	{
+		// two even nodes : augmenting path between two trees, or new blossom in the same tree
+		lca = getLca(u,v) ;
+		if (!lca)
+		{
+			augment(u,v);
+			augment(v,u);
+			return true ;
+		}
+		addBlossom(u,lca,v);
+	}
+	return false ;
+}
+
+bool CouplageParfait::matching ()
+{
+	long long d ;
+	int u ;
+	for (int x = 1 ; x <= nx ; x++)
+	{
+		S[x] = -1 ;
+		slack[x] = 0 ;
+	}
+	file = queue <int> () ;
+	for (int x = 1 ; x <= nx ; x++)
+	{
+		if (st[x] == x && !mate[x])
+		{
+			pa[x] = 0 ;
+			S[x] = 0 ;
+			pushFile(x);
+		}
+	}
+	if (file.empty()) return false ;
+
+	while (true)
+	{
+		// Growing the alternating trees with the tight edges
+		while (!file.empty())
+		{
+			u = file.front() ;
+			file.pop();
+			if (S[st[u]] == 1) continue ;
+			for (int v = 1 ; v <= n ; v++)
+			{
+				if (g[u][v].w > 0 && st[u] != st[v])
+				{
+					if (dist(g[u][v]) == 0)
+					{
+						if (onFoundEdge(g[u][v])) return true ;
+					}
+					else
+						updateSlack(u,st[v]);
+				}
+			}
+		}
+
+		// Update of the dual variables
+		d = 4000000000000000000LL ;
+		for (int b = n + 1 ; b <= nx ; b++)
+			if (st[b] == b && S[b] == 1) d = min(d,lab[b]/2) ;
+		for (int x = 1 ; x <= nx ; x++)
+		{
+			if (st[x] == x && slack[x])
+			{
+				if (S[x] == -1) d = min(d,dist(g[slack[x]][x])) ;
+				else if (S[x] == 0) d = min(d,dist(g[slack[x]][x])/2) ;
+			}
+		}
+		for (int v = 1 ; v <= n ; v++)
+		{
+			if (S[st[v]] == 0)
+			{
+				if (lab[v] <= d) return false ;
+				lab[v] -= d ;
+			}
+			else if (S[st[v]] == 1)
+				lab[v] += d ;
+		}
+		for (int b = n + 1 ; b <= nx ; b++)
+		{
+			if (st[b] == b)
+			{
+				if (S[st[b]] == 0) lab[b] += d * 2 ;
+				else if (S[st[b]] == 1) lab[b] -= d * 2 ;
+			}
+		}
+
+		// New tight edges, and expansion of the odd blossoms whose dual variable reached zero
+		file = queue <int> () ;
+		for (int x = 1 ; x <= nx ; x++)
+			if (st[x] == x && slack[x] && st[slack[x]] != x && dist(g[slack[x]][x]) == 0)
+				if (onFoundEdge(g[slack[x]][x])) return true ;
+		for (int b = n + 1 ; b <= nx ; b++)
+			if (st[b] == b && S[b] == 1 && lab[b] == 0)
+				expandBlossom(b);
+	}
+	return false ;
+}
+
+long long CouplageParfait::resoudre (const vector < vector <long long> > & couts)
+{
+	n = (int)couts.size() ;
+	nx = n ;
+	stamp = 0 ;
+	if (n == 0) return 0 ;
+
+	// The weights of the maximum-weight matching : with base > (n/2) * (maximum cost), any perfect matching is heavier than any other matching,
+	// and the heaviest perfect matching is the one of minimum cost
+	long long coutMax = 0 ;
+	for (int u = 0 ; u < n ; u++)
+		for (int v = 0 ; v < n ; v++)
+			coutMax = max(coutMax,couts[u][v]) ;
+	long long base = coutMax * (n/2) + 1 ;
+	long long wMax = 0 ;
+
+	g = vector < vector <Arete> > (2*n+1, vector <Arete> (2*n+1)) ;
+	for (int u = 0 ; u <= 2*n ; u++)
+	{
+		for (int v = 0 ; v <= 2*n ; v++)
+		{
+			g[u][v].u = u ;
+			g[u][v].v = v ;
+			g[u][v].w = (u >= 1 && u <= n && v >= 1 && v <= n && u != v) ? base - couts[u-1][v-1] : 0 ;
+			wMax = max(wMax,g[u][v].w) ;
+		}
+	}
+	lab = vector <long long> (2*n+1,0) ;
+	mate = vector <int> (2*n+1,0) ;
+	slack = vector <int> (2*n+1,0) ;
+	st = vector <int> (2*n+1,0) ;
+	pa = vector <int> (2*n+1,0) ;
+	S = vector <int> (2*n+1,-1) ;
+	vis = vector <int> (2*n+1,0) ;
+	flower = vector < vector <int> > (2*n+1) ;
+	flowerFrom = vector < vector <int> > (2*n+1, vector <int> (n+1,0)) ;
+	for (int u = 1 ; u <= n ; u++)
+	{
+		st[u] = u ;
+		flowerFrom[u][u] = u ;
+		lab[u] = wMax ;
+	}
+
+	int nbCouples = 0 ;
+	while (matching())
+		nbCouples ++ ;
+	if (n % 2 == 1 || nbCouples != n/2)
+		throw string("ERROR : no perfect matching found in the computation of the lower bound");
+
+	long long total = 0 ;
+	for (int u = 1 ; u <= n ; u++)
+		if (mate[u] && mate[u] < u) total += couts[u-1][mate[u]-1] ;
+	return total ;
+}
+
+double LowerBound::calcul (Params * params)
+{
+	// Problems covered : single period, distance objective, and no turn penalties
+	if ((params->type != 30 && params->type != 31 && params->type != 33) || params->periodique || params->isTurnPenalties)
+		return 0. ;
+
+	int nbNoeuds = (int)params->ar_distanceNodes.size() - 1 ;
+	const double infini = 1.e19 ;
+
+	// Service costs, and degrees of the nodes in the graph of the required edges and arcs
+	double coutServices = 0. ;
+	vector <int> degre (nbNoeuds + 1,0) ;
+	for (int i = params->nbDepots ; i < params->nbDepots + params->nbClients ; i++)
+	{
+		coutServices += min(params->cli[i].ar_serviceCost01,params->cli[i].ar_serviceCost10) ;
+		if (params->cli[i].ar_nodeType == AR_CLIENT_EDGE || params->cli[i].ar_nodeType == AR_CLIENT_ARC)
+		{
+			degre[params->cli[i].ar_nodesExtr0] ++ ;
+			degre[params->cli[i].ar_nodesExtr1] ++ ;
+		}
+	}
+
+	// Shortest paths where the arcs can be traversed in both directions : a deadheading walk between two nodes of odd degree
+	// may alternate the directions of its arcs (the same as the shortest paths when the network is undirected)
+	bool isSymetrique = true ;
+	for (int i = 1 ; i <= nbNoeuds && isSymetrique ; i++)
+		for (int j = 1 ; j < i && isSymetrique ; j++)
+			if (params->ar_distanceNodes[i][j] != params->ar_distanceNodes[j][i]) isSymetrique = false ;
+	vector < vector <double> > distancesNonOrientees ;
+	if (!isSymetrique)
+	{
+		distancesNonOrientees = vector < vector <double> > (nbNoeuds + 1, vector <double> (nbNoeuds + 1)) ;
+		for (int i = 1 ; i <= nbNoeuds ; i++)
+			for (int j = 1 ; j <= nbNoeuds ; j++)
+				distancesNonOrientees[i][j] = min(params->ar_distanceNodes[i][j],params->ar_distanceNodes[j][i]) ;
+		for (int k = 1 ; k <= nbNoeuds ; k++)
+			for (int i = 1 ; i <= nbNoeuds ; i++)
+				for (int j = 1 ; j <= nbNoeuds ; j++)
+					if (distancesNonOrientees[i][k] + distancesNonOrientees[k][j] < distancesNonOrientees[i][j])
+						distancesNonOrientees[i][j] = distancesNonOrientees[i][k] + distancesNonOrientees[k][j] ;
+	}
+	const vector < vector <double> > & delta = isSymetrique ? params->ar_distanceNodes : distancesNonOrientees ;
+
+	// The depots are merged into a single node
+	vector <bool> isDepot (nbNoeuds + 1,false) ;
+	vector <int> depots ;
+	int degreDepots = 0 ;
+	for (int d = 0 ; d < params->nbDepots ; d++)
+	{
+		if (isDepot[params->cli[d].ar_nodesExtr0]) continue ;
+		isDepot[params->cli[d].ar_nodesExtr0] = true ;
+		depots.push_back(params->cli[d].ar_nodesExtr0);
+		degreDepots += degre[params->cli[d].ar_nodesExtr0] ;
+	}
+
+	// Nodes of odd degree, and their distance to the closest depot
+	vector <int> impairs ;
+	vector <double> distanceDepot ;
+	double dMin ;
+	for (int i = 1 ; i <= nbNoeuds ; i++)
+	{
+		if (isDepot[i] || degre[i] % 2 == 0) continue ;
+		dMin = infini ;
+		for (int d = 0 ; d < (int)depots.size() ; d++)
+			dMin = min(dMin,delta[i][depots[d]]) ;
+		impairs.push_back(i);
+		distanceDepot.push_back(dMin);
+	}
+
+	// Minimum number of arrivals of the deadheading at the depots : each of the K routes leaves and returns to its depot,
+	// with the same parity as the degree of the depots
+	int nbMinRoutes = 1 ;
+	if (params->vehicleCapacity > 0)
+		nbMinRoutes = max(1,(int)ceil(params->totalDemand / params->vehicleCapacity - 0.0001)) ;
+	int nbArrivees = max(0,2*nbMinRoutes - degreDepots) ;
+	if ((nbArrivees + degreDepots) % 2 == 1) nbArrivees ++ ;
+
+	// Cost of a deadheading walk from a depot to a depot : a return trip to another node, or a path between two depots
+	double coutDepotDepot = infini ;
+	for (int d = 0 ; d < (int)depots.size() ; d++)
+		for (int i = 1 ; i <= nbNoeuds ; i++)
+			if (i != depots[d])
+				coutDepotDepot = min(coutDepotDepot,isDepot[i] ? delta[depots[d]][i] : 2. * delta[depots[d]][i]) ;
+
+	// Elements of the matching : the nodes of odd degree, the mandatory arrivals at the depots, and optional arrivals
+	// (the optional arrivals which are not used are matched together at no cost). The number of nodes of odd degree has the
+	// parity of the degree of the depots, hence of nbArrivees, and an even number of optional arrivals is always sufficient
+	int nbImpairs = (int)impairs.size() ;
+	int nbOptionnelles = nbImpairs - nbImpairs % 2 ;
+	int nbElements = nbImpairs + nbArrivees + nbOptionnelles ;
+	for (int a = 0 ; a < nbImpairs ; a++)
+		if (distanceDepot[a] >= infini) return 0. ; // Network which is not connected
+	if (nbArrivees > 0 && coutDepotDepot >= infini) return 0. ;
+
+	double coutDeadheading = 0. ;
+	if (nbElements > nbNoeudsMax)
+	{
+		// Beyond nbNoeudsMax elements, each element is only charged with half of the cost of its cheapest pair
+		double dMinDepot = infini ;
+		for (int a = 0 ; a < nbImpairs ; a++)
+		{
+			dMin = distanceDepot[a] ;
+			for (int b = 0 ; b < nbImpairs ; b++)
+				if (b != a) dMin = min(dMin,delta[impairs[a]][impairs[b]]) ;
+			coutDeadheading += 0.5 * dMin ;
+			dMinDepot = min(dMinDepot,distanceDepot[a]) ;
+		}
+		coutDeadheading += 0.5 * nbArrivees * min(dMinDepot,coutDepotDepot) ;
+	}
+	else
+	{
+		// The costs are rounded down to integers, after a scaling which keeps three decimals
+		vector < vector <long long> > couts (nbElements, vector <long long> (nbElements,0)) ;
+		double coutPaire ;
+		for (int a = 0 ; a < nbElements ; a++)
+		{
+			for (int b = 0 ; b < nbElements ; b++)
+			{
+				if (a == b) continue ;
+				if (a < nbImpairs && b < nbImpairs) coutPaire = delta[impairs[a]][impairs[b]] ;
+				else if (a < nbImpairs) coutPaire = distanceDepot[a] ;
+				else if (b < nbImpairs) coutPaire = distanceDepot[b] ;
+				else if (a >= nbImpairs + nbArrivees && b >= nbImpairs + nbArrivees) coutPaire = 0. ;
+				else coutPaire = coutDepotDepot ;
+				couts[a][b] = (long long)floor(coutPaire * 1000. + 0.000001) ;
+			}
+		}
+		CouplageParfait couplage ;
+		coutDeadheading = (double)couplage.resoudre(couts) / 1000. ;
+	}
+	return coutServices + coutDeadheading ;
+}
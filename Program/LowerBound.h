@@ -0,0 +1,117 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef LOWERBOUND_H
+#define LOWERBOUND_H
+
+#include <vector>
+#include <queue>
+#include "Params.h"
+using namespace std ;
+
+// Minimum-cost perfect matching on a complete graph with integer costs, with the blossom algorithm of Edmonds (O(n^3))
+// The algorithm searches a matching of maximum weight, the weights being chosen such that such a matching is perfect
+class CouplageParfait
+{
+
+private:
+
+	// edge of the graph, between two nodes or blossoms (represented by one of the original edges between them)
+	struct Arete {
+		int u ;
+		int v ;
+		long long w ;
+	};
+
+	// number of nodes (numbered from 1), and number of nodes and blossoms (numbered from n+1)
+	int n ;
+	int nx ;
+
+	// weights of the edges between the nodes and blossoms
+	vector < vector <Arete> > g ;
+
+	// dual variables (twice the usual values, to stay with integers)
+	vector <long long> lab ;
+
+	// mate of each node or blossom, node or blossom giving the smallest slack, outermost blossom containing each node or blossom,
+	// predecessor in the alternating tree, label in the tree (-1 free, 0 even, 1 odd), and stamps of the search of common ancestors
+	vector <int> mate ;
+	vector <int> slack ;
+	vector <int> st ;
+	vector <int> pa ;
+	vector <int> S ;
+	vector <int> vis ;
+	int stamp ;
+
+	// nodes and sub-blossoms of each blossom, in cyclic order from its base
+	vector < vector <int> > flower ;
+
+	// flowerFrom[b][x] : sub-blossom of b containing the node x
+	vector < vector <int> > flowerFrom ;
+
+	// even nodes whose edges remain to be scanned
+	queue <int> file ;
+
+	// reduced cost of an edge (zero if the edge is tight)
+	inline long long dist (const Arete & e) {return lab[e.u] + lab[e.v] - e.w * 2 ;}
+
+	// operations of the algorithm, on the alternating trees and the blossoms
+	void updateSlack (int u, int x) ;
+	void setSlack (int x) ;
+	void pushFile (int x) ;
+	void setSt (int x, int b) ;
+	int getPr (int b, int xr) ;
+	void setMatch (int u, int v) ;
+	void augment (int u, int v) ;
+	int getLca (int u, int v) ;
+	void addBlossom (int u, int lca, int v) ;
+	void expandBlossom (int b) ;
+	bool onFoundEdge (const Arete & e) ;
+
+	// one augmentation of the matching, returns false if there is no augmenting path
+	bool matching () ;
+
+public:
+
+	// minimum cost of a perfect matching of the nodes 0..N-1 (the costs are symmetric and non-negative, N is even)
+	long long resoudre (const vector < vector <long long> > & couts) ;
+};
+
+// Lower bound on the distance of the solutions of the CARP, NEARP and MDCARP, computed at the start of the resolution
+// The routes are closed walks from the depots : together, they traverse each required edge or arc, and each node has an even degree.
+// The deadheading must therefore connect by pairs the nodes of odd degree in the graph of the required edges and arcs,
+// and reach the depots at least 2K times, with K = ceil(total demand / capacity), minus the required edges incident to the depots.
+// The bound is the sum of the service costs, plus a minimum-cost perfect matching between the nodes of odd degree
+// and the arrivals at the depots (the depots being merged into a single node), with the costs of the shortest paths
+// where the arcs can be traversed in both directions (matching bound on the deadheading).
+class LowerBound
+{
+
+public:
+
+	// maximum number of nodes of the matching problem : the bound is reduced to the nearest-neighbour bound of the matching beyond this size
+	static const int nbNoeudsMax = 600 ;
+
+	// computes the bound for the instance of params, returns 0 for the problems which are not covered (PCARP, MM-kWRPP, turn penalties)
+	static double calcul (Params * params) ;
+
+	// says if a distance reaches a lower bound (not if the bound is 0, not computed), up to the rounding of the bound
+	static bool isAtteinte (double distance, double borne) {return (borne > 0. && distance <= borne + 0.001) ;}
+};
+
+#endif
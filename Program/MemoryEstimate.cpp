@@ -0,0 +1,201 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include "MemoryEstimate.h"
+#include "Individu.h"
+#include "LocalSearch.h"
+#include <sys/resource.h>
+
+double MemoryEstimate::bloc (double taille)
+{
+	// malloc adds a header of 8 bytes to each block, rounded to 16 bytes, with a minimum of 32 bytes
+	if (taille <= 0.) return 0. ;
+	return max(32.,16. * ceil((taille + 8.) / 16.)) ;
+}
+
+double MemoryEstimate::tailleSeqData (Params * params)
+{
+	double taille = (double)sizeof(SeqData) ;
+	#ifndef TURN_PENALTIES
+	// bestCostArcs : 2 x 2 empty paths
+	taille += 3. * bloc(2. * sizeof(vector < pair<int,int> >)) ;
+	#else
+	// bestCost, distanceTemp, distanceTemp2, and bestCostArcs (m x m empty paths), with m the maximum number of modes
+	double m = params->ar_maxNbModes ;
+	taille += bloc(m * sizeof(vector <double>)) + m * bloc(m * sizeof(double)) + 2. * bloc(m * sizeof(double)) ;
+	taille += bloc(m * sizeof(vector < pair<int,int> >)) + m * bloc(m * sizeof(vector < pair<int,int> >)) ;
+	#endif
+	return taille ;
+}
+
+void MemoryEstimate::ajoute (string nom, double taille, bool isAllouee)
+{
+	noms.push_back(nom);
+	octets.push_back(taille);
+	isAllouees.push_back(isAllouee);
+}
+
+void MemoryEstimate::calcul (Params * params)
+{
+	int nbNoeuds = params->nbClients + params->nbDepots ;
+	int nbDays = params->nbDays ;
+	int nbLocalSearch = 2 ; // the trainer of the population, and the offspring of the HGA
+	double taille, tailleIndividu ;
+	noms.clear();
+	octets.clear();
+	isAllouees.clear();
+
+	// Memory already used : the peak resident size until now (the data of the instance has just been built)
+	struct rusage usage ;
+	getrusage(RUSAGE_SELF,&usage);
+	octetsUtilises = 1024. * (double)usage.ru_maxrss ;
+
+	/* DATA OF THE INSTANCE (already allocated, included in the memory already used) */
+
+	taille = bloc(params->ar_distanceNodes.size() * sizeof(vector <double>)) ;
+	for (int i=0 ; i < (int)params->ar_distanceNodes.size() ; i++)
+		taille += bloc(params->ar_distanceNodes[i].capacity() * sizeof(double)) ;
+	ajoute("shortest paths between the nodes",taille,true);
+
+	if (!params->ar_distanceArcs.empty())
+	{
+		taille = bloc(params->ar_distanceArcs.size() * sizeof(vector <double>)) ;
+		for (int i=0 ; i < (int)params->ar_distanceArcs.size() ; i++)
+			taille += bloc(params->ar_distanceArcs[i].capacity() * sizeof(double)) ;
+		ajoute("shortest paths between the arcs (turn penalties)",taille,true);
+	}
+
+	ajoute("distances between the services (timeCost)",bloc((nbNoeuds+1) * sizeof(double *)) + (nbNoeuds+1) * bloc((nbNoeuds+1) * sizeof(double)),true);
+
+	taille = bloc(params->isCorrelated.size() * sizeof(vector <bool>)) ;
+	for (int i=0 ; i < (int)params->isCorrelated.size() ; i++)
+		taille += bloc(8. * ceil(params->isCorrelated[i].size() / 64.)) ;
+	ajoute("close services of the granular search (isCorrelated)",taille,true);
+
+	/* STRUCTURES OF THE SEARCH (to be allocated) */
+
+	// Split : the trainer, the offspring and a temporary individual (random individual or restart), and the other working individuals of the HGA
+	int nbComplets = params->isIndividusAlleges ? 3 : 8 ;
+	int maxVehicules = 0 ;
+	for (int k=0 ; k <= nbDays ; k++)
+		maxVehicules = max(maxVehicules,params->nombreVehicules[k]) ;
+	taille = bloc((nbNoeuds+1) * sizeof(SeqData *)) + (nbNoeuds+2) * bloc(tailleSeqData(params)) ;
+	taille += bloc((maxVehicules+1) * sizeof(vector <CoutSol>)) + (maxVehicules+1) * bloc((nbNoeuds+1) * sizeof(CoutSol)) ;
+	taille += bloc((nbDays+1) * sizeof(vector < vector <int> >)) ;
+	for (int k=0 ; k <= nbDays ; k++)
+		taille += bloc((params->nombreVehicules[k]+1) * sizeof(vector <int>)) + (params->nombreVehicules[k]+1) * bloc((nbNoeuds+2) * sizeof(int)) ;
+	taille += bloc(nbNoeuds * sizeof(vector <CoutSol>)) + nbNoeuds * bloc((nbNoeuds+1) * sizeof(CoutSol)) ;
+	ajoute("Split structures (" + to_string(nbComplets) + " complete individuals)",nbComplets * taille,false);
+
+	// Local searches : SeqData of the subsequences of the routes, for each node which can be visited on its day
+	int nbNoeudsVisitables = 2*params->nbVehiculesPerDep*nbDays ;
+	for (int k=1 ; k <= nbDays ; k++)
+		for (int i=0 ; i < nbNoeuds ; i++)
+			if (params->estVisitable(i,k)) nbNoeudsVisitables ++ ;
+	double nbSeqDatas = (double)(2*params->sizeSD + 4) * nbNoeudsVisitables ;
+	taille = bloc(nbSeqDatas * sizeof(SeqData)) + nbSeqDatas * (tailleSeqData(params) - sizeof(SeqData)) ;
+	taille += nbNoeudsVisitables * 2. * bloc(params->sizeSD * sizeof(SeqData *)) ;
+	ajoute("SeqData of the local searches (sizeSD " + to_string(params->sizeSD) + ")",nbLocalSearch * taille,false);
+
+	// Local searches : nodes and routes, with the insertion costs of each service in each route
+	double tailleNoeuds = 0. ;
+	double tailleRoutes = 0. ;
+	double tailleInsertions = bloc(nbNoeuds * sizeof(vector <double>)) + bloc(nbNoeuds * sizeof(vector <Noeud *>)) ;
+	for (int i=0 ; i < nbNoeuds ; i++)
+		tailleInsertions += bloc(params->cli[i].visits.size() * sizeof(double)) + bloc(params->cli[i].visits.size() * sizeof(Noeud *)) ;
+	for (int k=1 ; k <= nbDays ; k++)
+	{
+		int nbVeh = params->nombreVehicules[k] ;
+		tailleNoeuds += bloc((nbNoeuds+1) * sizeof(Noeud)) + 2. * bloc(nbVeh * sizeof(Noeud)) ;
+		for (int i=0 ; i < nbNoeuds ; i++)
+			tailleNoeuds += 2. * bloc(params->cli[i].visits.size() * sizeof(double)) + 2. * bloc(params->cli[i].sommetsVoisinsAvant.size() * sizeof(int)) ;
+		tailleNoeuds += 2. * nbVeh * 2. * bloc(params->cli[0].visits.size() * sizeof(double)) ;
+		tailleRoutes += bloc(nbVeh * sizeof(Route)) ;
+		tailleRoutes += nbVeh * (tailleInsertions + bloc(8. * ceil(nbNoeuds / 64.)) + 3. * bloc(8. * ceil(nbVeh / 64.)) + 4. * bloc(params->landmarks.size() * sizeof(double))) ;
+	}
+	ajoute("nodes of the local searches",nbLocalSearch * tailleNoeuds,false);
+	ajoute("routes of the local searches, with the insertion costs (coutInsertionClient)",nbLocalSearch * tailleRoutes,false);
+
+	// Local searches : ejection chains, the layers share one buffer holding each service once and one depot per layer
+	taille = bloc((params->nbClients + params->nbVehiculesPerDep) * sizeof(EC_element)) + bloc(params->nbVehiculesPerDep * sizeof(EC_element *)) + bloc(params->nbVehiculesPerDep * sizeof(int)) ;
+	ajoute("ejection chains (ejectionGraph)",nbLocalSearch * taille,false);
+
+	// Population : the two subpopulations, with one additional individual before the selection of the survivors, and the complete individuals
+	// (chromosomes, tables of successors and predecessors, proximity lists)
+	int nbIndividus = 2 * (params->mu + params->lambda + 1) ;
+	tailleIndividu = bloc(sizeof(Individu)) + bloc(sizeof(LocalSearch)) ;
+	tailleIndividu += bloc((nbDays+1) * sizeof(vector <int>)) + (nbDays+1) * bloc(sizeof(int)) + params->nbTotalServices * sizeof(int) ;
+	tailleIndividu += bloc((nbDays+1) * sizeof(vector <int>)) ;
+	for (int k=0 ; k <= nbDays ; k++)
+		tailleIndividu += bloc(params->nombreVehicules[k] * sizeof(int)) ;
+	tailleIndividu += bloc(nbNoeuds * sizeof(pattern)) ;
+	tailleIndividu += 2. * (bloc(nbNoeuds * sizeof(vector <int>)) + nbNoeuds * bloc((nbDays+1) * sizeof(int))) ;
+	if (params->ancienNbDays > 1)
+		tailleIndividu += bloc((double)(nbDays+1) * nbNoeuds * sizeof(double)) ;
+	tailleIndividu += (params->mu + params->lambda + 1) * bloc(sizeof(proxData) + 2. * sizeof(void *)) ;
+	taille = nbIndividus * tailleIndividu ;
+	taille += 8 * (tailleIndividu + (nbDays+1) * bloc(nbNoeuds * sizeof(int)) + bloc(params->nbTotalServices * sizeof(int))) ;
+	ajoute("population (" + to_string(nbIndividus) + " individuals)",taille,false);
+}
+
+double MemoryEstimate::total ()
+{
+	double somme = octetsUtilises ;
+	for (int i=0 ; i < (int)octets.size() ; i++)
+		if (!isAllouees[i]) somme += octets[i] ;
+	return somme ;
+}
+
+void MemoryEstimate::affiche ()
+{
+	const double mo = 1024. * 1024. ;
+	streamsize precision = cout.precision(4) ;
+	cout << "----- MEMORY ESTIMATE (MB) -----" << endl ;
+	cout << "Memory already used (program and data of the instance) : " << octetsUtilises / mo << endl ;
+	for (int i=0 ; i < (int)noms.size() ; i++)
+		cout << (isAllouees[i] ? "   including " : "") << noms[i] << " : " << octets[i] / mo << endl ;
+	cout << "Projected peak memory : " << total() / mo << endl ;
+	cout.precision(precision);
+}
+
+bool MemoryEstimate::adapteBudget (Params * params, double budget)
+{
+	const double mo = 1024. * 1024. ;
+	bool isModifie = false ;
+	calcul(params);
+
+	// First, the working individuals which never run Split do not keep its structures (no effect on the search)
+	if (total() > budget && !params->isIndividusAlleges)
+	{
+		params->isIndividusAlleges = true ;
+		isModifie = true ;
+		calcul(params);
+	}
+
+	// Then, shorter subsequences in the local search (the evaluation of the moves concatenates more SeqData)
+	while (total() > budget && params->sizeSD > sizeSDMin)
+	{
+		params->sizeSD -- ;
+		isModifie = true ;
+		calcul(params);
+	}
+
+	if (total() > budget)
+		throw string("ERROR : the projected memory of the resolution (" + to_string((int)ceil(total() / mo)) + " MB) exceeds the budget given by -maxmem (" + to_string((int)(budget / mo)) + " MB)");
+	return isModifie ;
+}
@@ -0,0 +1,76 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef MEMORYESTIMATE_H
+#define MEMORYESTIMATE_H
+
+#include <string>
+#include <vector>
+#include "Params.h"
+using namespace std ;
+
+// Estimation of the memory of a resolution, computed once the instance is read and before the population is built,
+// and adaptation of the tunable structures to a memory budget (option -maxmem)
+// The sizes follow the allocations done by the constructors of Individu, LocalSearch, Route and Noeud, they have to be updated with these constructors.
+// Only the elements of the vectors are counted, not their unused capacity, which does not become resident memory in the large blocks.
+// The subproblems of the decomposition phase (Genetic::decomposition) are not counted, they are much smaller than the complete problem.
+class MemoryEstimate
+{
+
+private:
+
+	// size in memory of a block of "taille" bytes (header and alignment of malloc)
+	static double bloc (double taille) ;
+
+	// size of one SeqData with the memory of its vectors
+	static double tailleSeqData (Params * params) ;
+
+	// adds a structure to the estimate
+	void ajoute (string nom, double taille, bool isAllouee) ;
+
+public:
+
+	// smallest sizeSD : the nodes keep direct pointers to their subsequences of two and three services (see Noeud::setRemaining)
+	static const int sizeSDMin = 3 ;
+
+	// name and estimated size in bytes of each structure
+	vector <string> noms ;
+	vector <double> octets ;
+
+	// says if the structure is already allocated when the estimate is done (data of the instance)
+	vector <bool> isAllouees ;
+
+	// memory already used by the process when the estimate is done (program and data of the instance), in bytes
+	double octetsUtilises ;
+
+	// estimates the structures of a run of the HGA on the instance of params, with its current sizeSD and isIndividusAlleges
+	void calcul (Params * params) ;
+
+	// projected peak memory of the process, in bytes : the memory already used, and the structures which remain to be allocated
+	double total () ;
+
+	// prints the estimates
+	void affiche () ;
+
+	// adapts params to a memory budget in bytes : first the working individuals of the HGA are kept without the structures of Split,
+	// then sizeSD is reduced (which slows down the evaluation of the moves), throws an error if the budget can not be met
+	// returns true if params has been modified
+	bool adapteBudget (Params * params, double budget) ;
+};
+
+#endif
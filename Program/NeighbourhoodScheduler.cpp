@@ -0,0 +1,87 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include "NeighbourhoodScheduler.h"
+
+const char * NeighbourhoodScheduler::noms [NB_VOISINAGES] = {
+	"interRouteGeneralInsert",
+	"interRoute2Opt",
+	"interRoute2OptInv",
+	"intraRouteGeneralInsertDroite",
+	"intraRoute2Opt",
+	"swapStar",
+	"ejectionChains"
+};
+
+NeighbourhoodScheduler::NeighbourhoodScheduler ()
+{
+	isAdaptatif = false ;
+	facteurOubli = 0.95 ;
+	fractionMin = 0.05 ;
+	evaluationsMin = 50 ;
+	for (int v=0 ; v < NB_VOISINAGES ; v++)
+	{
+		evaluationsRecentes[v] = 0. ;
+		succesRecents[v] = 0. ;
+		nbEvaluations[v] = 0 ;
+		nbSucces[v] = 0 ;
+		nbIgnores[v] = 0 ;
+		isActif[v] = true ;
+	}
+	for (int k=0 ; k < NB_VOISINAGES_INTER ; k++)
+		ordreInter[k] = k ;
+}
+
+double NeighbourhoodScheduler::taux (int voisinage)
+{
+	return (evaluationsRecentes[voisinage] > 0.) ? succesRecents[voisinage] / evaluationsRecentes[voisinage] : 0. ;
+}
+
+void NeighbourhoodScheduler::debutRecherche ()
+{
+	if (!isAdaptatif) return ;
+
+	// Decay of the recent statistics
+	for (int v=0 ; v < NB_VOISINAGES ; v++)
+	{
+		evaluationsRecentes[v] *= facteurOubli ;
+		succesRecents[v] *= facteurOubli ;
+	}
+
+	// Best rate of each group : the neighbourhoods of pairs of nodes, and the procedures SWAP* and ejection chains
+	// (their evaluations do not have the same granularity, and their rates are not comparable)
+	double meilleurPaires = 0. ;
+	double meilleurProcedures = 0. ;
+	for (int v=0 ; v < NB_VOISINAGES ; v++)
+	{
+		if (evaluationsRecentes[v] < evaluationsMin) continue ;
+		if (v < VOIS_SWAP_STAR) meilleurPaires = max(meilleurPaires,taux(v)) ;
+		else meilleurProcedures = max(meilleurProcedures,taux(v)) ;
+	}
+
+	// A neighbourhood is skipped if it has enough recent evaluations, and a rate far below the best one of its group
+	for (int v=0 ; v < NB_VOISINAGES ; v++)
+		isActif[v] = (evaluationsRecentes[v] < evaluationsMin || taux(v) >= fractionMin * ((v < VOIS_SWAP_STAR) ? meilleurPaires : meilleurProcedures)) ;
+
+	// The inter-route neighbourhoods are tested by decreasing rate (the fixed order in case of equality)
+	for (int k=0 ; k < NB_VOISINAGES_INTER ; k++)
+		ordreInter[k] = k ;
+	for (int k=1 ; k < NB_VOISINAGES_INTER ; k++)
+		for (int j=k ; j > 0 && taux(ordreInter[j]) > taux(ordreInter[j-1]) ; j--)
+			swap(ordreInter[j],ordreInter[j-1]) ;
+}
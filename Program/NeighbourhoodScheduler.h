@@ -0,0 +1,104 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef NEIGHBOURHOODSCHEDULER_H
+#define NEIGHBOURHOODSCHEDULER_H
+
+#include <algorithm>
+using namespace std ;
+
+// Neighbourhoods of the route improvement (RI) of the local search, in the order of the operators of the profiler (see Profiler.h)
+enum Voisinage {
+	VOIS_INTER_INSERT, // LocalSearch::interRouteGeneralInsert
+	VOIS_INTER_2OPT, // LocalSearch::interRoute2Opt
+	VOIS_INTER_2OPT_INV, // LocalSearch::interRoute2OptInv
+	VOIS_INTRA_INSERT, // LocalSearch::intraRouteGeneralInsertDroite
+	VOIS_INTRA_2OPT, // LocalSearch::intraRoute2Opt
+	VOIS_SWAP_STAR, // LocalSearch::swapStar, for a pair of routes
+	VOIS_EJECTION_CHAINS, // LocalSearch::ejectionChains, for a day
+	NB_VOISINAGES
+};
+
+// number of inter-route neighbourhoods, tested one after the other for each pair of nodes (U,V) in different routes
+#define NB_VOISINAGES_INTER 3
+
+// Scheduling of the neighbourhoods of RI (one for each Params, shared by the local searches of the population and of the offspring)
+// The number of evaluations and of improving moves of each neighbourhood are always counted (statistics of the resolution).
+// When the scheduling is adaptive, the neighbourhoods are chosen at the start of each LS from their recent success rates
+// (improving moves per evaluation, with an exponential decay) : the inter-route neighbourhoods are tested by decreasing rate,
+// and a neighbourhood whose rate is far below the best rate of its group (pairs of nodes, or routes and days for SWAP* and the ejection chains)
+// is skipped during this LS. Its recent evaluations decay meanwhile, until they are too few to judge it : it is then tested again (exploration).
+// Otherwise, all neighbourhoods are tested in the fixed order, and the search is unchanged.
+class NeighbourhoodScheduler
+{
+
+public:
+
+	// says if the scheduling is adaptive
+	bool isAdaptatif ;
+
+	// decay of the recent statistics at the start of each LS
+	double facteurOubli ; // Default 0.95
+
+	// a neighbourhood is skipped when its success rate is below this fraction of the best rate of its group
+	double fractionMin ; // Default 0.05
+
+	// minimum number of recent evaluations of a neighbourhood to compare its rate (otherwise it is tested)
+	double evaluationsMin ; // Default 50
+
+	// recent evaluations and improving moves of each neighbourhood (decayed at the start of each LS)
+	double evaluationsRecentes [NB_VOISINAGES] ;
+	double succesRecents [NB_VOISINAGES] ;
+
+	// totals of the resolution : evaluations, improving moves, and evaluations skipped by the adaptive scheduling
+	long long nbEvaluations [NB_VOISINAGES] ;
+	long long nbSucces [NB_VOISINAGES] ;
+	long long nbIgnores [NB_VOISINAGES] ;
+
+	// neighbourhoods tested during the current LS
+	bool isActif [NB_VOISINAGES] ;
+
+	// order of the inter-route neighbourhoods during the current LS
+	int ordreInter [NB_VOISINAGES_INTER] ;
+
+	// names of the neighbourhoods, as written in the statistics
+	static const char * noms [NB_VOISINAGES] ;
+
+	// records an evaluation of a neighbourhood
+	inline void enregistrer (int voisinage, bool isSucces)
+	{
+		evaluationsRecentes[voisinage] += 1. ;
+		nbEvaluations[voisinage] ++ ;
+		if (isSucces)
+		{
+			succesRecents[voisinage] += 1. ;
+			nbSucces[voisinage] ++ ;
+		}
+	}
+
+	// chooses the neighbourhoods and their order for a new LS (does nothing if the scheduling is not adaptive)
+	void debutRecherche () ;
+
+	// recent success rate of a neighbourhood
+	double taux (int voisinage) ;
+
+	// constructor, all neighbourhoods are tested in the fixed order
+	NeighbourhoodScheduler ();
+};
+
+#endif
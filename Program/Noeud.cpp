@@ -50,6 +50,7 @@ Noeud::Noeud(Noeud const& copy)
 	coutInsertion = copy.coutInsertion ;
 	placeInsertion = copy.placeInsertion ;
 	moves = copy.moves ;
+	movesRang = copy.movesRang ;
 }
 
 Noeud& Noeud::operator=(Noeud const& copy)
@@ -67,6 +68,7 @@ Noeud& Noeud::operator=(Noeud const& copy)
 	coutInsertion = copy.coutInsertion ;
 	placeInsertion = copy.placeInsertion ;
 	moves = copy.moves ;
+	movesRang = copy.movesRang ;
 	return *this;
 }
 
@@ -85,6 +85,9 @@ vector < Noeud * > placeInsertion ;
 // possible moves for this customer and this day (granular search)
 vector < int > moves ;
 
+// rank of each of these customers in the list of close customers (see Params::voisinsClasses)
+vector < int > movesRang ;
+
 // constructor 1
 Noeud(void);
 	
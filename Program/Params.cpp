@@ -17,6 +17,9 @@
 //  ---------------------------------------------------------------------- */
 
 #include "Params.h"
+#include "BinaryIO.h"
+
+char Params::etatRNG [128] ;
 
 void Params::setMethodParams()
 {
@@ -29,6 +32,10 @@ void Params::setMethodParams()
 
 	nbCountDistMeasure = 3 ; // Number of close individuals considered in the distance measure (diversity management)
 	granularity = 40 ; // Restriction of the LS moves to 40 closest nodes
+	granulariteMin = 15 ; // The list of close nodes of each node can shrink down to 15 nodes, depending on the ranks of the improving moves
+	periodeAdaptation = 100 ; // Adaptation of the lists of close nodes every 100 LS
+	couvertureSucces = 0.99 ; // The list of close nodes of each node should contain the neighbours of 99% of its recent improving moves
+	isGranulariteAdaptative = false ; // The adaptation of the lists of close nodes is only done when requested (by the Solver)
 	minValides = 0.15 ; // Target proportion of feasible solution
 	maxValides = 0.20 ; // Target proportion of feasible solution
 	penalityCapa = 50 ; // Initial penalties (will evolve during the search)
@@ -42,15 +49,11 @@ void Params::setMethodParams()
 void Params::preleveDonnees (string nomInstance)
 {
 	// Main method to read a problem instance
-	vector <Vehicle> tempI ;
-	double vc ;
-	string contenu, useless2 ;
 	nbTotalServices = 0 ;
 	totalDemand = 0 ;
 	multiDepot = false ;
 	periodique = false ;
 	isTurnPenalties = false ;
-	char * myChars = new char[100]; 
 
 	if (type == 30 || type == 33) // This is a standard CARP (can also be an experiment for MDCARP, when the number of depots is defined to be greater than 1)
 	{
@@ -58,31 +61,27 @@ void Params::preleveDonnees (string nomInstance)
 			multiDepot = true ;
 
 		// Reading all lines one by one
-		getline(fichier, contenu); 
-		getline(fichier, contenu);
-		fichier >> useless2 ;
-		fichier >> useless2 ;
+		fichier.skipLine(); 
+		fichier.skipLine();
+		fichier.skipWord();
+		fichier.skipWord();
 		fichier >> ar_NodesNonRequired ;
-		fichier >> useless2 ;
-		fichier >> useless2 ;
+		fichier.skipWord();
+		fichier.skipWord();
 		fichier >> ar_EdgesRequired ;
-		fichier >> useless2 ;
-		fichier >> useless2 ;
+		fichier.skipWord();
+		fichier.skipWord();
 		fichier >> ar_EdgesNonRequired ;
-		fichier >> useless2 ;
-		fichier >> useless2 ;
-		fichier >> nbVehiculesPerDep ;
-
-		// The instance only provides a lower bound on the necessary number of vehicles, per definition of the CARP, more vehicles are allowed (here we put one more)
-		// Still, in all solutions the minimum number of vehicles turned out to be used
-		nbVehiculesPerDep ++ ; 
-		fichier >> useless2 ;
-		fichier >> useless2 ;
-		fichier >> vc ;
-		getline(fichier, contenu);
-		getline(fichier, contenu);		
-		getline(fichier, contenu);
-		getline(fichier, contenu);
+		fichier.skipWord();
+		fichier.skipWord();
+		fichier >> nbVehiculesFichier ;
+		fichier.skipWord();
+		fichier.skipWord();
+		fichier >> vehicleCapacity ;
+		fichier.skipLine();
+		fichier.skipLine();		
+		fichier.skipLine();
+		fichier.skipLine();
 
 		ar_NodesRequired = 0 ;
 		ar_ArcsRequired = 0 ;
@@ -92,45 +91,38 @@ void Params::preleveDonnees (string nomInstance)
 	}
 	else if (type == 31) // This is the standard NEARP (also called MCGRP)
 	{
-		getline(fichier, contenu);
-		getline(fichier, contenu);
+		fichier.skipLine();
+		fichier.skipLine();
 		int nodesTotal;
 		int edgesTotal;
 		int arcsTotal;
-		fichier >> useless2 ;
-
-		// If the number of vehicles per depot has been specified in the commandline
-		// Otherwise we read it from the file (not always available, depending on the benchmark set)
-		if (nbVehiculesPerDep == -1)
-			fichier >> nbVehiculesPerDep ;
-		else 
-			fichier >> useless2 ;
-
-		fichier >> useless2 ;
-		fichier >> vc ;
-		fichier >> useless2 ;
-		fichier >> useless2 ;
+		fichier.skipWord();
+		fichier >> nbVehiculesFichier ;
+		fichier.skipWord();
+		fichier >> vehicleCapacity ;
+		fichier.skipWord();
+		fichier.skipWord();
 		fichier >> ar_tempIndexDepot ;
-		fichier >> useless2 ;
+		fichier.skipWord();
 		fichier >> nodesTotal ;
-		fichier >> useless2 ;
+		fichier.skipWord();
 		fichier >> edgesTotal ;
-		fichier >> useless2 ;
+		fichier.skipWord();
 		fichier >> arcsTotal ;
-		fichier >> useless2 ;
-		fichier >> useless2 ;
+		fichier.skipWord();
+		fichier.skipWord();
 		fichier >> ar_NodesRequired ;
-		fichier >> useless2 ;
-		fichier >> useless2 ;
+		fichier.skipWord();
+		fichier.skipWord();
 		fichier >> ar_EdgesRequired ;
-		fichier >> useless2 ;
-		fichier >> useless2 ;
+		fichier.skipWord();
+		fichier.skipWord();
 		fichier >> ar_ArcsRequired ;
 		ar_NodesNonRequired = nodesTotal - ar_NodesRequired ;
 		ar_EdgesNonRequired = edgesTotal - ar_EdgesRequired ;
 		ar_ArcsNonRequired  = arcsTotal - ar_ArcsRequired ;  
-		getline(fichier, contenu);
-		getline(fichier, contenu);
+		fichier.skipLine();
+		fichier.skipLine();
 
 		ar_InitializeDistanceNodes();
 	}
@@ -138,22 +130,21 @@ void Params::preleveDonnees (string nomInstance)
 	{	
 		periodique = true ;
 		// Reading all lines one by one
-		getline(fichier, contenu); // gets a complete line
-		fichier.getline(myChars,1000,'='); // This gets all the next characters until finding "="
+		fichier.skipLine(); // gets a complete line
+		fichier.skipUntil('='); // This gets all the next characters until finding "="
 		fichier >> ar_NodesNonRequired ;
-		fichier.getline(myChars,1000,'=');
-		fichier.getline(myChars,1000,'=');
+		fichier.skipUntil('=');
+		fichier.skipUntil('=');
 		fichier >> ar_EdgesRequired ;
-		fichier.getline(myChars,1000,'=');
-		fichier.getline(myChars,1000,'=');
-		if (nbVehiculesPerDep == -1) // Getting the number of vehicles per depot (in case was not specific in commandline)
-			fichier >> nbVehiculesPerDep ;
-		fichier.getline(myChars,1000,'=');
-		fichier >> vc ;
-		getline(fichier, contenu);
-		getline(fichier, contenu);
-		getline(fichier, contenu);
-		getline(fichier, contenu);
+		fichier.skipUntil('=');
+		fichier.skipUntil('=');
+		fichier >> nbVehiculesFichier ;
+		fichier.skipUntil('=');
+		fichier >> vehicleCapacity ;
+		fichier.skipLine();
+		fichier.skipLine();
+		fichier.skipLine();
+		fichier.skipLine();
 
 		ar_NodesRequired = 0 ;
 		ar_ArcsRequired = 0 ;
@@ -166,39 +157,39 @@ void Params::preleveDonnees (string nomInstance)
 	{
 		isTurnPenalties = true ;
 
-		getline(fichier, contenu);
-		fichier >> useless2 ;
-		fichier >> nbVehiculesPerDep ;
-		fichier >> useless2 ;
-		fichier >> vc ;
-		fichier >> useless2 ;
+		fichier.skipLine();
+		fichier.skipWord();
+		fichier >> nbVehiculesFichier ;
+		fichier.skipWord();
+		fichier >> vehicleCapacity ;
+		fichier.skipWord();
 		fichier >> ar_tempIndexDepot ;
 
 		int totalNodes ;
 		int totalEdges ;
 		int totalArcs ;
-		fichier >> useless2 ;
+		fichier.skipWord();
 		fichier >> totalNodes ;
-		fichier >> useless2 ;
+		fichier.skipWord();
 		fichier >> totalEdges ;
-		fichier >> useless2 ;
+		fichier.skipWord();
 		fichier >> totalArcs ;
-		fichier >> useless2 ;
+		fichier.skipWord();
 		fichier >> ar_NodesRequired ;
-		fichier >> useless2 ;
+		fichier.skipWord();
 		fichier >> ar_EdgesRequired ;
-		fichier >> useless2 ;
+		fichier.skipWord();
 		fichier >> ar_ArcsRequired ;
 
 		ar_NodesNonRequired = totalNodes - ar_NodesRequired ;
 		ar_EdgesNonRequired = totalEdges - ar_EdgesRequired ;
 		ar_ArcsNonRequired = totalArcs - ar_ArcsRequired ;
 
-		fichier >> useless2 ;
+		fichier.skipWord();
 		fichier >> ar_nbTurns ;
 
-		getline(fichier, contenu);
-		getline(fichier, contenu);
+		fichier.skipLine();
+		fichier.skipLine();
 
 		// Trying to detect if something went wrong when reading the instance
 		// These things could easily happen when specifying the wrong problem type for a given input data
@@ -213,20 +204,20 @@ void Params::preleveDonnees (string nomInstance)
 	}
 	else if (type == 35) // Min-Max WRPP, instance format of Angel Corberan
 	{
-		getline(fichier, contenu);
-		getline(fichier, contenu);
-		fichier >> useless2 ;
-		fichier >> useless2 ;
+		fichier.skipLine();
+		fichier.skipLine();
+		fichier.skipWord();
+		fichier.skipWord();
 		fichier >> ar_NodesNonRequired ;
-		fichier >> useless2 ;
-		fichier >> useless2 ;
+		fichier.skipWord();
+		fichier.skipWord();
 		fichier >> ar_EdgesRequired ;
-		fichier >> useless2 ;
-		fichier >> useless2 ;
+		fichier.skipWord();
+		fichier.skipWord();
 		fichier >> ar_EdgesNonRequired ;
-		getline(fichier, contenu);
-		getline(fichier, contenu);
-		vc = 10000 ; // There is no capacity limit in this problem.
+		fichier.skipLine();
+		fichier.skipLine();
+		vehicleCapacity = 10000 ; // There is no capacity limit in this problem.
 		ar_NodesRequired = 0 ;
 		ar_ArcsRequired = 0 ;
 		ar_ArcsNonRequired = 0 ;
@@ -243,7 +234,6 @@ void Params::preleveDonnees (string nomInstance)
 	nbClients = ar_ArcsRequired + ar_EdgesRequired + ar_NodesRequired ;
 
 	// Printing some warning in case of wrong use of the instances and parameters
-	if (nbVehiculesPerDep == -1) throw string ("WARNING : some type of instances do not specify a fleet size, please specify an upper bound manually using -veh XX in the commandline");
 	#ifdef TURN_PENALTIES
 	if (type != 34) throw string("When solving problem instances without turn penalties, please set the flag TURN_PENALTIES to false");
 	#else
@@ -256,23 +246,7 @@ void Params::preleveDonnees (string nomInstance)
 		throw string("ERROR WHEN READING : Number of services has not been correctly read. A very likely cause is the use of the wrong problem type for a given problem instance");
 
 	// Building the list of vehicles
-	ordreVehicules.push_back(tempI) ;
-	nombreVehicules.push_back(0);
-	dayCapacity.push_back(0);
-	for (int kk=1 ; kk <= nbDays; kk ++)
-	{
-		ordreVehicules.push_back(tempI) ;
-		dayCapacity.push_back(0);
-		nombreVehicules.push_back(nbDepots*nbVehiculesPerDep);
-		for (int i=0 ; i < nbDepots ; i++)
-		{
-			for (int j=0 ; j < nbVehiculesPerDep ; j++)
-			{
-				ordreVehicules[kk].push_back(Vehicle(i,1000000,vc)); // Duration constraint set to a high value
-				dayCapacity[kk] += vc ;
-			}
-		}
-	}
+	buildVehicles();
 
 	// Reading the list of customers 
 	// Not all instance formats follow this convention
@@ -303,6 +277,136 @@ void Params::preleveDonnees (string nomInstance)
 	}
 }
 
+void Params::preleveDonnees (const InstanceInput & instance)
+{
+	// Same data structures as when reading the instance files, with the services numbered after the depots in the order of the input
+	pattern p ;
+	p.dep = 0 ;
+	p.cost = 0 ;
+	p.pat = 1 ;
+	nbTotalServices = 0 ;
+	totalDemand = 0 ;
+	multiDepot = (type == 33) ;
+	periodique = (type == 32) ;
+	isTurnPenalties = false ;
+
+	if (type == 34) 
+		throw string ("The problems with turn penalties can only be read from an instance file");
+	if (type < 30 || type > 35) 
+		throw string ("Incorrect problem type");
+	if (nbDepots < 1 || (nbDepots > 1 && type != 33))
+		throw string ("The instance should have one depot (or several depots for the MDCARP)");
+	if (instance.nbNodes < 1 || instance.nbNodes > 1000000)
+		throw string ("Incorrect number of nodes in the instance");
+	if ((type == 30 || type == 33) && instance.nbVehicles < 1)
+		throw string ("The CARP and MDCARP instances should specify their number of vehicles (per depot)");
+
+	// Counting the nodes, edges and arcs
+	ar_NodesRequired = 0 ;
+	ar_EdgesRequired = 0 ;
+	ar_ArcsRequired = 0 ;
+	ar_EdgesNonRequired = 0 ;
+	ar_ArcsNonRequired = 0 ;
+	for (int s=0 ; s < (int)instance.services.size() ; s++)
+	{
+		const ServiceInput & service = instance.services[s] ;
+		if (service.node0 < 1 || service.node0 > instance.nbNodes || service.node1 < 1 || service.node1 > instance.nbNodes)
+			throw string ("Incorrect extremity of a service in the instance");
+		if (type == 32 && (service.freq < 1 || service.freq > 5))
+			throw string ("Incorrect frequency of a service in the instance, the PCARP allows one to five visits");
+		if (service.nodeType == AR_CLIENT_NODE) ar_NodesRequired ++ ;
+		else if (service.nodeType == AR_CLIENT_EDGE) ar_EdgesRequired ++ ;
+		else if (service.nodeType == AR_CLIENT_ARC) ar_ArcsRequired ++ ;
+		else throw string ("Incorrect type of service in the instance");
+	}
+	for (int l=0 ; l < (int)instance.links.size() ; l++)
+	{
+		const LinkInput & link = instance.links[l] ;
+		if (link.node0 < 1 || link.node0 > instance.nbNodes || link.node1 < 1 || link.node1 > instance.nbNodes)
+			throw string ("Incorrect extremity of a link in the instance");
+		if (link.isArc) ar_ArcsNonRequired ++ ;
+		else ar_EdgesNonRequired ++ ;
+	}
+	ar_NodesNonRequired = instance.nbNodes - ar_NodesRequired ;
+	ar_InitializeDistanceNodes();
+
+	// Setting the other instance parameters
+	if (type == 32) nbDays = 5 ; // PCARP instances are defined on 5 days
+	else nbDays = 1 ; // Other Instances
+	ancienNbDays = nbDays ;
+	nbClients = (int)instance.services.size() ;
+	nbVehiculesFichier = instance.nbVehicles ;
+	vehicleCapacity = (type == 35) ? 10000 : instance.capacity ; // There is no capacity limit in the MM-kWRPP
+
+	// Building the list of vehicles
+	buildVehicles();
+
+	// Depots
+	cli = new Client [nbDepots + nbClients] ;
+	for (int d=0 ; d < nbDepots ; d++)
+	{
+		if (instance.depots[d] < 1 || instance.depots[d] > instance.nbNodes)
+			throw string ("Incorrect depot node in the instance");
+		cli[d].custNum = d ;
+		cli[d].freq = 0 ;
+		cli[d].serviceDuration = 0 ;
+		cli[d].demand = 0 ;
+		cli[d].ar_nodeType = AR_DEPOT ;
+		cli[d].ar_nodesExtr0 = instance.depots[d] ;
+		cli[d].ar_nodesExtr1 = instance.depots[d] ;
+		cli[d].ar_serviceCost01 = 0. ;
+		cli[d].ar_serviceCost10 = 0. ;
+		cli[d].visits.push_back(p);
+		cli[d].visitsOrigin.push_back(p);
+	}
+
+	// Services
+	for (int s=0 ; s < nbClients ; s++)
+	{
+		const ServiceInput & service = instance.services[s] ;
+		Client * myCli = &cli[nbDepots + s] ;
+		myCli->custNum = nbDepots + s ;
+		myCli->freq = periodique ? service.freq : 1 ;
+		myCli->serviceDuration = 0 ;
+		myCli->demand = service.demand ;
+		myCli->ar_nodeType = service.nodeType ;
+		myCli->ar_nodesExtr0 = service.node0 ;
+		myCli->ar_nodesExtr1 = service.node1 ;
+		myCli->ar_serviceCost01 = service.serviceCost01 ;
+		myCli->ar_serviceCost10 = (service.nodeType == AR_CLIENT_ARC) ? 1.e20 : service.serviceCost10 ;
+		if (service.nodeType != AR_CLIENT_NODE)
+			ar_distanceNodes[service.node0][service.node1] = min(ar_distanceNodes[service.node0][service.node1],service.travelCost01) ;
+		if (service.nodeType == AR_CLIENT_EDGE)
+			ar_distanceNodes[service.node1][service.node0] = min(ar_distanceNodes[service.node1][service.node0],service.travelCost10) ;
+
+		// Same convention on the total demand as when reading the PCARP instances
+		if (periodique) totalDemand += 7.0 * myCli->demand ;
+		else totalDemand += myCli->demand ;
+
+		// Setting the pattern information (on which day the customer can be visited)
+		if (periodique) 
+			setPatterns_PCARP(myCli);
+		else
+		{
+			myCli->visits.push_back(p);
+			myCli->visitsOrigin.push_back(p);
+		}
+		nbTotalServices += myCli->freq ;
+	}
+
+	// Other links of the network
+	for (int l=0 ; l < (int)instance.links.size() ; l++)
+	{
+		const LinkInput & link = instance.links[l] ;
+		ar_distanceNodes[link.node0][link.node1] = min(ar_distanceNodes[link.node0][link.node1],link.cost01) ;
+		if (!link.isArc)
+			ar_distanceNodes[link.node1][link.node0] = min(ar_distanceNodes[link.node1][link.node0],link.cost10) ;
+	}
+
+	// Shortest paths
+	ar_computeDistancesNodes();
+}
+
 bool compPredicate(pairB i, pairB j) 
 { 
 	return (i.myparams->timeCost[i.myInt][i.iCour] < i.myparams->timeCost[j.myInt][i.iCour]) ;
@@ -358,14 +462,66 @@ void Params::calculeStructures ()
 		cli[i].computeVisitsDyn(nbDays,ancienNbDays);
 		cli[i].computeJourSuiv(nbDays,ancienNbDays);
 	}
+
+	calculeLandmarks();
+}
+
+void Params::calculeLandmarks ()
+{
+	// Radius of the list of close services of each service
+	granularRadius = vector <double> (nbClients + nbDepots, 0.) ;
+	for (int i=0 ; i < nbClients + nbDepots ; i++)
+		for (int j=0 ; j < (int)cli[i].sommetsVoisinsAvant.size() ; j++)
+			granularRadius[i] = max(granularRadius[i],timeCost[cli[i].sommetsVoisinsAvant[j]][i]);
+
+	// Span of each service
+	serviceSpan = vector <double> (nbClients + nbDepots, 0.) ;
+	for (int i=0 ; i < nbClients + nbDepots ; i++)
+	{
+		if (type == 34)
+		{
+			for (int ii=0 ; ii < (int)cli[i].ar_Modes.size() ; ii++)
+				for (int jj=0 ; jj < (int)cli[i].ar_Modes.size() ; jj++)
+					serviceSpan[i] = max(serviceSpan[i],ar_distanceArcs[cli[i].ar_Modes[ii]->indexArc][cli[i].ar_Modes[jj]->indexArc]);
+		}
+		else
+			serviceSpan[i] = max(ar_distanceNodes[cli[i].ar_nodesExtr0][cli[i].ar_nodesExtr1],ar_distanceNodes[cli[i].ar_nodesExtr1][cli[i].ar_nodesExtr0]);
+	}
+
+	// Landmarks chosen by farthest-first traversal, starting from the first depot
+	// (deterministic, to avoid any impact on the random number generator)
+	int nbLandmarks = min(8,nbClients) ;
+	vector <double> distLandmarks (nbClients + nbDepots) ;
+	landmarks.clear();
+	for (int i=nbDepots ; i < nbClients + nbDepots ; i++)
+		distLandmarks[i] = min(timeCost[0][i],timeCost[i][0]) ;
+	while ((int)landmarks.size() < nbLandmarks)
+	{
+		int farthest = nbDepots ;
+		for (int i=nbDepots ; i < nbClients + nbDepots ; i++)
+			if (distLandmarks[i] > distLandmarks[farthest]) farthest = i ;
+		landmarks.push_back(farthest);
+		for (int i=nbDepots ; i < nbClients + nbDepots ; i++)
+			distLandmarks[i] = min(distLandmarks[i],min(timeCost[farthest][i],timeCost[i][farthest])) ;
+		distLandmarks[farthest] = -1. ;
+	}
+
+	landmarkFrom = vector <double> ((nbClients + nbDepots) * nbLandmarks) ;
+	landmarkTo = vector <double> ((nbClients + nbDepots) * nbLandmarks) ;
+	for (int i=0 ; i < nbClients + nbDepots ; i++)
+	{
+		for (int l=0 ; l < nbLandmarks ; l++)
+		{
+			landmarkFrom[i*nbLandmarks + l] = timeCost[landmarks[l]][i] ;
+			landmarkTo[i*nbLandmarks + l] = timeCost[i][landmarks[l]] ;
+		}
+	}
 }
 
 void Params::getClient (int i, Client * myCli)
 {
 	// Reading/Initializing the data for each customer
-	string tempstring ;
 	pattern p ;
-	char * myChars = new char[100]; 
 	int t_arc, t_from, t_to, t_qty, t_trav, t_col, t_inv, t_freq ;
 	bool isNewService ;
 
@@ -389,12 +545,12 @@ void Params::getClient (int i, Client * myCli)
 		}
 		else
 		{
-			fichier >> tempstring ;
+			fichier.skipWord();
 			fichier >> myCli->ar_nodesExtr0 ;
-			fichier >> tempstring ;
+			fichier.skipWord();
 			fichier >> myCli->ar_nodesExtr1 ;
-			fichier >> tempstring ;
-			fichier >> tempstring ;
+			fichier.skipWord();
+			fichier.skipWord();
 			fichier >> myCli->ar_serviceCost01 ;
 			myCli->ar_serviceCost10 = myCli->ar_serviceCost01 ;
 
@@ -402,7 +558,7 @@ void Params::getClient (int i, Client * myCli)
 			ar_distanceNodes[myCli->ar_nodesExtr0][myCli->ar_nodesExtr1] = myCli->ar_serviceCost01 ;
 			ar_distanceNodes[myCli->ar_nodesExtr1][myCli->ar_nodesExtr0] = myCli->ar_serviceCost01 ;
 
-			fichier >> tempstring ;
+			fichier.skipWord();
 			fichier >> myCli->demand ;
 			totalDemand += myCli->demand ;
 			myCli->ar_nodeType = AR_CLIENT_EDGE ;
@@ -440,7 +596,7 @@ void Params::getClient (int i, Client * myCli)
 	{
 		if (i == 0)
 		{
-			getline(fichier, tempstring); // removing the line
+			fichier.skipLine(); // removing the line
 			myCli->demand = 0 ;
 			myCli->ar_serviceCost01 = 0. ;
 			myCli->ar_serviceCost10 = 0. ;
@@ -454,24 +610,24 @@ void Params::getClient (int i, Client * myCli)
 			isNewService = false ;
 			while (!isNewService) // looking for the next new service
 			{
-				fichier.getline(myChars,1000,'=');
+				fichier.skipUntil('=');
 				fichier >> t_arc ;
-				fichier.getline(myChars,1000,'=');
+				fichier.skipUntil('=');
 				fichier >> t_from ;
-				fichier.getline(myChars,1000,'=');
+				fichier.skipUntil('=');
 				fichier >> t_to ;
-				fichier.getline(myChars,1000,'=');
+				fichier.skipUntil('=');
 				fichier >> t_qty ;
-				fichier.getline(myChars,1000,'=');
+				fichier.skipUntil('=');
 				fichier >> t_trav ;
-				fichier.getline(myChars,1000,'=');
+				fichier.skipUntil('=');
 				fichier >> t_col ;
-				fichier.getline(myChars,1000,'=');
+				fichier.skipUntil('=');
 				fichier >> t_inv ;
-				fichier.getline(myChars,1000,';');
-				fichier.getline(myChars,1000,'=');
+				fichier.skipUntil(';');
+				fichier.skipUntil('=');
 				fichier >> t_freq ;
-				getline(fichier, tempstring); // finishing this line
+				fichier.skipLine(); // finishing this line
 				if (t_inv > t_arc) isNewService = true ; // We found a new service
 			}
 
@@ -520,12 +676,12 @@ void Params::getClient (int i, Client * myCli)
 		}
 		else
 		{
-			fichier >> tempstring ;
+			fichier.skipWord();
 			fichier >> myCli->ar_nodesExtr0 ;
-			fichier >> tempstring ;
+			fichier.skipWord();
 			fichier >> myCli->ar_nodesExtr1 ;
-			fichier >> tempstring ;
-			fichier >> tempstring ;
+			fichier.skipWord();
+			fichier.skipWord();
 			fichier >> myCli->ar_serviceCost01 ;
 			fichier >> myCli->ar_serviceCost10 ;
 
@@ -554,7 +710,54 @@ void Params::getClient (int i, Client * myCli)
 	}
 
 	if (i >= 1) nbTotalServices += myCli->freq ;
-	delete [] myChars ;
+}
+
+void Params::buildVehicles()
+{
+	vector <Vehicle> tempI ;
+
+	// Fleet size conventions of each problem type
+	if (type == 30 || type == 33) 
+	{
+		// The instance only provides a lower bound on the necessary number of vehicles, per definition of the CARP, more vehicles are allowed (here we put one more)
+		// Still, in all solutions the minimum number of vehicles turned out to be used
+		nbVehiculesPerDep = nbVehiculesFichier + 1 ;
+	}
+	else if (type == 31 || type == 32) 
+	{
+		// If the number of vehicles per depot has been specified in the commandline
+		// Otherwise we take it from the file (not always available, depending on the benchmark set)
+		if (nbVehiculesPerDep == -1)
+			nbVehiculesPerDep = nbVehiculesFichier ;
+	}
+	else if (type == 34)
+		nbVehiculesPerDep = nbVehiculesFichier ;
+	// For the MM-kWRPP, the fleet size is only given in the commandline
+
+	// Printing some warning in case of wrong use of the instances and parameters
+	if (nbVehiculesPerDep == -1) throw string ("WARNING : some type of instances do not specify a fleet size, please specify an upper bound manually using -veh XX in the commandline");
+
+	// Building the list of vehicles
+	ordreVehicules.clear();
+	nombreVehicules.clear();
+	dayCapacity.clear();
+	ordreVehicules.push_back(tempI) ;
+	nombreVehicules.push_back(0);
+	dayCapacity.push_back(0);
+	for (int kk=1 ; kk <= nbDays; kk ++)
+	{
+		ordreVehicules.push_back(tempI) ;
+		dayCapacity.push_back(0);
+		nombreVehicules.push_back(nbDepots*nbVehiculesPerDep);
+		for (int i=0 ; i < nbDepots ; i++)
+		{
+			for (int j=0 ; j < nbVehiculesPerDep ; j++)
+			{
+				ordreVehicules[kk].push_back(Vehicle(i,1000000,vehicleCapacity)); // Duration constraint set to a high value
+				dayCapacity[kk] += vehicleCapacity ;
+			}
+		}
+	}
 }
 
 void Params::setPatterns_PCARP(Client * myCli)
@@ -586,39 +789,139 @@ void Params::setPatterns_PCARP(Client * myCli)
 	}
 }
 
-Params::Params(string nomInstance, string nomSolution, string nomBKS, int seedRNG, int type, int nbVeh, int nbDep, bool isSearchingFeasible):type(type), nbVehiculesPerDep(nbVeh), nbDepots(nbDep), isSearchingFeasible(isSearchingFeasible)
+Params::Params(string nomInstance, string nomSolution, string nomBKS, int seedRNG, int type, int nbVeh, int nbDep, bool isSearchingFeasible, string nomCache):type(type), nbVehiculesPerDep(nbVeh), nbDepots(nbDep), isSearchingFeasible(isSearchingFeasible)
 {
 	// Main constructor of Params
 	pathToInstance = nomInstance ;
 	pathToSolution = nomSolution ;
 	pathToBKS = nomBKS ;
-	borne = 2.0 ;
-	sizeSD = 10 ;
-
-	seed = seedRNG;
-	if (seed == 0) // using the time to generate a seed when seed = 0 
-		srand((unsigned int)time(NULL));
-	else 
-		srand(seed);
+	pathToCache = nomCache ;
+	initialisation(seedRNG);
 
-	// Opening the instance file
-	fichier.open(nomInstance.c_str());
-
-	// Reading the instance file
-	if (fichier.is_open())
-		preleveDonnees (nomInstance);
-	else 
+	// Opening the instance file (mapped in memory)
+	if (!fichier.open(nomInstance))
 		throw string(" Impossible to find instance file ");
+	hashInstance = InstanceCache::hash(fichier.data(),fichier.size());
 
 	// Setting the method parameters
 	setMethodParams();
 
-	// If its a problem with multiple, we consider it as an equivalent problem with multiple periods
-	// one for each depot
+	// Looking for the preprocessed data in the cache (first in memory, then in the cache directory)
+	// The cache file is identified by the content of the instance file, the problem type and the number of depots
+	string nomCleMemoire = InstanceCache::fileName("",hashInstance,type,(type == 33) ? nbDepots : 1);
+	bool isInCache = InstanceCache::loadMemory(this,hashInstance,fichier.size(),nomCleMemoire) ;
+	bool isInMemory = isInCache ;
+	string nomFichierCache ;
+	if (!isInCache && pathToCache != "")
+	{
+		nomFichierCache = InstanceCache::fileName(pathToCache,hashInstance,type,(type == 33) ? nbDepots : 1);
+		isInCache = InstanceCache::load(this,hashInstance,fichier.size(),nomFichierCache);
+	}
+
+	if (isInCache)
+	{
+		// The vehicles are not part of the cache, as they depend on the commandline
+		nbDays = ancienNbDays ;
+		buildVehicles();
+		if (multiDepot) processVehiclesMD();
+		calculeLandmarks();
+	}
+	else
+	{
+		// Reading the instance file
+		preleveDonnees (nomInstance);
+
+		// If its a problem with multiple, we consider it as an equivalent problem with multiple periods
+		// one for each depot
+		if (multiDepot) processDataStructuresMD();
+
+		// Computing the other data structures
+		calculeStructures();
+
+		// Storing the preprocessed data for the next runs
+		if (pathToCache != "" && !InstanceCache::save(this,hashInstance,fichier.size(),nomFichierCache))
+			cout << "WARNING : impossible to write the cache file " << nomFichierCache << endl ;
+	}
+	if (!isInMemory)
+		InstanceCache::saveMemory(this,hashInstance,fichier.size(),nomCleMemoire);
+	fichier.close();
+
+	// Reserving the scratch buffers of the search
+	calculeVoisinsClasses();
+	workspace.reserve(nbClients + nbDepots,nbDays,nbVehiculesPerDep,mu + lambda + 1);
+}
+
+Params::Params(const InstanceInput & instance, int seedRNG, int type, int nbVeh, bool isSearchingFeasible):type(type), nbVehiculesPerDep(nbVeh), nbDepots((int)instance.depots.size()), isSearchingFeasible(isSearchingFeasible)
+{
+	// Constructor of Params for an instance given in memory (no instance file and no cache)
+	pathToInstance = "" ;
+	pathToSolution = "" ;
+	pathToBKS = "" ;
+	pathToCache = "" ;
+	initialisation(seedRNG);
+
+	// The instance is identified (for the checkpoints) by a hash of its content
+	vector <char> contenu ;
+	BinaryWriter w(contenu);
+	// (field by field, as the structures may contain padding bytes)
+	w.put(instance.nbNodes);
+	w.putVector(instance.depots);
+	w.put((int)instance.services.size());
+	w.put((int)instance.links.size());
+	for (int s=0 ; s < (int)instance.services.size() ; s++)
+	{
+		const ServiceInput & service = instance.services[s] ;
+		w.put((int)service.nodeType);
+		w.put(service.node0);
+		w.put(service.node1);
+		w.put(service.demand);
+		w.put(service.serviceCost01);
+		w.put(service.serviceCost10);
+		w.put(service.travelCost01);
+		w.put(service.travelCost10);
+		w.put(service.freq);
+	}
+	for (int l=0 ; l < (int)instance.links.size() ; l++)
+	{
+		w.put(instance.links[l].node0);
+		w.put(instance.links[l].node1);
+		w.put(instance.links[l].cost01);
+		w.put(instance.links[l].cost10);
+		w.put(instance.links[l].isArc);
+	}
+	w.put(instance.nbVehicles);
+	w.put(instance.capacity);
+	hashInstance = InstanceCache::hash(contenu.data(),contenu.size());
+
+	setMethodParams();
+	preleveDonnees(instance);
 	if (multiDepot) processDataStructuresMD();
+	calculeStructures();
+	calculeVoisinsClasses();
+	workspace.reserve(nbClients + nbDepots,nbDays,nbVehiculesPerDep,mu + lambda + 1);
+}
 
-	// Computing the other data structures
-	calculeStructures();	
+void Params::initialisation (int seedRNG)
+{
+	borne = 2.0 ;
+	sizeSD = 10 ;
+	isIndividusAlleges = false ;
+	stopToken = NULL ;
+	nbSplits = 0 ;
+	nbEvaluationsLS = 0 ;
+	nbDepotsProches = 0 ;
+	nbVehiculesFichier = -1 ;
+	ar_nbArcsDistance = 0 ;
+	ar_nbTurns = 0 ;
+	ar_maxNbModes = 0 ;
+	ar_tempIndexDepot = 0 ;
+	parsing_courNbArcs = 0 ;
+
+	seed = seedRNG;
+	if (seed == 0) // using the time to generate a seed when seed = 0 
+		initstate((unsigned int)time(NULL), etatRNG, sizeof(etatRNG));
+	else 
+		initstate(seed, etatRNG, sizeof(etatRNG));
 }
 
 Params::~Params(void)
@@ -645,18 +948,70 @@ void Params::shuffleProches ()
 		}
 	}
 
+	// Shuffling the order of evaluation of the ranked lists (the lists themselves stay ranked)
 	for (int i=nbDepots ; i < nbClients + nbDepots ; i++)
 	{
-		for (int a1 = 0 ; a1 < (int)cli[i].sommetsVoisinsAvant.size()-1 ; a1++ )
+		int * ordre = &ordreRangs[i*nbVoisins] ;
+		for (int a1 = 0 ; a1 < nbVoisins-1 ; a1++ )
 		{
-			temp2 = a1 + rand() % ((int)cli[i].sommetsVoisinsAvant.size() - a1) ;
-			temp =  cli[i].sommetsVoisinsAvant[a1] ;
-			cli[i].sommetsVoisinsAvant[a1] = cli[i].sommetsVoisinsAvant[temp2];
-			cli[i].sommetsVoisinsAvant[temp2] = temp ;
+			temp2 = a1 + rand() % (nbVoisins - a1) ;
+			temp =  ordre[a1] ;
+			ordre[a1] = ordre[temp2];
+			ordre[temp2] = temp ;
 		}
 	}
 }
 
+void Params::calculeVoisinsClasses ()
+{
+	// The lists "sommetsVoisinsAvant" are ordered by increasing distance (only their order of evaluation is shuffled)
+	nbVoisins = min(nbClients,granularity) ;
+	voisinsClasses.assign((nbClients + nbDepots) * nbVoisins, -1) ;
+	ordreRangs.resize((nbClients + nbDepots) * nbVoisins) ;
+	for (int i=0 ; i < nbClients + nbDepots ; i++)
+	{
+		for (int r=0 ; r < (int)cli[i].sommetsVoisinsAvant.size() && r < nbVoisins ; r++)
+			voisinsClasses[i*nbVoisins + r] = cli[i].sommetsVoisinsAvant[r] ;
+		for (int r=0 ; r < nbVoisins ; r++)
+			ordreRangs[i*nbVoisins + r] = r ;
+	}
+	granulariteNoeud.assign(nbClients + nbDepots, nbVoisins) ;
+	succesRang.assign((nbClients + nbDepots) * nbVoisins, 0) ;
+	nbLSDepuisAdaptation = 0 ;
+}
+
+void Params::adapterGranularite ()
+{
+	int total, cumul, rangCouverture ;
+	int * succes ;
+	int granulariteBasse = min(granulariteMin,nbVoisins) ;
+
+	for (int i=nbDepots ; i < nbClients + nbDepots ; i++)
+	{
+		succes = &succesRang[i*nbVoisins] ;
+		total = 0 ;
+		for (int r=0 ; r < granulariteNoeud[i] ; r++)
+			total += succes[r] ;
+
+		if (total == 0)
+			granulariteNoeud[i] = max(granulariteBasse,granulariteNoeud[i]-1) ;
+		else
+		{
+			// Number of ranks which cover the proportion "couvertureSucces" of the improving moves
+			cumul = 0 ;
+			rangCouverture = 0 ;
+			while (cumul < couvertureSucces * total)
+				cumul += succes[rangCouverture++] ;
+			granulariteNoeud[i] = max(granulariteBasse,min(nbVoisins,rangCouverture + rangCouverture/4 + 1)) ;
+		}
+
+		// The older statistics count for half at each adaptation
+		for (int r=0 ; r < nbVoisins ; r++)
+			succes[r] /= 2 ;
+	}
+	nbLSDepuisAdaptation = 0 ;
+}
+
 void Params::ar_InitializeDistanceNodes()
 {
 	if (ar_NodesNonRequired+ar_NodesRequired  < 0 || ar_NodesNonRequired+ar_NodesRequired  > 1000000)
@@ -756,23 +1111,21 @@ void Params::ar_computeDistancesArcs()
 void Params::ar_parseOtherLinesCARP()
 {
 	// Parsing routine for CARP
-	string contenu;
-	string useless;
 	int startNode ;
 	int endNode ;
 	double myCost ;
 
-	getline(fichier, contenu);
-	if (ar_EdgesNonRequired  > 0) getline(fichier, contenu);
+	fichier.skipLine();
+	if (ar_EdgesNonRequired  > 0) fichier.skipLine();
 
 	for (int k=0 ; k < ar_EdgesNonRequired ; k++)
 	{
-		fichier >> useless ;
+		fichier.skipWord();
 		fichier >> startNode ;
-		fichier >> useless ;
+		fichier.skipWord();
 		fichier >> endNode ;
-		fichier >> useless ;
-		fichier >> useless ;
+		fichier.skipWord();
+		fichier.skipWord();
 		fichier >> myCost ;
 		ar_distanceNodes[startNode][endNode] = myCost ;
 		if (type != 35) // not a "windy problem"
@@ -785,8 +1138,8 @@ void Params::ar_parseOtherLinesCARP()
 	// (except for the WRPP, where it was already defined as node 1 per convention of the instances)
 	if (type == 30)
 	{
-		fichier >> useless ;
-		fichier >> useless ;
+		fichier.skipWord();
+		fichier.skipWord();
 		fichier >> startNode ; // in CARP instances, this information is included in the file
 
 		cli[0].ar_nodesExtr0 = startNode ;
@@ -816,23 +1169,17 @@ void Params::ar_parseOtherLinesCARP()
 void Params::ar_parseOtherLinesNEARP()
 {
 	// Parsing routine for NEARP
-	string contenu;
-	string useless;
 	double myTravelCost ;
 	int iCour = 1 ;
 	int idNode ;
-	string myString ;
-	string myStringTemp ;
 	int side0 ;
 	int side1 ;
 
 	//  REQUIRED NODES
-	getline(fichier, contenu);
+	fichier.skipLine();
 	for (int k=0 ; k < ar_NodesRequired ; k++)
 	{
-		fichier >> myStringTemp ;
-		myString = myStringTemp.substr(1,myStringTemp.size());
-		idNode = atoi(myString.c_str());
+		idNode = fichier.readPrefixedInt() ;
 		cli[iCour].ar_nodesExtr0 = idNode ;
 		cli[iCour].ar_nodesExtr1 = idNode ;
 		fichier >> cli[iCour].demand ;
@@ -842,14 +1189,14 @@ void Params::ar_parseOtherLinesNEARP()
 		cli[iCour].ar_serviceCost10 = 0 ; // to remove the base cost from the results.
 		iCour ++ ;
 	}
-	getline(fichier, contenu);
-	if (ar_NodesRequired > 0) getline(fichier, contenu);
+	fichier.skipLine();
+	if (ar_NodesRequired > 0) fichier.skipLine();
 
 	// REQUIRED EDGES
-	getline(fichier, contenu);
+	fichier.skipLine();
 	for (int k=0 ; k < ar_EdgesRequired ; k++)
 	{
-		fichier >> useless ;
+		fichier.skipWord();
 		fichier >> cli[iCour].ar_nodesExtr0 ;
 		fichier >> cli[iCour].ar_nodesExtr1 ;
 
@@ -865,28 +1212,28 @@ void Params::ar_parseOtherLinesNEARP()
 		cli[iCour].ar_serviceCost10 = myTravelCost ;
 		iCour ++ ;
 	}
-	getline(fichier, contenu);
-	if (ar_EdgesRequired > 0) getline(fichier, contenu);
+	fichier.skipLine();
+	if (ar_EdgesRequired > 0) fichier.skipLine();
 
 	// NON-REQUIRED EDGES
-	getline(fichier, contenu);
+	fichier.skipLine();
 	for (int k=0 ; k < ar_EdgesNonRequired ; k++)
 	{
-		fichier >> useless ;
+		fichier.skipWord();
 		fichier >> side0 ;
 		fichier >> side1 ;
 		fichier >> myTravelCost ;
 		ar_distanceNodes[side0][side1] = myTravelCost ;
 		ar_distanceNodes[side1][side0] = myTravelCost ;
 	}
-	getline(fichier, contenu);
-	if (ar_EdgesNonRequired > 0) getline(fichier, contenu);
+	fichier.skipLine();
+	if (ar_EdgesNonRequired > 0) fichier.skipLine();
 
 	// REQUIRED ARCS
-	getline(fichier, contenu);
+	fichier.skipLine();
 	for (int k=0 ; k < ar_ArcsRequired ; k++)
 	{
-		fichier >> useless ;
+		fichier.skipWord();
 		fichier >> cli[iCour].ar_nodesExtr0 ;
 		fichier >> cli[iCour].ar_nodesExtr1 ;
 
@@ -901,14 +1248,14 @@ void Params::ar_parseOtherLinesNEARP()
 		cli[iCour].ar_serviceCost10 = 1.e20 ; // This is an arc
 		iCour ++ ;
 	}
-	getline(fichier, contenu);
-	if (ar_ArcsRequired > 0) getline(fichier, contenu);
+	fichier.skipLine();
+	if (ar_ArcsRequired > 0) fichier.skipLine();
 
 	// NON-REQUIRED ARCS
-	getline(fichier, contenu);
+	fichier.skipLine();
 	for (int k=0 ; k < ar_ArcsNonRequired ; k++)
 	{
-		fichier >> useless ;
+		fichier.skipWord();
 		fichier >> side0 ;
 		fichier >> side1 ;
 		fichier >> myTravelCost ;
@@ -922,7 +1269,6 @@ void Params::ar_parseOtherLinesNEARP()
 void Params::ar_parseOtherLinesNEARP_TP()
 {
 	// Parsing routine for NEARP-TP
-	string contenu ;
 	double uselessDbl ;
 
 	int p_qty ;
@@ -949,8 +1295,8 @@ void Params::ar_parseOtherLinesNEARP_TP()
 	parsing_courService ++ ;
 
 	/* THEN READ THE CHARACTERISTICS OF THE NODE SERVICES */
-	getline(fichier, contenu);
-	getline(fichier, contenu);
+	fichier.skipLine();
+	fichier.skipLine();
 
 	for (int i=0 ; i < this->ar_NodesNonRequired + this->ar_NodesRequired ; i++)
 	{
@@ -969,11 +1315,11 @@ void Params::ar_parseOtherLinesNEARP_TP()
 	}
 
 	/* THEN READ THE CHARACTERISTICS OF THE EDGE SERVICES */
-	getline(fichier, contenu);
-	getline(fichier, contenu);
-	getline(fichier, contenu);
+	fichier.skipLine();
+	fichier.skipLine();
+	fichier.skipLine();
 	if (this->ar_NodesNonRequired + this->ar_NodesRequired > 0)
-		getline(fichier, contenu);
+		fichier.skipLine();
 
 	for (int i=0 ; i < this->ar_EdgesNonRequired + this->ar_EdgesRequired ; i++)
 	{
@@ -1007,11 +1353,11 @@ void Params::ar_parseOtherLinesNEARP_TP()
 	}
 
 	/* THEN READ THE CHARACTERISTICS OF THE ARCS SERVICES */
-	getline(fichier, contenu);
-	getline(fichier, contenu);
-	getline(fichier, contenu);
+	fichier.skipLine();
+	fichier.skipLine();
+	fichier.skipLine();
 	if (this->ar_EdgesNonRequired + this->ar_EdgesRequired > 0)
-		getline(fichier, contenu);
+		fichier.skipLine();
 
 	for (int i=0 ; i < this->ar_ArcsNonRequired + this->ar_ArcsRequired ; i++)
 	{
@@ -1062,11 +1408,11 @@ void Params::ar_parseOtherLinesNEARP_TP()
 	}
 
 	/* PARSING THE TURNS */
-	getline(fichier, contenu);
-	getline(fichier, contenu);
-	getline(fichier, contenu);
+	fichier.skipLine();
+	fichier.skipLine();
+	fichier.skipLine();
 	if (this->ar_ArcsNonRequired + this->ar_ArcsRequired > 0)
-		getline(fichier, contenu);
+		fichier.skipLine();
 
 	for (int i=0 ; i < this->ar_nbTurns ; i++)
 	{
@@ -1074,7 +1420,7 @@ void Params::ar_parseOtherLinesNEARP_TP()
 		fichier >> p_indexJ ;
 		fichier >> p_indexK ;
 		fichier >> p_costTurn ;
-		fichier >> contenu ;
+		fichier.skipWord();
 
 		int corrArc1 = ar_correspondingArc[p_indexI][p_indexJ]->indexArc ;
 		int corrArc2 = ar_correspondingArc[p_indexJ][p_indexK]->indexArc ;
@@ -1108,8 +1454,70 @@ void Params::ar_parseOtherLinesNEARP_TP()
 void Params::processDataStructuresMD () 
 {
 	int nbPat ;
-	vector <Vehicle> temp ;
 	pattern p ;
+
+	// the vehicles of each depot are assigned to the corresponding days
+	processVehiclesMD();
+
+	// we update the patterns
+	for (int i = nbDepots ;  i < nbDepots + nbClients ; i++ )
+	{
+		nbPat = (int)cli[i].visitsOrigin.size();
+		cli[i].visits.clear();
+
+		for (int j=0 ; j < nbDepots ; j++)
+		{
+			p.dep = j ;
+			p.cost = 0 ;
+			for ( int pat = 0 ; pat < nbPat ; pat ++ )
+			{
+				p.pat = cli[i].visitsOrigin[pat].pat ;
+				cli[i].visits.push_back(p) ;
+			}
+		}
+		cli[i].visitsOrigin = cli[i].visits ;
+	}	
+}
+
+void Params::restreindreDepots (int nbProches) 
+{
+	if (!multiDepot || nbProches <= 0 || nbProches >= nbDepots)
+		return ;
+	nbDepotsProches = nbProches ;
+
+	int temp ;
+	for (int i = nbDepots ;  i < nbDepots + nbClients ; i++ )
+	{
+		// Ordering the depots by increasing distance of a round trip to the service
+		vector <int> & ordre = cli[i].ordreProximiteDepots ;
+		ordre.clear();
+		for (int d=0 ; d < nbDepots ; d++)
+		{
+			ordre.push_back(d);
+			for (int j = d ; j > 0 && timeCost[ordre[j]][i] + timeCost[i][ordre[j]] < timeCost[ordre[j-1]][i] + timeCost[i][ordre[j-1]] ; j--)
+			{
+				temp = ordre[j] ;
+				ordre[j] = ordre[j-1] ;
+				ordre[j-1] = temp ;
+			}
+		}
+
+		// Keeping the closest depots, and the patterns which use them
+		cli[i].isDepotProche = vector <bool> (nbDepots,false) ;
+		for (int d=0 ; d < nbProches ; d++)
+			cli[i].isDepotProche[ordre[d]] = true ;
+
+		vector <pattern> visitsProches ;
+		for (int p=0 ; p < (int)cli[i].visits.size() ; p++)
+			if (cli[i].isDepotProche[cli[i].visits[p].dep])
+				visitsProches.push_back(cli[i].visits[p]);
+		cli[i].visits = visitsProches ;
+	}
+}
+
+void Params::processVehiclesMD () 
+{
+	vector <Vehicle> temp ;
 	vector < vector <Vehicle> > ordreVehiculesAncien ;
 
 	// we change the number of days
@@ -1137,23 +1545,4 @@ void Params::processDataStructuresMD ()
 			dayCapacity[k] += ordreVehicules[k][d].vehicleCapacity ;
 		}
 	}
-
-	// we update the patterns
-	for (int i = nbDepots ;  i < nbDepots + nbClients ; i++ )
-	{
-		nbPat = (int)cli[i].visitsOrigin.size();
-		cli[i].visits.clear();
-
-		for (int j=0 ; j < nbDepots ; j++)
-		{
-			p.dep = j ;
-			p.cost = 0 ;
-			for ( int pat = 0 ; pat < nbPat ; pat ++ )
-			{
-				p.pat = cli[i].visitsOrigin[pat].pat ;
-				cli[i].visits.push_back(p) ;
-			}
-		}
-		cli[i].visitsOrigin = cli[i].visits ;
-	}	
-}
\ No newline at end of file
+}
@@ -21,6 +21,7 @@
 
 #include <string>
 #include <vector>
+#include <stdlib.h>
 #include <list>
 #include <fstream>
 #include <iostream>
@@ -29,6 +30,12 @@
 #include <algorithm>
 #include "Client.h"
 #include "Vehicle.h"
+#include "InstanceReader.h"
+#include "InstanceCache.h"
+#include "SolverData.h"
+#include "StopToken.h"
+#include "Workspace.h"
+#include "NeighbourhoodScheduler.h"
 using namespace std ;
 
 // little function used to clear some arrays
@@ -61,15 +68,25 @@ public:
 	// random seed
 	int seed ;
 
+	// state of the random number generator (rand() shares the generator of random() in the GNU C library)
+	// it is kept in a known buffer, common to all Params, such that it can be saved and restored (checkpoints)
+	static char etatRNG [128] ;
+
 	// path to the instance
 	string pathToInstance ;
 
+	// hash of the content of the instance file (identifies the instance in the cache and in the checkpoints)
+	uint64_t hashInstance ;
+
 	// path to the solution
 	string pathToSolution ;
 
 	// path to the BKS (just to read the value and overwrite if needed)
 	string pathToBKS ;
 
+	// directory of the cache of preprocessed instances (empty if no cache is used)
+	string pathToCache ;
+
 	// Problem type
 	/*
 	type =     // This lists the problems which can be solved with this algorithm
@@ -82,6 +99,7 @@ public:
 			   */
 	int type ;
 	bool multiDepot ; // is there multiple depots in the problem
+	int nbDepotsProches ; // (MDCARP) number of closest depots from which each service can be serviced, 0 for all depots
 	bool periodique ; // is there multiple periods in the problem
 	bool isTurnPenalties ; // is there turn penalties
 
@@ -126,6 +144,12 @@ public:
 	// number of vehicles per depot
 	int nbVehiculesPerDep ;
 
+	// number of vehicles per depot as given in the instance file (-1 if not given)
+	int nbVehiculesFichier ;
+
+	// capacity of the vehicles as given in the instance file
+	double vehicleCapacity ;
+
 	// number of depots
 	int nbDepots ;
 
@@ -147,6 +171,21 @@ public:
 	// isCorrelated[i][j] returns true if and only if j is considered to be among the closest customers to i (granular search parameter)
 	vector < vector <bool> > isCorrelated ;
 
+	// granularRadius[i] is the largest distance timeCost[j][i] of a service j in the list of close services of i
+	vector <double> granularRadius ;
+
+	// serviceSpan[i] is the largest distance between two endpoints (or modes) of the service i
+	// The distances timeCost satisfy the triangle inequality up to this value : timeCost[i][k] <= timeCost[i][j] + serviceSpan[j] + timeCost[j][k]
+	vector <double> serviceSpan ;
+
+	// services used as landmarks for the network summaries of the routes (see Route::distanceTo), spread over the network
+	vector <int> landmarks ;
+
+	// distances between the services and the landmarks, stored contiguously for each service
+	// landmarkFrom[i*landmarks.size()+l] = timeCost[landmarks[l]][i] and landmarkTo[i*landmarks.size()+l] = timeCost[i][landmarks[l]]
+	vector <double> landmarkFrom ;
+	vector <double> landmarkTo ;
+
 	/* ----------------- METHOD PARAMETERS & OTHER DATA ---------------- */
 
 	// Are we running an Iterated Local Search ?
@@ -157,6 +196,22 @@ public:
 	// In this case we would stop the search as soon as a feasible solution is found
 	bool isSearchingFeasible ;
 
+	// Cooperative stop of the search, shared by all runs of a resolution (NULL if the search can not be stopped)
+	StopToken * stopToken ;
+
+	// scratch buffers of the search, reserved with the data of the instance (see Workspace.h)
+	Workspace workspace ;
+
+	// scheduling of the neighbourhoods of the local search, and their statistics (see NeighbourhoodScheduler.h)
+	NeighbourhoodScheduler ordonnanceur ;
+
+	// number of calls to the Split algorithm during the run (statistics and work budget, see Genetic::isBudgetOver)
+	long long nbSplits ;
+
+	// number of move evaluations of the local search during the run (statistics and work budget)
+	// one evaluation is a call to one of the move operators for a pair of nodes, or an evaluation of the insertions of a service in a route
+	long long nbEvaluationsLS ;
+
 	// population size parameters
 	int mu ; // Default 25
 	int lambda ; // Default 40
@@ -176,23 +231,42 @@ public:
 	// number of close customers considered in RI (granular search)
 	int granularity ; // Default 40
 
+	// adaptive granular search : lower bound on the number of close customers of each customer in RI (the upper bound is "granularity",
+	// the adaptation is disabled if both are equal), number of calls to the LS between two adaptations of these numbers,
+	// and proportion of the recent improving moves of each customer which should remain in its list
+	int granulariteMin ; // Default 15
+	int periodeAdaptation ; // Default 100
+	double couvertureSucces ; // Default 0.99
+
+	// says if the granularity of each customer is adapted (otherwise each customer keeps its "granularity" closest customers in RI)
+	bool isGranulariteAdaptative ; // Default false (option -adaptivegranular)
+
 	// how much additional capacity consumption (multiplicator) allowed in Split
 	double borne ; // Default 2
 
 	// max size of a SeqData
 	// The preprocessing effort could also be limited to O(n^4/3) using hierarchies as in Irnich 2008 (JOC)
-	int sizeSD ; // Default 10
+	int sizeSD ; // Default 10 (can be reduced to fit a memory budget, see MemoryEstimate.h)
+
+	// says if the working individuals of the HGA which never run Split are kept without its structures (memory budget, see MemoryEstimate.h)
+	bool isIndividusAlleges ; // Default false
 
 	/* ------------------------  PARSING ROUTINES  -------------------- */
 
-	// incoming data stream
-	ifstream fichier ;
+	// incoming data (instance file mapped in memory)
+	InstanceReader fichier ;
 
 	// setting the parameters of the method
 	void setMethodParams () ;
 
+	// setting the default values of the data, and initializing the random number generator
+	void initialisation (int seedRNG) ;
+
 	// get the data from the stream
 	void preleveDonnees (string nomInstance) ;
+
+	// get the data from an instance given in memory
+	void preleveDonnees (const InstanceInput & instance) ;
 	void ar_parseOtherLinesCARP(); // some sub-procedures when reading the various instance formats
 	void ar_parseOtherLinesNEARP();
 	void ar_computeDistancesNodes();
@@ -206,6 +280,12 @@ public:
 	// builds the other data structures (granular search etc...)
 	void calculeStructures () ;
 
+	// builds the granular radius of the services and chooses the landmarks (not stored in the cache, as they are quickly computed)
+	void calculeLandmarks () ;
+
+	// sets the fleet size from the instance file and the commandline (depending on the problem type), and builds the list of vehicles
+	void buildVehicles () ;
+
 	// sets the good patterns for a customer
 	// part of the instance definition in the PCARP
 	void setPatterns_PCARP(Client * myCli);
@@ -213,12 +293,56 @@ public:
 	// Used to initialize the data structures for multi-depot problems
 	// Each depot is considered as a day (it works in the same way in the local search and all components of the method)
 	void processDataStructuresMD () ;
+	void processVehiclesMD () ; // only the part concerning the vehicles
+
+	// (MDCARP) restricts the patterns of each service to its "nbProches" closest depots (in terms of round trip)
+	// the local search only creates the data on the subsequences for the days of these depots
+	void restreindreDepots (int nbProches) ;
+
+	// says if a service can be visited on a day, i.e., if the depot of this day is one of its closest depots (always true without restriction)
+	bool estVisitable (int client, int day)
+	{
+		return cli[client].isDepotProche.empty() || cli[client].isDepotProche[(day-1)/ancienNbDays] ;
+	}
 	
 	// shuffle the lists of closest customers
 	void shuffleProches () ;
 
+	/* ------------------------  ADAPTIVE GRANULAR SEARCH  -------------------- */
+
+	// number of close customers of each customer in the ranked lists (min(nbClients,granularity))
+	int nbVoisins ;
+
+	// ranked lists of close customers in a flat array : voisinsClasses[i*nbVoisins + r] is the customer of rank r (by increasing distance) in the list of i
+	// the moves of a customer in RI are restricted to the first granulariteNoeud[i] customers of its list
+	vector <int> voisinsClasses ;
+
+	// order of evaluation of the close customers in RI : ordreRangs[i*nbVoisins + a] is the rank of the a-th close customer of i to evaluate
+	// (this permutation of the ranks is shuffled before each LS, see shuffleProches)
+	vector <int> ordreRangs ;
+
+	// current number of close customers of each customer in RI, between granulariteMin and nbVoisins
+	vector <int> granulariteNoeud ;
+
+	// succesRang[i*nbVoisins + r] : number of recent improving moves of RI between i and its close customer of rank r (halved at each adaptation)
+	vector <int> succesRang ;
+
+	// number of calls to the LS since the last adaptation
+	int nbLSDepuisAdaptation ;
+
+	// fills the ranked lists from the lists of close customers, all customers start with the maximum granularity
+	void calculeVoisinsClasses () ;
+
+	// adapts the number of close customers of each customer to the ranks of its recent improving moves : the ranks which cover
+	// "couvertureSucces" of these moves, plus a margin of 25% (the list grows when the moves are found near its end),
+	// or one less when there has been no improving move
+	void adapterGranularite () ;
+
 	// constructor
-	Params(string nomInstance, string nomSolution, string nomBKS, int seedRNG, int type, int nbVeh, int nbDep, bool isSearchingFeasible);
+	Params(string nomInstance, string nomSolution, string nomBKS, int seedRNG, int type, int nbVeh, int nbDep, bool isSearchingFeasible, string nomCache);
+
+	// constructor from an instance given in memory (the number of depots is given by the instance)
+	Params(const InstanceInput & instance, int seedRNG, int type, int nbVeh, bool isSearchingFeasible);
 
 	// destructor
 	~Params(void);
@@ -17,8 +17,9 @@
 //  ---------------------------------------------------------------------- */
 
 #include "Population.h"
+#include "Profiler.h"
 
-Population::Population(Params * params) : params(params)
+Population::Population(Params * params, bool createIndividus) : params(params)
 {
 	Individu * randomIndiv ;
 	valides = new SousPop();
@@ -34,7 +35,7 @@ Population::Population(Params * params) : params(params)
 	trainer->localSearch = new LocalSearch(params,trainer) ; // Initialize the LS structure
 
 	// Creating the initial populations
-	for (int i=0 ; i < params->mu && (!params->isSearchingFeasible || !feasibleFound) ; i++ )
+	for (int i=0 ; i < params->mu && createIndividus && (!params->isSearchingFeasible || !feasibleFound) ; i++ )
 	{
 		randomIndiv = new Individu (params,true);
 		education(randomIndiv);
@@ -96,8 +97,10 @@ Population::~Population()
 void Population::evalExtFit(SousPop * pop)
 {
 	int temp ;
-	vector <int> classement ;
-	vector <double> distances ;
+	vector <int> & classement = params->workspace.classement ;
+	vector <double> & distances = params->workspace.distances ;
+	classement.clear();
+	distances.clear();
 
 	for (int i = 0 ; i < pop->nbIndiv ; i++ )
 	{
@@ -130,6 +133,7 @@ void Population::evalExtFit(SousPop * pop)
 
 int Population::addIndividu (Individu * indiv)
 {
+	PROFILE_SCOPE(PROF_ADD_INDIVIDU);
 	SousPop * souspop ;
 	int k, result ;
 
@@ -147,6 +151,7 @@ int Population::addIndividu (Individu * indiv)
 			removeIndividu(souspop,k);
 		}
 	}
+	if (result != -1) PROFILE_SUCCESS ;
 	return result ;
 }
 
@@ -173,6 +178,33 @@ int Population::addAllIndividus (Population * pop)
 	return 1 ;
 }
 
+void Population::addIndividuFromFile (string nomFichier)
+{
+	double temp, temp2 ;
+	Individu * initIndiv = new Individu (params,true);
+	initIndiv->importSolution(nomFichier);
+	education(initIndiv);
+	addIndividu(initIndiv) ;
+	updateNbValides(initIndiv);
+
+	// As for the initial population, an infeasible individual is also repaired with higher penalties
+	if (!initIndiv->estValide)
+	{
+		temp = params->penalityCapa ;
+		temp2 = params->penalityLength ;
+		params->penalityCapa *= 10 ;
+		params->penalityLength *= 10 ;
+		education(initIndiv);
+		params->penalityCapa = temp ;
+		params->penalityLength = temp2 ;
+		initIndiv->generalSplit();
+		addIndividu(initIndiv) ;
+	}
+
+	cout << "Initial solution read from " << nomFichier << " | distance : " << initIndiv->coutSol.distance << " | feasible : " << initIndiv->estValide << endl ;
+	delete initIndiv ;
+}
+
 void Population::updateProximity (SousPop * pop, Individu * indiv)
 {
 	for (int k=0 ; k < pop->nbIndiv ; k++)
@@ -204,19 +236,13 @@ void Population::diversify ()
 	double temp = params->penalityCapa ;
 	double temp2 = params->penalityLength ;
 
+	// removeIndividu also clears the proximity structures of the remaining individuals
+	// (otherwise they would keep pointers to deleted individuals, and the search would depend on the memory layout)
 	while ( valides->nbIndiv > (int)(0.3*(double)params->mu))
-	{
-		delete valides->individus[valides->nbIndiv-1] ;
-		valides->individus.pop_back();
-		valides->nbIndiv -- ;
-	}
+		removeIndividu(valides,valides->nbIndiv-1);
 
 	while ( invalides->nbIndiv > (int)(0.3*(double)params->mu))
-	{
-		delete invalides->individus[invalides->nbIndiv-1] ;
-		invalides->individus.pop_back();
-		invalides->nbIndiv -- ;
-	}
+		removeIndividu(invalides,invalides->nbIndiv-1);
 
 	for (int i=0 ; i < params->mu ; i++ )
 	{
@@ -408,149 +434,204 @@ Individu * Population::getIndividuBestInvalide ()
 	else return NULL ;
 }
 
-void Population::ExportBest (string nomFichier) 
+bool Population::getBestSolution (SolverResult & result)
 {
-	vector <int> rout ;
-	vector < vector < vector <int> > > allRoutes ; 
-	vector < vector < vector < pair <int,int> > > > allRoutesArcs ; 
-	allRoutes.push_back(vector < vector <int> > ());
-	allRoutesArcs.push_back(vector < vector <pair<int,int> > > ()) ;
-	int compteur ;
 	Noeud * noeudActuel ;
 	LocalSearch * loc ;
-	ofstream myfile;
+	SeqData * seq ;
 	double temp, temp2 ;
+	vector <int> rout ;
+	RouteResult route ;
+	VisitResult visite ;
 	Individu * bestValide = getIndividuBestValide ();
 
-	if (bestValide != NULL)
-	{
-		// we load the local search structure to have the full information on the routes and easily print the solution
-		// we set a high penalty, so Split and LS does not have the bad idea to create an infeasible solution from the best known feasible one
-		temp = params->penalityCapa ;
-		temp2 = params->penalityLength ;
-		params->penalityCapa = 100000 ;
-		params->penalityLength = 100000 ;
-		education(bestValide);
-		loc = trainer->localSearch ;
-		params->penalityCapa = temp ;
-		params->penalityLength = temp2 ;
+	result.isFeasible = false ;
+	result.routes.clear();
+	if (bestValide == NULL)
+		return false ;
 
-		// Little debugging tests before printing
-		trainer->testPatternCorrectness();
-		if (!trainer->estValide || trainer->coutSol.lengthViol > 0.000001 || trainer->coutSol.capacityViol > 0.000001)
-			throw string("ERROR: Last individual became infeasible !!!!") ;
-		
-		// Opening the file to write the solution
-		myfile.open(nomFichier.data());
-		myfile.precision(10);
-		cout.precision(10);
-		
-		// Writing the distance
-		if (params->type != 35)
-		{
-			cout << "Writing the best solution : distance : " << trainer->coutSol.distance ;
-			myfile << trainer->coutSol.distance << endl ;
-		}
-		else
-		{
-			cout << "Writing the best solution, maximum distance : " << bestValide->maxRoute ;
-			myfile << bestValide->maxRoute << endl ;
-		}
+	// we load the local search structure to have the full information on the routes and easily print the solution
+	// we set a high penalty, so Split and LS does not have the bad idea to create an infeasible solution from the best known feasible one
+	temp = params->penalityCapa ;
+	temp2 = params->penalityLength ;
+	params->penalityCapa = 100000 ;
+	params->penalityLength = 100000 ;
+	education(bestValide);
+	loc = trainer->localSearch ;
+	params->penalityCapa = temp ;
+	params->penalityLength = temp2 ;
+
+	// Little debugging tests before printing
+	trainer->testPatternCorrectness();
+	if (!trainer->estValide || trainer->coutSol.lengthViol > 0.000001 || trainer->coutSol.capacityViol > 0.000001)
+		throw string("ERROR: Last individual became infeasible !!!!") ;
+
+	result.isFeasible = true ;
+	result.distance = trainer->coutSol.distance ;
+	result.maxRoute = bestValide->maxRoute ;
+	result.nbRoutes = params->periodique ? params->nbVehiculesPerDep : trainer->nbRoutes ;
+	result.timeBest = timeBest ;
+
+	// Collecting the routes and their content
+	for (int k=1 ; k <= params->nbDays ; k++)
+	{
+		for (int i=0 ; i < params->nombreVehicules[k] ; i++)
+		{	
+			// Test if the route is empty
+			if (!loc->routes[k][i].depot->suiv->estUnDepot)
+			{
+				// The route is not empty
+				// First, we pre-process again the data structures on the route with the flag "true", which allow to track back the orientation of the visits
+				loc->routes[k][i].updateRouteData(true); 
+				seq = loc->routes[k][i].depot->pred->seq0_i ;
+				noeudActuel = loc->routes[k][i].depot->suiv ;
+				rout.clear();
+				rout.push_back(loc->routes[k][i].depot->cour);
+				rout.push_back(noeudActuel->cour);
+
+				while (!noeudActuel->estUnDepot)
+				{
+					noeudActuel = noeudActuel->suiv ;
+					rout.push_back(noeudActuel->cour);
+				}
 
-		// Writing the number of routes
-		if (params->periodique)
-		{
-			cout << " | nbRoutes : " << params->nbVehiculesPerDep ;
-			myfile << params->nbVehiculesPerDep << endl ;
+				if (seq->bestCostArcs[0][0].size() != rout.size())
+					throw string ("Issue : mismatch between the route size and the number of arcs reported by the SeqData");
+
+				route.depot = loc->routes[k][i].depot->cour ;
+				route.day = (k-1)%params->ancienNbDays + 1 ;
+				route.load = seq->load ;
+				route.cost = seq->evaluation(seq,loc->routes[k][i].vehicle) ;
+				route.visits.clear();
+				for (int j=0 ; j < (int)rout.size() ; j++)
+				{
+					visite.service = (rout[j] < params->nbDepots) ? -1 : rout[j] - params->nbDepots ;
+					visite.depot = (rout[j] < params->nbDepots) ? rout[j] : -1 ;
+					visite.node0 = seq->bestCostArcs[0][0][j].first ;
+					visite.node1 = seq->bestCostArcs[0][0][j].second ;
+					route.visits.push_back(visite);
+				}
+				result.routes.push_back(route);
+			}
 		}
-		else
+	}
+	return true ;
+}
+
+bool Population::checkSolution (SolverResult & result)
+{
+	int k ;
+	vector < vector < vector <int> > > allRoutes = vector < vector < vector <int> > > (params->nbDays + 1) ;
+	vector < vector < vector < pair <int,int> > > > allRoutesArcs = vector < vector < vector < pair <int,int> > > > (params->nbDays + 1) ;
+
+	// Rebuilding the routes of each day, in terms of nodes of the problem and arcs
+	for (int r=0 ; r < (int)result.routes.size() ; r++)
+	{
+		k = result.routes[r].day + result.routes[r].depot * params->ancienNbDays ;
+		allRoutes[k].push_back(vector <int> ());
+		allRoutesArcs[k].push_back(vector < pair <int,int> > ());
+		for (int j=0 ; j < (int)result.routes[r].visits.size() ; j++)
 		{
-			cout << " | nbRoutes : " << trainer->nbRoutes ;
-			myfile << trainer->nbRoutes << endl ;
+			const VisitResult & visite = result.routes[r].visits[j] ;
+			allRoutes[k].back().push_back((visite.service == -1) ? visite.depot : visite.service + params->nbDepots);
+			allRoutesArcs[k].back().push_back(pair <int,int> (visite.node0,visite.node1));
 		}
+	}
+	return solutionChecker(allRoutes,allRoutesArcs,result.distance,result.maxRoute);
+}
 
-		cout << " | in " << nomFichier.c_str() << endl ;
+bool Population::writeSolution (SolverResult & result, string nomFichier)
+{
+	ofstream myfile;
+	int compteur = 1 ;
 
-		// Printing the total time of the run
-		// (we print the number of clock ticks to help for short runs, the user will do the proper conversion) 
-		myfile << (long long) clock() << endl ;
+	// Opening the file to write the solution
+	myfile.open(nomFichier.data());
+	myfile.precision(10);
+	cout.precision(10);
 
-		// Printing the time to find the best solution
-		// (we print the number of clock ticks to help for short runs, the user will do the proper conversion) 
-		myfile << (long long) timeBest << endl ;
+	// Writing the distance
+	if (params->type != 35)
+	{
+		cout << "Writing the best solution : distance : " << result.distance ;
+		myfile << result.distance << endl ;
+	}
+	else
+	{
+		cout << "Writing the best solution, maximum distance : " << result.maxRoute ;
+		myfile << result.maxRoute << endl ;
+	}
 
-		// Printing the routes and their content
-		for (int k=1 ; k <= params->nbDays ; k++)
-		{
-			compteur = 1 ;
-			allRoutes.push_back(vector < vector <int> > ());
-			allRoutesArcs.push_back(vector < vector <pair<int,int> > > ()) ;
-			for (int i=0 ; i < params->nombreVehicules[k] ; i++)
-			{	
-				// Test if the route is empty
-				if (!loc->routes[k][i].depot->suiv->estUnDepot)
-				{
-					// The route is not empty
-					// First, we pre-process again the data structures on the route with the flag "true", which allow to track back the orientation of the visits
-					loc->routes[k][i].updateRouteData(true); 
-					noeudActuel = loc->routes[k][i].depot->suiv ;
-					rout.clear();
-					rout.push_back(loc->routes[k][i].depot->cour);
-					rout.push_back(noeudActuel->cour);
+	// Writing the number of routes
+	cout << " | nbRoutes : " << result.nbRoutes ;
+	myfile << result.nbRoutes << endl ;
 
-					while (!noeudActuel->estUnDepot)
-					{
-						noeudActuel = noeudActuel->suiv ;
-						rout.push_back(noeudActuel->cour);
-					}
-
-					allRoutes[k].push_back(rout);
-					allRoutesArcs[k].push_back(loc->routes[k][i].depot->pred->seq0_i->bestCostArcs[0][0]) ;
-
-					if( loc->routes[k][i].depot->pred->seq0_i->bestCostArcs[0][0].size() != rout.size())
-						throw string ("Issue : mismatch between the route size and the number of arcs reported by the SeqData");
-
-					myfile << " " << loc->routes[k][i].depot->cour ; // Printing the depot
-					myfile << " " << (k-1)%params->ancienNbDays + 1 ; // Printing the day
-					myfile << " " << compteur ; // Printing the index of the route
-					myfile << " " << loc->routes[k][i].depot->pred->seq0_i->load ; // Printing the total demand
-					myfile << " " << loc->routes[k][i].depot->pred->seq0_i->evaluation(loc->routes[k][i].depot->pred->seq0_i,loc->routes[k][i].vehicle) << " " ; // Printing the total cost of this route
-					
-					myfile << " " << (int)rout.size() ; // Printing the number of customers in the route
-					for (int j=0 ; j < (int)rout.size() ; j++ ) // Printing the visits and their orientation
-					{
-						if (rout[j] < params->nbDepots)
-							myfile << " (D " ;
-						else
-							myfile << " (S " ;
-						myfile << rout[j] << "," ;
-						myfile << loc->routes[k][i].depot->pred->seq0_i->bestCostArcs[0][0][j].first << "," ;
-						myfile << loc->routes[k][i].depot->pred->seq0_i->bestCostArcs[0][0][j].second << ")" ;
-					}
-					myfile << endl ;
-					compteur ++ ;
-				}
-			}
-		}
+	// The lower bound is only displayed, the format of the file is unchanged (it can be read back as an initial solution)
+	if (result.lowerBound > 0)
+		cout << " | lower bound : " << result.lowerBound << (result.isProvenOptimal ? " (optimal)" : "") ;
+	cout << " | in " << nomFichier.c_str() << endl ;
 
-		myfile.close();
+	// Printing the total time of the run
+	// (we print the number of clock ticks to help for short runs, the user will do the proper conversion) 
+	myfile << (long long) clock() << endl ;
+
+	// Printing the time to find the best solution
+	// (we print the number of clock ticks to help for short runs, the user will do the proper conversion) 
+	myfile << (long long) result.timeBest << endl ;
+
+	// Printing the routes and their content
+	for (int r=0 ; r < (int)result.routes.size() ; r++)
+	{
+		const RouteResult & route = result.routes[r] ;
+
+		// the routes are numbered from 1 for each day (and depot)
+		if (r > 0 && (route.day != result.routes[r-1].day || route.depot != result.routes[r-1].depot))
+			compteur = 1 ;
 
-		// Check the solution
-		if (!solutionChecker(allRoutes,allRoutesArcs,trainer->coutSol.distance,bestValide->maxRoute))
+		myfile << " " << route.depot ; // Printing the depot
+		myfile << " " << route.day ; // Printing the day
+		myfile << " " << compteur ; // Printing the index of the route
+		myfile << " " << route.load ; // Printing the total demand
+		myfile << " " << route.cost << " " ; // Printing the total cost of this route
+		myfile << " " << (int)route.visits.size() ; // Printing the number of customers in the route
+		for (int j=0 ; j < (int)route.visits.size() ; j++ ) // Printing the visits and their orientation
 		{
-			// If the solution does not pass the checker, then we erase the file (we will detect when running the script that some results are missing)
-			for (int i=0 ; i < 10 ; i++)
-				cout << "INFEASIBLE SOLUTION IN CHECKER -- ERASING SOLUTION !!!" << endl;
-			myfile.open(nomFichier.data(), std::ofstream::trunc);
-			myfile << "" << endl ;
-			myfile.close();
+			if (route.visits[j].service == -1)
+				myfile << " (D " << route.visits[j].depot << "," ;
+			else
+				myfile << " (S " << route.visits[j].service + params->nbDepots << "," ;
+			myfile << route.visits[j].node0 << "," ;
+			myfile << route.visits[j].node1 << ")" ;
 		}
+		myfile << endl ;
+		compteur ++ ;
+	}
+
+	myfile.close();
 
+	// Check the solution
+	if (!checkSolution(result))
+	{
+		// If the solution does not pass the checker, then we erase the file (we will detect when running the script that some results are missing)
+		for (int i=0 ; i < 10 ; i++)
+			cout << "INFEASIBLE SOLUTION IN CHECKER -- ERASING SOLUTION !!!" << endl;
+		myfile.open(nomFichier.data(), std::ofstream::trunc);
+		myfile << "" << endl ;
+		myfile.close();
+		return false ;
 	}
+	return true ;
+}
+
+void Population::ExportBest (string nomFichier) 
+{
+	SolverResult result ;
+	result.lowerBound = 0 ;
+	result.isProvenOptimal = false ;
+	if (getBestSolution(result))
+		writeSolution(result,nomFichier);
 	else
-	{
 		cout << "Impossible to find a feasible individual" << endl;
-	}
 }
 
 bool Population::solutionChecker(vector < vector < vector < int > > > & allRoutes, vector < vector < vector < pair <int,int > > > > & allRoutesArcs, double expectedCost, double expectedMaxRoute)
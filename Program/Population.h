@@ -25,8 +25,10 @@
 #include <time.h>
 #include "Noeud.h"
 #include "Individu.h"
+#include "SolverData.h"
 
 using namespace std ;
+class Checkpoint ;
 
 // Structure to manage a sub-population (feasible or infeasible solutions)
 struct SousPop
@@ -42,6 +44,9 @@ class Population
 {
    private:
 
+   // The checkpoints need to save and restore the complete state of the population
+   friend class Checkpoint ;
+
    // List to remember which of the 50 previous individuals were feasible in terms of load capacity
    list <bool> listeValiditeCharge ;
 
@@ -79,6 +84,9 @@ class Population
    // add all individuals from another population
    int addAllIndividus (Population * pop);
 
+   // add an individual built from a solution file (warm start), after education
+   void addIndividuFromFile (string nomFichier);
+
    // remove an individual in the population (chosen accoding to the biased fitness)
    void removeIndividu(SousPop * pop, int p);
    
@@ -118,6 +126,17 @@ class Population
    // Print the best solution in a file
    void ExportBest (string nomFichier) ;
 
+   // Get the routes of the best feasible solution, with the orientations of the services
+   // Returns false if there is no feasible solution
+   bool getBestSolution (SolverResult & result) ;
+
+   // Verify a solution obtained from getBestSolution with the solution checker
+   bool checkSolution (SolverResult & result) ;
+
+   // Write a solution obtained from getBestSolution in a file (erased if it does not pass the solution checker)
+   // Returns false if the solution did not pass the solution checker
+   bool writeSolution (SolverResult & result, string nomFichier) ;
+
    // Solution check
    // Verifies the cost and feasibility of the solution
    // Using only the instance data and the shortest path data (not relying on the auxiliary data structures)
@@ -156,7 +175,8 @@ class Population
    void updateAge ();
 
    // Constructor
-   Population(Params * params);
+   // if "createIndividus" is false, the population starts empty (e.g., its content will be restored from a checkpoint)
+   Population(Params * params, bool createIndividus);
 
    // Destructor
    ~Population();
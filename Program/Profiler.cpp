@@ -0,0 +1,75 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include "Profiler.h"
+#include <fstream>
+#include <string.h>
+
+ProfCompteur Profiler::compteurs [PROF_NB_OPERATEURS] ;
+
+const char * Profiler::noms [PROF_NB_OPERATEURS] = {
+	"interRouteGeneralInsert",
+	"interRoute2Opt",
+	"interRoute2OptInv",
+	"intraRouteGeneralInsertDroite",
+	"intraRoute2Opt",
+	"swapStar",
+	"ejectionChains",
+	"searchBetterPattern",
+	"updateRouteData",
+	"generalSplit",
+	"crossOX",
+	"crossPIX",
+	"addIndividu"
+};
+
+void Profiler::reset ()
+{
+	memset(compteurs, 0, sizeof(compteurs));
+}
+
+bool Profiler::exportJSON (string nomFichier)
+{
+	ofstream fichier (nomFichier.c_str());
+	if (!fichier.is_open()) return false ;
+
+	fichier << "{" << endl ;
+	#if defined(__x86_64__) || defined(__i386__)
+	fichier << "  \"unit\": \"tsc cycles\"," << endl ;
+	#else
+	fichier << "  \"unit\": \"nanoseconds\"," << endl ;
+	#endif
+	fichier << "  \"operators\": [" << endl ;
+	for (int i=0 ; i < PROF_NB_OPERATEURS ; i++)
+	{
+		fichier << "    {\"name\": \"" << noms[i] << "\"" ;
+		fichier << ", \"calls\": " << compteurs[i].appels ;
+		fichier << ", \"successes\": " << compteurs[i].succes ;
+		fichier << ", \"pruned\": " << compteurs[i].elagues ;
+		fichier << ", \"cycles\": " << compteurs[i].cycles ;
+		fichier << ", \"cyclesPerCall\": " << ((compteurs[i].appels > 0) ? (double)compteurs[i].cycles / (double)compteurs[i].appels : 0.) ;
+		fichier << ", \"skipped\": " << compteurs[i].ignores ;
+		// estimate of the duration of the skipped calls, at the mean duration of the calls which were made
+		fichier << ", \"cyclesSaved\": " << ((compteurs[i].appels > 0) ? (double)compteurs[i].cycles / (double)compteurs[i].appels * (double)compteurs[i].ignores : 0.) ;
+		fichier << "}" << ((i < PROF_NB_OPERATEURS - 1) ? "," : "") << endl ;
+	}
+	fichier << "  ]" << endl ;
+	fichier << "}" << endl ;
+	fichier.close();
+	return !fichier.fail() ;
+}
@@ -0,0 +1,128 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <string>
+#include <chrono>
+#include <stdint.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+using namespace std ;
+
+// Operators and procedures measured by the profiler
+enum ProfOperateur {
+	PROF_INTER_INSERT, // LocalSearch::interRouteGeneralInsert
+	PROF_INTER_2OPT, // LocalSearch::interRoute2Opt
+	PROF_INTER_2OPT_INV, // LocalSearch::interRoute2OptInv
+	PROF_INTRA_INSERT, // LocalSearch::intraRouteGeneralInsertDroite
+	PROF_INTRA_2OPT, // LocalSearch::intraRoute2Opt
+	PROF_SWAP_STAR, // LocalSearch::swapStar
+	PROF_EJECTION_CHAINS, // LocalSearch::ejectionChains
+	PROF_BETTER_PATTERN, // LocalSearch::searchBetterPattern
+	PROF_UPDATE_ROUTE, // Route::updateRouteData
+	PROF_SPLIT, // Individu::generalSplit
+	PROF_CROSS_OX, // Genetic::crossOX
+	PROF_CROSS_PIX, // Genetic::crossPIX
+	PROF_ADD_INDIVIDU, // Population::addIndividu
+	PROF_NB_OPERATEURS
+};
+
+// Counters of an operator
+struct ProfCompteur {
+
+	// number of calls
+	uint64_t appels ;
+
+	// number of calls which applied an improving move (LS operators) or inserted the individual (addIndividu)
+	uint64_t succes ;
+
+	// number of calls which ended on the lower bound, without exact evaluation of the move (LS operators)
+	uint64_t elagues ;
+
+	// number of calls skipped by the adaptive scheduling of the neighbourhoods (LS operators, see NeighbourhoodScheduler.h)
+	uint64_t ignores ;
+
+	// cumulative duration of the calls, including the nested measured procedures
+	// (cycles of the time stamp counter, or nanoseconds on other architectures)
+	uint64_t cycles ;
+};
+
+// Per-operator profiling of the search, only active when the program is compiled with the flag PROFILING (make PROFILING=1)
+// Otherwise the macros below are empty and the instrumentation has no cost
+// The counters are global to the process, and reset at the start of each resolution (see Solver)
+class Profiler
+{
+
+public:
+
+	// counters of each operator
+	static ProfCompteur compteurs [PROF_NB_OPERATEURS] ;
+
+	// names of the operators, as written in the JSON file
+	static const char * noms [PROF_NB_OPERATEURS] ;
+
+	// current value of the cycle counter
+	static uint64_t cycles ()
+	{
+		#if defined(__x86_64__) || defined(__i386__)
+		return __rdtsc() ;
+		#else
+		return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count() ;
+		#endif
+	}
+
+	// sets all counters to zero
+	static void reset ();
+
+	// writes the counters in a JSON file, returns false if the file could not be written
+	static bool exportJSON (string nomFichier);
+};
+
+// Measure of one call, from the construction of the object to the end of its scope
+struct ProfScope {
+
+	// measured operator
+	ProfOperateur op ;
+
+	// value of the cycle counter at the start of the call
+	uint64_t debut ;
+
+	ProfScope (ProfOperateur op) : op(op) { debut = Profiler::cycles() ; }
+
+	~ProfScope ()
+	{
+		Profiler::compteurs[op].appels ++ ;
+		Profiler::compteurs[op].cycles += Profiler::cycles() - debut ;
+	}
+};
+
+// Instrumentation of a function : PROFILE_SCOPE at the start, then PROFILE_SUCCESS or PROFILE_PRUNED before the corresponding returns
+#ifdef PROFILING
+#define PROFILE_SCOPE(op) ProfScope profScope (op)
+#define PROFILE_SUCCESS Profiler::compteurs[profScope.op].succes ++
+#define PROFILE_PRUNED Profiler::compteurs[profScope.op].elagues ++
+#else
+#define PROFILE_SCOPE(op)
+#define PROFILE_SUCCESS
+#define PROFILE_PRUNED
+#endif
+
+#endif
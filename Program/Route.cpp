@@ -17,6 +17,7 @@
 //  ---------------------------------------------------------------------- */
 
 #include "Route.h"
+#include "Profiler.h"
 
 Route::Route(void){}
 
@@ -33,6 +34,14 @@ Route::Route(int cour, Noeud * depot, Vehicle * vehicle, Params * params, Indivi
 		}
 		nodeAndRouteTested.push_back(false);
 	}
+	swapStarTested = vector <bool> (params->nombreVehicules[day],false);
+	proximityKnown = vector <bool> (params->nombreVehicules[day],false);
+	proximityFar = vector <bool> (params->nombreVehicules[day],false);
+	landmarkFromMin = vector <double> (params->landmarks.size());
+	landmarkFromMax = vector <double> (params->landmarks.size());
+	landmarkToMin = vector <double> (params->landmarks.size());
+	landmarkToMax = vector <double> (params->landmarks.size());
+	maxGranularRadius = 0. ;
 }
 
 Route::~Route(void){}
@@ -65,28 +74,33 @@ void Route::reverse ()
 
 void Route::updateRouteData (bool isForPrinting)
 {
+	PROFILE_SCOPE(PROF_UPDATE_ROUTE);
 	bool firstIt ;
 	int place = 0 ;
-	double Xvalue = 0 ;
-	double Yvalue = 0 ;
-	double nbNodes = 1 ;
+	int nbLandmarks = (int)params->landmarks.size() ;
+	double * from ;
+	double * to ;
+	double span ;
+	for (int l=0 ; l < nbLandmarks ; l++)
+	{
+		landmarkFromMin[l] = 1.e30 ;
+		landmarkFromMax[l] = -1.e30 ;
+		landmarkToMin[l] = 1.e30 ;
+		landmarkToMax[l] = -1.e30 ;
+	}
+	maxGranularRadius = 0. ;
 
 	// Computing the auxiliary data on any subsequence (0..i), using forward recursion
 	Noeud * noeud = depot ;
 	noeud->place = place ;
 	noeud->seq0_i->initialisation(noeud->cour,params,individu,day,isForPrinting);
 	noeud->seqi_0->initialisation(noeud->cour,params,individu,day,false);
-	Xvalue += params->cli[noeud->cour].coord.x ;
-	Yvalue += params->cli[noeud->cour].coord.y ;
 
 	firstIt = true ;
 	while (!noeud->estUnDepot || firstIt)
 	{
 		firstIt = false ;
 		noeud = noeud->suiv ;
-		Xvalue += params->cli[noeud->cour].coord.x ;
-		Yvalue += params->cli[noeud->cour].coord.y ;
-		nbNodes ++ ;
 		place ++ ;
 		noeud->place = place ;
 		if (isForPrinting)
@@ -94,6 +108,22 @@ void Route::updateRouteData (bool isForPrinting)
 		else
 			noeud->seq0_i->concatOneAfter(noeud->pred->seq0_i,noeud->cour,individu,day);
 		noeud->seqi_0->concatOneBefore(noeud->pred->seqi_0,noeud->cour,individu,day);
+
+		// Network summary of the route
+		if (!noeud->estUnDepot)
+		{
+			from = &params->landmarkFrom[noeud->cour*nbLandmarks] ;
+			to = &params->landmarkTo[noeud->cour*nbLandmarks] ;
+			span = params->serviceSpan[noeud->cour] ;
+			for (int l=0 ; l < nbLandmarks ; l++)
+			{
+				landmarkFromMin[l] = min(landmarkFromMin[l],from[l]) ;
+				landmarkFromMax[l] = max(landmarkFromMax[l],from[l] + span) ;
+				landmarkToMin[l] = min(landmarkToMin[l],to[l]) ;
+				landmarkToMax[l] = max(landmarkToMax[l],to[l] + span) ;
+			}
+			maxGranularRadius = max(maxGranularRadius,params->granularRadius[noeud->cour]) ;
+		}
 	}
 
 	// Computing the auxiliary data on any subsequence (i..n), using backward recursion
@@ -153,6 +183,24 @@ void Route::updateRouteData (bool isForPrinting)
 		isFeasible = false ;
 }
 
+double Route::distanceTo (Route * R)
+{
+	// timeCost[l][j] <= timeCost[l][i] + span(i) + timeCost[i][j] and timeCost[i][l] <= timeCost[i][j] + span(j) + timeCost[j][l]
+	double bound = 0. ;
+	if (depot->suiv->estUnDepot || R->depot->suiv->estUnDepot) return bound ;
+	for (int l=0 ; l < (int)params->landmarks.size() ; l++)
+	{
+		bound = max(bound,R->landmarkFromMin[l] - landmarkFromMax[l]) ;
+		bound = max(bound,landmarkToMin[l] - R->landmarkToMax[l]) ;
+	}
+	return bound ;
+}
+
+bool Route::isFarFrom (Route * R)
+{
+	return (distanceTo(R) > R->maxGranularRadius && R->distanceTo(this) > maxGranularRadius) ;
+}
+
 // no insertion are computed
 void Route::initiateInsertions()
 {
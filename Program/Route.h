@@ -79,6 +79,33 @@ vector < vector <Noeud *> > placeInsertionClient ;
 // For each node, a bool saying if all moves involving this node and route have been tested without success
 vector <bool> nodeAndRouteTested ;
 
+// For each other route of the same day, a bool saying if the SWAP* moves between the two routes have been tested without success
+vector <bool> swapStarTested ;
+
+// Network summary of the route, updated with the route data
+// For each landmark l, range of the distances timeCost[l][i] (from) and timeCost[i][l] (to) over the services i of the route
+// By the triangle inequality, these ranges give lower bounds on the distances between the services of the route and other services
+// The upper ends of the ranges include the span of the services, as the triangle inequality only holds up to this value (see Params::serviceSpan)
+vector <double> landmarkFromMin ;
+vector <double> landmarkFromMax ;
+vector <double> landmarkToMin ;
+vector <double> landmarkToMax ;
+
+// Largest granular radius of the services of the route
+double maxGranularRadius ;
+
+// Lower bound on the distance timeCost[i][j] from the services i of the route to the services j of another route, 0 if a route is empty
+// Only relies on the network summaries, in O(number of landmarks)
+double distanceTo (Route * R) ;
+
+// True if no service of the route can be in the list of close services of a service of the other route, and conversely
+bool isFarFrom (Route * R) ;
+
+// For each other route of the same day, is the result of isFarFrom known, and its value
+// Computed when needed by the local search, and reset with the other move flags when one of the routes is modified
+vector <bool> proximityKnown ;
+vector <bool> proximityFar ;
+
 // Reset the computation of all insertion values
 void initiateInsertions();
 
@@ -29,7 +29,7 @@
 void SeqData::initialisation(int Ucour, Params * mesParams, Individu * myIndiv, int day, bool isForPathTracking)
 {
 	params = mesParams ;
-	load = params->cli[Ucour].demandPatDay[myIndiv->chromP[Ucour].pat][day] ;
+	load = myIndiv->getCharge(Ucour,day) ;
 	distance = min(params->cli[Ucour].ar_serviceCost01,params->cli[Ucour].ar_serviceCost10) ;
 
 	bestCost00 = 1.e20 ; // Cannot start and finish in the same extremity if we have a single node in the sequence
@@ -81,7 +81,7 @@ void SeqData::concatOneAfter(SeqData * seq,int Vcour, Individu * myIndiv, int da
 	distance = min(min(bestCost01,bestCost11),min(bestCost00,bestCost10));
 
 	// Load pre-processing
-	load = seq->load + params->cli[Vcour].demandPatDay[myIndiv->chromP[Vcour].pat][day];
+	load = seq->load + myIndiv->getCharge(Vcour,day);
 	firstNode = seq->firstNode ;
 	lastNode = Vcour ;
 }
@@ -127,7 +127,7 @@ void SeqData::concatOneAfterWithPathTracking(SeqData * seq,int Vcour, Individu *
 	distance = min(min(bestCost01,bestCost11),min(bestCost00,bestCost10));
 
 	// Load pre-processing
-	load = seq->load + params->cli[Vcour].demandPatDay[myIndiv->chromP[Vcour].pat][day];
+	load = seq->load + myIndiv->getCharge(Vcour,day);
 	firstNode = seq->firstNode ;
 	lastNode = Vcour ;
 }
@@ -162,7 +162,7 @@ void SeqData::concatOneBefore(SeqData * seq,int Vcour, Individu * myIndiv, int d
 	distance = min(min(bestCost01,bestCost11),min(bestCost00,bestCost10));
 
 	// Load pre-processing
-	load = seq->load + params->cli[Vcour].demandPatDay[myIndiv->chromP[Vcour].pat][day];
+	load = seq->load + myIndiv->getCharge(Vcour,day);
 	firstNode = Vcour ;
 	lastNode = seq->lastNode ;
 }
@@ -292,7 +292,7 @@ double SeqData::evaluation(SeqData * seq1, SeqData * seq2, SeqData * seq3, SeqDa
 }
 
 
-double SeqData::evaluation(vector <SeqData *> seqs, Vehicle * vehicle) 
+double SeqData::evaluation(vector <SeqData *> & seqs, Vehicle * vehicle) 
 {
 	SeqData *seqbPred = seqs[0];
 	SeqData *seqb ;
@@ -388,7 +388,7 @@ double SeqData::evaluationLB(SeqData * seq1, SeqData * seq2, SeqData * seq3, Seq
 		+ max(totDistance - vehicle->maxRouteTime,0.0)*params->penalityLength ;
 }
 
-double SeqData::evaluationLB(vector <SeqData *> seqs, Vehicle * vehicle) 
+double SeqData::evaluationLB(vector <SeqData *> & seqs, Vehicle * vehicle) 
 {
 	SeqData *seqbPred = seqs[0];
 	SeqData *seqb = seqs[1];
@@ -467,7 +467,7 @@ SeqData::~SeqData()
 void SeqData::initialisation(int Ucour, Params * mesParams, Individu * myIndiv, int day,bool isForPathTracking)
 {
 	params = mesParams ;
-	load = params->cli[Ucour].demandPatDay[myIndiv->chromP[Ucour].pat][day] ;
+	load = myIndiv->getCharge(Ucour,day) ;
 
 	if (!isInitialized)
 	{
@@ -533,7 +533,7 @@ void SeqData::concatOneAfter(SeqData * seq, int Vcour, Individu * myIndiv, int d
 		}
 	}
 
-	load = seq->load + params->cli[Vcour].demandPatDay[myIndiv->chromP[Vcour].pat][day];
+	load = seq->load + myIndiv->getCharge(Vcour,day);
 	firstNode = seq->firstNode ;
 	lastNode = Vcour ;
 }
@@ -574,7 +574,7 @@ void SeqData::concatOneAfterWithPathTracking(SeqData * seq, int Vcour, Individu
 		}
 	}
 
-	load = seq->load + params->cli[Vcour].demandPatDay[myIndiv->chromP[Vcour].pat][day];
+	load = seq->load + myIndiv->getCharge(Vcour,day);
 	firstNode = seq->firstNode ;
 	lastNode = Vcour ;
 }
@@ -602,7 +602,7 @@ void SeqData::concatOneBefore(SeqData * seq,int Vcour, Individu * myIndiv, int d
 		}
 	}
 
-	load = seq->load + params->cli[Vcour].demandPatDay[myIndiv->chromP[Vcour].pat][day];
+	load = seq->load + myIndiv->getCharge(Vcour,day);
 	firstNode = Vcour ;
 	lastNode = seq->lastNode ;
 }
@@ -713,7 +713,7 @@ double SeqData::evaluation(SeqData * seq1, SeqData * seq2, SeqData * seq3, SeqDa
 	return evaluation(seqs,vehicle);
 }
 
-double SeqData::evaluation(vector <SeqData *> seqs, Vehicle * vehicle) 
+double SeqData::evaluation(vector <SeqData *> & seqs, Vehicle * vehicle) 
 {
 	double tempc ;
 	Client * cliPredLast ;
@@ -782,7 +782,7 @@ double SeqData::evaluationLB(SeqData * seq1, SeqData * seq2, SeqData * seq3, Seq
 	+ max(seq1->load + seq2->load + seq3->load + seq4->load - vehicle->vehicleCapacity,0.0)*params->penalityCapa ;
 }
 
-double SeqData::evaluationLB(vector <SeqData *> seqs, Vehicle * vehicle) 
+double SeqData::evaluationLB(vector <SeqData *> & seqs, Vehicle * vehicle) 
 {
 	SeqData *seqbPred = seqs[0];
 	SeqData *seqb = seqs[1];
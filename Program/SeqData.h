@@ -86,14 +86,14 @@ public:
 	double evaluation(SeqData * seq1, SeqData * seq2, Vehicle * vehicle, double & mydist, double & mytminex, double & myloadex);
 	double evaluation(SeqData * seq1, SeqData * seq2, SeqData * seq3, Vehicle * vehicle);
 	double evaluation(SeqData * seq1, SeqData * seq2, SeqData * seq3, SeqData * seq4, Vehicle * vehicle);
-	double evaluation(vector <SeqData *> seqs, Vehicle * vehicle);
+	double evaluation(vector <SeqData *> & seqs, Vehicle * vehicle);
 
 	// The same evaluators, but to get lower bounds on move evaluations
 	double evaluationLB(SeqData * seq1, Vehicle * vehicle);
 	double evaluationLB(SeqData * seq1, SeqData * seq2, Vehicle * vehicle);
 	double evaluationLB(SeqData * seq1, SeqData * seq2, SeqData * seq3, Vehicle * vehicle);
 	double evaluationLB(SeqData * seq1, SeqData * seq2, SeqData * seq3, SeqData * seq4, Vehicle * vehicle);
-	double evaluationLB(vector <SeqData *> seqs, Vehicle * vehicle);
+	double evaluationLB(vector <SeqData *> & seqs, Vehicle * vehicle);
 
 	// Constructors
 	SeqData(Params * params);
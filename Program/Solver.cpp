@@ -0,0 +1,499 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include "Solver.h"
+#include "Checkpoint.h"
+#include "IslandExchange.h"
+#include "Profiler.h"
+#include "LowerBound.h"
+#include "MemoryEstimate.h"
+#include <sys/resource.h>
+
+Solver::Solver(int type) : type(type)
+{
+	instance = NULL ;
+	anytimeWriter = NULL ;
+	checkpoint = NULL ;
+	trace = NULL ;
+	islands = NULL ;
+	memoireEstimee = 0 ;
+	seed = 0 ;
+	timeLimit = 300 ;
+	maxIterations = 0 ;
+	maxEvaluationsLS = 0 ;
+	maxSplits = 0 ;
+	deadline = 0 ;
+	nbVeh = -1 ;
+	nbDep = -1 ;
+	nbDepotsProches = 0 ;
+	traces = true ;
+	pathToSolution = "" ;
+	pathToBKS = "" ;
+	pathToAnytime = "" ;
+	pathToCache = "" ;
+	pathToCheckpoint = "" ;
+	checkpointFreq = 60 ;
+	pathToResume = "" ;
+	pathToInit = "" ;
+	pathToProfile = "" ;
+	pathToTrace = "" ;
+	traceInterval = 100 ;
+	pathToStatistics = "" ;
+	decompositionSize = 0 ;
+	decompositionInterval = 5000 ;
+	islandName = "" ;
+	islandInterval = 100 ;
+	adaptiveScheduling = false ;
+	adaptiveGranularity = false ;
+	stopAtLowerBound = true ;
+	maxMemory = 0 ;
+}
+
+Solver::~Solver()
+{
+	clear();
+}
+
+void Solver::clear()
+{
+	FreeClear (populationTab) ;
+	FreeClear (mesParametresTab) ;
+	delete anytimeWriter ;
+	anytimeWriter = NULL ;
+	delete checkpoint ;
+	checkpoint = NULL ;
+	delete trace ;
+	trace = NULL ;
+	delete islands ;
+	islands = NULL ;
+}
+
+void Solver::rejoindreIslands(Genetic & genetic)
+{
+	if (islandName == "")
+		return ;
+	if (islands == NULL)
+		islands = new IslandExchange(islandName,genetic.params,16) ;
+	genetic.islands = islands ;
+	genetic.migrationInterval = islandInterval ;
+}
+
+SolverResult Solver::solve(string nomInstance)
+{
+	instance = NULL ;
+	pathToInstance = nomInstance ;
+	return run();
+}
+
+SolverResult Solver::solve(const InstanceInput & instance)
+{
+	this->instance = &instance ;
+	pathToInstance = "" ;
+	return run();
+}
+
+Params * Solver::creerParams(int nbVeh, bool isSearchingFeasible)
+{
+	if (instance == NULL)
+		mesParametresTab.push_back(new Params(pathToInstance,pathToSolution,pathToBKS,seed,type,nbVeh,nbDep,isSearchingFeasible,pathToCache)) ;
+	else
+		mesParametresTab.push_back(new Params(*instance,seed,type,nbVeh,isSearchingFeasible)) ;
+	mesParametresTab.back()->stopToken = &stopToken ;
+
+	// A stop requested before the first population is built cancels the resolution, as there is no solution to return yet
+	if (populationTab.empty() && stopToken.hasStopRequest())
+		throw string("The resolution has been interrupted before the search") ;
+	mesParametresTab.back()->ordonnanceur.isAdaptatif = adaptiveScheduling ;
+	mesParametresTab.back()->isGranulariteAdaptative = adaptiveGranularity ;
+	if (nbDepotsProches > 0) mesParametresTab.back()->restreindreDepots(nbDepotsProches) ;
+
+	// Memory of the run, possibly reduced to the budget, displayed for the first run and when the structures are reduced
+	MemoryEstimate memoire ;
+	bool isReduit = false ;
+	if (maxMemory > 0)
+		isReduit = memoire.adapteBudget(mesParametresTab.back(),maxMemory*1024.*1024.) ;
+	else
+		memoire.calcul(mesParametresTab.back());
+	memoireEstimee = max(memoireEstimee,memoire.total()) ;
+	if (traces && (mesParametresTab.size() == 1 || isReduit))
+		memoire.affiche();
+	if (traces && isReduit)
+		cout << "Memory budget of " << maxMemory << " MB : sizeSD " << mesParametresTab.back()->sizeSD << ", working individuals without the structures of Split" << endl ;
+	return mesParametresTab.back() ;
+}
+
+SolverResult Solver::run()
+{
+	SolverResult result ;
+	result.isFeasible = false ;
+	result.lowerBound = 0 ;
+	result.isProvenOptimal = false ;
+	result.nbIterations = 0 ;
+	memoireEstimee = 0 ;
+	result.nbMovesLS = 0 ;
+	result.nbSplits = 0 ;
+	result.nbEvaluationsLS = 0 ;
+	result.neighbourhoodEvaluations.assign(NB_VOISINAGES,0) ;
+	result.neighbourhoodImprovements.assign(NB_VOISINAGES,0) ;
+	result.neighbourhoodSkipped.assign(NB_VOISINAGES,0) ;
+	chrono::steady_clock::time_point debut = chrono::steady_clock::now() ;
+	clock_t debutCPU = clock() ;
+	clear();
+
+	// The stop requests are only cleared at the end of a resolution, such that a signal received before the search
+	// (e.g. during the parsing and preprocessing of a large instance) cancels the resolution
+	if (deadline > 0) stopToken.setDeadline(deadline);
+	Profiler::reset();
+
+	try
+	{
+		// Optional reporting of each new best solution during the search, done by a background thread
+		if (pathToAnytime != "")
+			anytimeWriter = new AnytimeWriter(pathToAnytime);
+
+		// Optional trace of the convergence, its summary is written at the end of the resolution
+		if (pathToTrace != "")
+			trace = new ConvergenceTrace(pathToTrace,traceInterval);
+
+		// Optional periodic saving of the state of the search, and possibly resuming the search from a previous checkpoint
+		if (pathToCheckpoint != "")
+		{
+			checkpoint = new Checkpoint(pathToCheckpoint,checkpointFreq);
+			if (pathToResume != "")
+				checkpoint->load(pathToResume);
+		}
+
+		// For the PCARP, we need to minimize fleet size as first objective, then minimize distance as second objective
+		// For the MM-kWRPP, we need to minimize the length of the maximum route
+		if (type == 32 || type == 35)
+			solveHierarchical(result);
+		else
+			solveDistance(result);
+	}
+	catch(const string& e)
+	{
+		clear();
+		stopToken.reset();
+		throw ;
+	}
+
+	// Statistics of the resolution
+	for (int i=0 ; i < (int)mesParametresTab.size() ; i++)
+	{
+		result.nbSplits += mesParametresTab[i]->nbSplits ;
+		result.nbEvaluationsLS += mesParametresTab[i]->nbEvaluationsLS ;
+		for (int v=0 ; v < NB_VOISINAGES ; v++)
+		{
+			result.neighbourhoodEvaluations[v] += mesParametresTab[i]->ordonnanceur.nbEvaluations[v] ;
+			result.neighbourhoodImprovements[v] += mesParametresTab[i]->ordonnanceur.nbSucces[v] ;
+			result.neighbourhoodSkipped[v] += mesParametresTab[i]->ordonnanceur.nbIgnores[v] ;
+		}
+	}
+	result.wallTime = chrono::duration<double>(chrono::steady_clock::now() - debut).count() ;
+	result.cpuTime = (double)(clock() - debutCPU)/(double)CLOCKS_PER_SEC ;
+	struct rusage usage ;
+	getrusage(RUSAGE_SELF,&usage);
+	result.peakMemory = usage.ru_maxrss ;
+	result.estimatedMemory = (long)(memoireEstimee / 1024.) ;
+
+	clear();
+	stopToken.reset();
+
+	if (pathToStatistics != "")
+		exportStatistics(result);
+
+	#ifdef PROFILING
+	if (pathToProfile != "" && !Profiler::exportJSON(pathToProfile))
+		cout << "WARNING : impossible to write the profile file " << pathToProfile << endl ;
+	#endif
+	return result ;
+}
+
+void Solver::addStatistics(Genetic & genetic, SolverResult & result)
+{
+	result.nbIterations += genetic.getNbIter() ;
+	result.nbMovesLS += genetic.rejeton->localSearch->nbTotalRISinceBeginning + genetic.rejeton->localSearch->nbTotalPISinceBeginning ;
+}
+
+void Solver::exportStatistics(SolverResult & result)
+{
+	ofstream myfile(pathToStatistics.c_str());
+	if (!myfile.is_open())
+	{
+		cout << "WARNING : impossible to write the statistics file " << pathToStatistics << endl ;
+		return ;
+	}
+	myfile.precision(10);
+	myfile << "{" << endl ;
+	myfile << "  \"feasible\": " << (result.isFeasible ? "true" : "false") << "," << endl ;
+	myfile << "  \"distance\": " << (result.isFeasible ? result.distance : 0) << "," << endl ;
+	myfile << "  \"maxRoute\": " << (result.isFeasible ? result.maxRoute : 0) << "," << endl ;
+	myfile << "  \"nbRoutes\": " << (result.isFeasible ? result.nbRoutes : 0) << "," << endl ;
+	myfile << "  \"lowerBound\": " << result.lowerBound << "," << endl ;
+	myfile << "  \"provenOptimal\": " << (result.isProvenOptimal ? "true" : "false") << "," << endl ;
+	myfile << "  \"iterations\": " << result.nbIterations << "," << endl ;
+	myfile << "  \"movesLS\": " << result.nbMovesLS << "," << endl ;
+	myfile << "  \"evaluationsLS\": " << result.nbEvaluationsLS << "," << endl ;
+	myfile << "  \"splits\": " << result.nbSplits << "," << endl ;
+	myfile << "  \"neighbourhoods\": [" << endl ;
+	for (int v=0 ; v < (int)result.neighbourhoodEvaluations.size() ; v++)
+	{
+		myfile << "    {\"name\": \"" << NeighbourhoodScheduler::noms[v] << "\"" ;
+		myfile << ", \"evaluations\": " << result.neighbourhoodEvaluations[v] ;
+		myfile << ", \"improvements\": " << result.neighbourhoodImprovements[v] ;
+		myfile << ", \"skipped\": " << result.neighbourhoodSkipped[v] ;
+		myfile << "}" << ((v < (int)result.neighbourhoodEvaluations.size() - 1) ? "," : "") << endl ;
+	}
+	myfile << "  ]," << endl ;
+	myfile << "  \"wallTime\": " << result.wallTime << "," << endl ;
+	myfile << "  \"cpuTime\": " << result.cpuTime << "," << endl ;
+	myfile << "  \"estimatedMemoryKB\": " << result.estimatedMemory << "," << endl ;
+	myfile << "  \"peakMemoryKB\": " << result.peakMemory << endl ;
+	myfile << "}" << endl ;
+	myfile.close();
+}
+
+void Solver::exportResult(Population * population, SolverResult & result)
+{
+	if (population->getBestSolution(result))
+	{
+		result.isProvenOptimal = LowerBound::isAtteinte(result.distance,result.lowerBound) ;
+		if (pathToSolution != "")
+			result.isFeasible = population->writeSolution(result,pathToSolution);
+		else
+			result.isFeasible = population->checkSolution(result);
+		result.isProvenOptimal = result.isProvenOptimal && result.isFeasible ;
+	}
+	else if (pathToSolution != "")
+		cout << "Impossible to find a feasible individual" << endl;
+
+	if (pathToBKS != "")
+		population->ExportBKS(pathToBKS);
+}
+
+/* CLASSIC CASE OF OPTIMIZATION, BASED ON DISTANCE : for the CVRP, CARP, NEARP, MDCARP... */
+void Solver::solveDistance(SolverResult & result)
+{
+
+	// initialisation of the Parameters
+	Params * mesParametres = creerParams(nbVeh,false) ;
+
+	// Lower bound on the distance, which can prove the optimality of the solution
+	chrono::steady_clock::time_point debutBorne = chrono::steady_clock::now() ;
+	result.lowerBound = LowerBound::calcul(mesParametres) ;
+	if (traces && result.lowerBound > 0)
+		cout << "Lower bound : " << result.lowerBound << " | computed in " << chrono::duration<double>(chrono::steady_clock::now() - debutBorne).count() << " seconds" << endl ;
+
+	// Running the algorithm (when resuming, the population and the state of the search come from the checkpoint)
+	bool isResuming = (checkpoint != NULL && checkpoint->isLoaded) ;
+	if (isResuming && checkpoint->phase != 0)
+		throw string("The checkpoint file does not correspond to this problem type");
+	populationTab.push_back(new Population(mesParametres,!isResuming)) ;
+	Population * population = populationTab.back() ;
+	if (!isResuming && pathToInit != "") population->addIndividuFromFile(pathToInit);
+	Genetic genetic(mesParametres,population,timeLimit,traces);
+	genetic.anytimeWriter = anytimeWriter ;
+	genetic.checkpoint = checkpoint ;
+	genetic.trace = trace ;
+	genetic.nbIterMax = maxIterations ;
+	genetic.nbEvaluationsMax = maxEvaluationsLS ;
+	genetic.nbSplitsMax = maxSplits ;
+	genetic.decompositionSize = decompositionSize ;
+	genetic.decompositionInterval = decompositionInterval ;
+	if (stopAtLowerBound) genetic.borneInferieure = result.lowerBound ;
+	rejoindreIslands(genetic);
+	if (isResuming) checkpoint->restore(&genetic);
+
+	genetic.evolve(20000,1); // First parameter (20000) controls the number of iterations without improvement before termination
+	addStatistics(genetic,result);
+
+	// Returning the solution
+	exportResult(population,result);
+}
+
+/* SOME PROBLEMS CONSIDERED IN THE PAPER INVOLVE ANOTHER OBJECTIVE, such as fleet size minimization, or minimization of the maximum tour */
+/* THIS IS DONE HERE BY RUNNING ITERATIVELY THE ALGORITHM with a decreasing fleet or distance constraint */
+// fleet size minimization (PCARP) -- applying the algorithm with a decreasing fleet size, as long as a feasible solution is found
+// or minimization of the maximum tour (MM-kWRPP) -- applying the algorithm with a decreasing tour duration constraint
+void Solver::solveHierarchical(SolverResult & result)
+{
+	bool minFleetSize = (type == 32) ;
+	bool minMaxTour = (type == 35) ;
+	int nbpop = 0 ;
+	int nbOverallLoop = 0 ;
+	bool isResuming ;
+	Population * lastPop = NULL ;
+	Population * population2 ;
+	Params * mesParametres2 ;
+
+	int veh = nbVeh ; // start with an upper bound on the number of vehicles
+	double distConstraint = 1.e30 ; // or with a permissive distance constraint
+	bool validExist = true;
+
+	// When resuming the loop from a checkpoint, we restart from the saved fleet size or distance constraint
+	// and rebuild the previous population which is still needed in the next iterations
+	if (checkpoint != NULL && checkpoint->isLoaded && checkpoint->phase == 1)
+	{
+		veh = checkpoint->veh ;
+		distConstraint = checkpoint->distConstraint ;
+		nbOverallLoop = checkpoint->nbOverallLoop - 1 ;
+		for (int i=0 ; i < (int)checkpoint->vehPrecedentes.size() ; i++)
+		{
+			creerParams(checkpoint->vehPrecedentes[i],true) ;
+			for (int v=0 ; v < mesParametresTab[i]->nbVehiculesPerDep ; v++) 
+				mesParametresTab[i]->ordreVehicules[1][v].maxRouteTime = checkpoint->distConstraintPrecedentes[i] ;
+			populationTab.push_back(new Population(mesParametresTab[i],false)) ;
+			checkpoint->restorePopulation(i,populationTab[i]);
+		}
+	}
+	// or directly from the last run minimizing the distance
+	else if (checkpoint != NULL && checkpoint->isLoaded && checkpoint->phase == 2)
+		validExist = false ;
+	else if (checkpoint != NULL && checkpoint->isLoaded)
+		throw string("The checkpoint file does not correspond to this problem type");
+	// (unless the search has been stopped, in which case we keep the last feasible solution)
+	while (validExist && !stopToken.isStopped()) // A feasible solution has been found, we can continue to decrease (either the number of vehicles or the distance constraint, depending on the case)
+	{	
+		// Setting the parameters of the next problem
+		creerParams(veh,true) ;
+		nbpop = (int)mesParametresTab.size() ;
+		nbOverallLoop ++ ; // counting the number of subproblems which have been resolved
+
+		// For safety, to evacuate any chance of infinite loop and printout.
+		// No considered instances should lead to more than 10000 overall modifications of the fleet size or distance constraint
+		if (nbOverallLoop >= 10000)
+			throw string ("Fleet or distance minimization, too many overall loops, there must be a problem, aborting the run");
+
+		// Setting the distance constraint (only effective for the MM-kWRPP)
+		for (int v=0 ; v < mesParametresTab[nbpop-1]->nbVehiculesPerDep ; v++) 
+			mesParametresTab[nbpop-1]->ordreVehicules[1][v].maxRouteTime = distConstraint ;
+
+		// Keeping the current penalty values
+		if (lastPop != NULL) 
+		{
+			mesParametresTab[nbpop-1]->penalityCapa = lastPop->params->penalityCapa ; 
+			mesParametresTab[nbpop-1]->penalityLength = lastPop->params->penalityLength ;
+		}
+
+		// Constructing the new population
+		isResuming = (checkpoint != NULL && checkpoint->isLoaded) ;
+		populationTab.push_back (new Population(mesParametresTab[nbpop-1],!isResuming)) ;
+
+		// Adding the individuals found in previous iterations to help the search to start
+		if (!isResuming && nbpop >= 2) populationTab[nbpop-1]->addAllIndividus(populationTab[nbpop-2]);
+		if (!isResuming && nbpop >= 3) populationTab[nbpop-1]->addAllIndividus(populationTab[nbpop-3]);
+		// or the initial solution given by the user, for the first problem of the sequence
+		if (!isResuming && nbpop == 1 && pathToInit != "") populationTab[nbpop-1]->addIndividuFromFile(pathToInit);
+		// Solving
+		Genetic genetic(mesParametresTab[nbpop-1],populationTab[nbpop-1],timeLimit,traces);
+		genetic.anytimeWriter = anytimeWriter ;
+		genetic.checkpoint = checkpoint ;
+		genetic.trace = trace ;
+		genetic.nbIterMax = maxIterations ;
+		genetic.nbEvaluationsMax = maxEvaluationsLS ;
+		genetic.nbSplitsMax = maxSplits ;
+		rejoindreIslands(genetic);
+		if (checkpoint != NULL)
+		{
+			// Position in the loop, and population still needed after this run
+			checkpoint->phase = 1 ;
+			checkpoint->veh = veh ;
+			checkpoint->distConstraint = distConstraint ;
+			checkpoint->nbOverallLoop = nbOverallLoop ;
+			checkpoint->populationsPrecedentes.clear();
+			if (nbpop >= 2) checkpoint->populationsPrecedentes.push_back(populationTab[nbpop-2]);
+		}
+		if (isResuming) checkpoint->restore(&genetic);
+		cout << "######### GA evolution ######### : " << "| FLEET SIZE : " << veh << " | DIST CONSTRAINT : " << mesParametresTab[nbpop-1]->ordreVehicules[1][0].maxRouteTime <<  endl ;
+		genetic.evolve(2000,1);
+		addStatistics(genetic,result);
+		
+		// Checking if we need to go to the next fleet or distance constraint value
+		if (populationTab[nbpop-1]->getIndividuBestValide () != NULL)
+		{
+			if (minFleetSize) 
+				veh -- ; // reducing the fleet size (PCARP)
+			else if (minMaxTour) 
+				distConstraint = populationTab[nbpop-1]->getIndividuBestValide()->maxRoute -1 ; // or reducing the distance below the best current solution (MM-kWRPP)
+		}
+		else 
+			validExist = false ;
+		
+		// in the case of fleet size minimization for the PCARP, we can test to see if there is enough capacity left to service all customers (trivial lower bound on fleet size)
+		// in this case, don't need to pursue the search further
+		if (minFleetSize && mesParametresTab[nbpop-1]->totalDemand > veh*mesParametresTab[nbpop-1]->ordreVehicules[1][0].vehicleCapacity*mesParametresTab[nbpop-1]->nbDays) 
+		{
+			cout << "Insufficient capacity -- we can stop decreasing the fleet size" << endl ;
+			validExist = false ;
+		}
+
+		cout << "  " << endl ;
+	}
+
+	// Case of the minimization of the max route length
+	// At the end of the process, the search is finished, we return the solution
+	if (minMaxTour)
+	{
+		// (if the search has been stopped, the last run may also have found a feasible solution)
+		if (validExist && nbpop >= 1)
+			exportResult(populationTab[nbpop-1],result);
+		else if (nbpop >= 2)
+			exportResult(populationTab[nbpop-2],result);
+		else
+			cout << "Impossible to find a feasible individual" << endl;
+	}
+	else
+	// Case of the minimization of the fleet size
+	// We should not forget the secondary objective in the hierarchy, which is now to minimize the distance for the resulting fleet size
+	// Thus, a last optimization run is done
+	{
+		isResuming = (checkpoint != NULL && checkpoint->isLoaded) ;
+		if (isResuming) 
+			veh = checkpoint->veh ;
+		else
+			veh ++ ;
+		cout << "######### Second phase : minimizing Distance with " << veh << " vehicles" << endl ;
+		mesParametres2 = creerParams(veh,false) ;
+		populationTab.push_back(new Population(mesParametres2,!isResuming)) ;
+		population2 = populationTab.back() ;
+		if (!isResuming && nbpop >= 1 && populationTab[nbpop-1]->getIndividuBestValide() != NULL) 
+			population2->addAllIndividus(populationTab[nbpop-1]);
+		else if (!isResuming && nbpop >= 2) 
+			population2->addAllIndividus(populationTab[nbpop-2]);
+		Genetic genetic(mesParametres2,population2,timeLimit,traces);
+		genetic.anytimeWriter = anytimeWriter ;
+		genetic.checkpoint = checkpoint ;
+		genetic.trace = trace ;
+		genetic.nbIterMax = maxIterations ;
+		genetic.nbEvaluationsMax = maxEvaluationsLS ;
+		genetic.nbSplitsMax = maxSplits ;
+		rejoindreIslands(genetic);
+		if (checkpoint != NULL)
+		{
+			checkpoint->phase = 2 ;
+			checkpoint->veh = veh ;
+			checkpoint->populationsPrecedentes.clear();
+		}
+		if (isResuming) checkpoint->restore(&genetic);
+		genetic.evolve(10000,1);
+		addStatistics(genetic,result);
+
+		// Returning the final solution
+		exportResult(population2,result);
+	}
+}
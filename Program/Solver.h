@@ -0,0 +1,202 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <string>
+#include <vector>
+#include "Genetic.h"
+#include "SolverData.h"
+#include "StopToken.h"
+using namespace std ;
+class Checkpoint ;
+class IslandExchange ;
+
+// Entry point of the library : solves an instance given as a file or in memory, and returns the best solution
+// The three flows of the method are handled here : distance minimization (CARP, NEARP, MDCARP, NEARP-TP),
+// fleet size minimization followed by distance minimization (PCARP), and minimization of the maximum route (MM-kWRPP)
+class Solver
+{
+
+private:
+
+	// instance given in memory (NULL if the instance is read from a file)
+	const InstanceInput * instance ;
+
+	// path of the instance file (if the instance is read from a file)
+	string pathToInstance ;
+
+	// parameters and populations of the successive runs of the HGA
+	vector < Params * > mesParametresTab ;
+	vector < Population * > populationTab ;
+
+	// optional background writer of the new best solutions
+	AnytimeWriter * anytimeWriter ;
+
+	// optional periodic saving of the state of the search
+	Checkpoint * checkpoint ;
+
+	// optional machine-readable trace of the convergence
+	ConvergenceTrace * trace ;
+
+	// optional exchange of individuals with other processes (created with the parameters of the first run of the HGA)
+	IslandExchange * islands ;
+
+	// largest projected peak memory of the runs of the HGA, in bytes (see MemoryEstimate.h)
+	double memoireEstimee ;
+
+	// attaches the runs of the HGA to the islands, if requested
+	void rejoindreIslands (Genetic & genetic) ;
+
+	// creates the parameters of a run with a given fleet size, and keeps them in mesParametresTab
+	// its memory is estimated, and adapted to the budget maxMemory
+	Params * creerParams (int nbVeh, bool isSearchingFeasible) ;
+
+	// distance minimization, single run of the HGA
+	void solveDistance (SolverResult & result) ;
+
+	// fleet size minimization (PCARP) or minimization of the maximum route (MM-kWRPP), several runs of the HGA
+	void solveHierarchical (SolverResult & result) ;
+
+	// gets the best solution of a population, and writes the solution and BKS files if requested
+	void exportResult (Population * population, SolverResult & result) ;
+
+	// adds the statistics of a run of the HGA to the result
+	void addStatistics (Genetic & genetic, SolverResult & result) ;
+
+	// writes the solution value and the statistics of the resolution in a JSON file
+	void exportStatistics (SolverResult & result) ;
+
+	// common part of the two "solve" functions
+	SolverResult run () ;
+
+	// frees all data structures of the last run
+	void clear () ;
+
+public:
+
+	/* SETTINGS OF THE SOLVER (same meaning as the commandline options of gencarp) */
+
+	// problem type (see the list in Params.h)
+	int type ;
+
+	// seed of the random number generator (0 to use the time)
+	int seed ;
+
+	// time allowed for each run of the HGA (several runs for the PCARP and MM-kWRPP), in seconds of wall-clock time
+	double timeLimit ;
+
+	// work budgets of each run of the HGA (0 if no limit) : number of iterations, of move evaluations of the local search, and of calls to Split
+	// with a fixed seed and no time limit reached, the search trajectory is the same on any machine, e.g., to compare the speed of two versions
+	int maxIterations ;
+	long long maxEvaluationsLS ;
+	long long maxSplits ;
+
+	// time allowed for the whole resolution, in seconds of wall-clock time (0 if no deadline)
+	// when it is reached, the search finishes as soon as possible and returns its best solution
+	double deadline ;
+
+	// cooperative stop of the search : stopToken.requestStop() (e.g., from another thread) finishes the current resolution
+	// as soon as possible with its best solution (a stop requested before the search, including before the start of the resolution, cancels it,
+	// and the requests are cleared at the end of each resolution)
+	StopToken stopToken ;
+
+	// fleet size per depot (-1 to use the value of the instance, required for the MM-kWRPP and as a starting value for the PCARP)
+	int nbVeh ;
+
+	// number of depots, for the MDCARP instances read from a file (for the instances in memory, this is the number of depots given)
+	int nbDep ;
+
+	// (MDCARP) number of closest depots from which each service can be serviced, 0 for all depots (see Params::restreindreDepots)
+	int nbDepotsProches ;
+
+	// says if the traces of the search are displayed
+	bool traces ;
+
+	// paths of the solution file and the BKS file (not written if empty)
+	string pathToSolution ;
+	string pathToBKS ;
+
+	// path of the file where each new best solution is written during the search (not used if empty)
+	string pathToAnytime ;
+
+	// directory of the cache of preprocessed instances, only for instance files (not used if empty)
+	string pathToCache ;
+
+	// checkpoints : file where the state of the search is saved, number of seconds between two checkpoints, and file to resume from (not used if empty)
+	string pathToCheckpoint ;
+	int checkpointFreq ;
+	string pathToResume ;
+
+	// solution file used to warm start the search (not used if empty)
+	string pathToInit ;
+
+	// JSON file receiving the per-operator counters at the end of the resolution
+	// (only when the program is compiled with the flag PROFILING, see Profiler.h, not written if empty)
+	string pathToProfile ;
+
+	// CSV (or JSON lines, for a ".jsonl" file) trace of the convergence, see ConvergenceTrace.h (not written if empty),
+	// and number of iterations between two periodic records of the trace (0 to record only the improvements)
+	string pathToTrace ;
+	int traceInterval ;
+
+	// JSON file receiving the solution value and the statistics of the resolution (see SolverResult, not written if empty)
+	string pathToStatistics ;
+
+	// decomposition phases of the HGA, for the CARP and NEARP (see Genetic::decomposition) : target number of services
+	// of each subproblem (0 if not used), and number of iterations between two phases
+	int decompositionSize ;
+	int decompositionInterval ;
+
+	// island model over several processes : gencarp processes solving the same instance on the same host (typically with different seeds)
+	// exchange their best individuals through the POSIX shared-memory segment of this name (not used if empty), see IslandExchange.h,
+	// and number of iterations of the HGA between two migrations
+	string islandName ;
+	int islandInterval ;
+
+	// adaptive scheduling of the neighbourhoods of the local search : the neighbourhoods with a low recent success rate
+	// are skipped, see NeighbourhoodScheduler.h (otherwise all neighbourhoods are tested in the fixed order)
+	bool adaptiveScheduling ;
+
+	// adaptive granular search : the number of close customers of each customer in RI is adapted to the ranks of its recent improving moves,
+	// see Params::adapterGranularite (otherwise each customer keeps its "granularity" closest customers)
+	bool adaptiveGranularity ;
+
+	// says if the search stops as soon as its best solution reaches the lower bound computed at the start of the resolution (see LowerBound.h)
+	bool stopAtLowerBound ;
+
+	// memory budget of the resolution, in MB (0 if no budget) : the tunable structures of each run of the HGA are reduced to fit it,
+	// and the resolution stops with an error before building the population if this is not possible (see MemoryEstimate.h)
+	double maxMemory ;
+
+	// solves an instance file
+	SolverResult solve (string nomInstance) ;
+
+	// solves an instance given in memory
+	// the instance should stay available until the end of the resolution
+	SolverResult solve (const InstanceInput & instance) ;
+
+	// constructor, with the default settings
+	Solver (int type) ;
+
+	// destructor
+	~Solver () ;
+};
+
+#endif
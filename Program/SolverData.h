@@ -0,0 +1,182 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef SOLVER_DATA_H
+#define SOLVER_DATA_H
+
+#include <vector>
+#include <time.h>
+#include "Client.h"
+using namespace std ;
+
+/* ----------------- INSTANCE GIVEN IN MEMORY (INPUT OF THE SOLVER) ----------------- */
+
+// Service (required node, edge or arc) of an instance
+struct ServiceInput {
+
+	// AR_CLIENT_NODE, AR_CLIENT_EDGE or AR_CLIENT_ARC
+	ClientType nodeType ;
+
+	// extremities of the edge or arc (both equal to the node for a required node), numbered from 1
+	// an arc can only be serviced from node0 to node1
+	int node0 ;
+	int node1 ;
+
+	// demand of the service (for the PCARP, demand of each visit)
+	double demand ;
+
+	// cost of servicing from node0 to node1, and from node1 to node0 (ignored for an arc)
+	double serviceCost01 ;
+	double serviceCost10 ;
+
+	// cost of traversing the edge or arc without servicing it (ignored for a required node)
+	double travelCost01 ;
+	double travelCost10 ;
+
+	// number of visits over the five days of the PCARP (ignored for other problems)
+	int freq ;
+};
+
+// Link of the network which does not require a service (deadheading only)
+struct LinkInput {
+
+	// extremities of the link, numbered from 1
+	int node0 ;
+	int node1 ;
+
+	// traversal costs from node0 to node1, and from node1 to node0 (ignored for an arc)
+	double cost01 ;
+	double cost10 ;
+
+	// says if the link can only be traversed from node0 to node1
+	bool isArc ;
+};
+
+// Complete instance
+struct InstanceInput {
+
+	// number of nodes of the network
+	int nbNodes ;
+
+	// depot nodes (several depots only for the MDCARP)
+	vector <int> depots ;
+
+	// services and other links of the network
+	vector <ServiceInput> services ;
+	vector <LinkInput> links ;
+
+	// fleet size per depot as defined by the instance (-1 if not given, see the fleet conventions in Params::buildVehicles)
+	int nbVehicles ;
+
+	// vehicle capacity (ignored for the MM-kWRPP)
+	double capacity ;
+};
+
+/* ----------------- SOLUTION (OUTPUT OF THE SOLVER) ----------------- */
+
+// Visit of a route, with its orientation
+struct VisitResult {
+
+	// index of the service in InstanceInput::services (or in the order of the instance file), -1 for the depot
+	int service ;
+
+	// index of the depot, if this is a depot visit
+	int depot ;
+
+	// the service is done from node0 to node1 (node0 = node1 for nodes and depots)
+	int node0 ;
+	int node1 ;
+};
+
+// Route of the solution
+struct RouteResult {
+
+	// depot of the route
+	int depot ;
+
+	// day of the route (always 1, except for the PCARP)
+	int day ;
+
+	// total demand serviced by the route
+	double load ;
+
+	// cost of the route
+	double cost ;
+
+	// visits, starting and finishing at the depot
+	vector <VisitResult> visits ;
+};
+
+// Best solution found by the solver
+struct SolverResult {
+
+	// says if a feasible solution has been found (otherwise the other fields are not significant)
+	bool isFeasible ;
+
+	// total distance of the solution
+	double distance ;
+
+	// length of the maximum route (objective of the MM-kWRPP)
+	double maxRoute ;
+
+	// number of routes (for the PCARP, fleet size per day)
+	int nbRoutes ;
+
+	// clock time when the best solution was found
+	clock_t timeBest ;
+
+	// non-empty routes of the solution
+	vector <RouteResult> routes ;
+
+	// lower bound on the distance, computed at the start of the resolution (0 if not computed, see LowerBound.h),
+	// and says if the solution reaches it, and is therefore optimal
+	double lowerBound ;
+	bool isProvenOptimal ;
+
+	/* STATISTICS OF THE RESOLUTION (summed over the runs of the HGA) */
+
+	// number of iterations of the HGA
+	long long nbIterations ;
+
+	// number of moves applied by the local search
+	long long nbMovesLS ;
+
+	// number of move evaluations of the local search
+	long long nbEvaluationsLS ;
+
+	// number of calls to the Split algorithm
+	long long nbSplits ;
+
+	// for each neighbourhood of the local search (see NeighbourhoodScheduler.h) : number of evaluations, of improving moves,
+	// and of evaluations skipped by the adaptive scheduling
+	vector <long long> neighbourhoodEvaluations ;
+	vector <long long> neighbourhoodImprovements ;
+	vector <long long> neighbourhoodSkipped ;
+
+	// wall-clock time and CPU time of the resolution, in seconds
+	double wallTime ;
+	double cpuTime ;
+
+	// projected peak memory of the process at the start of the resolution, in kB (see MemoryEstimate.h)
+	long estimatedMemory ;
+
+	// peak resident memory of the process at the end of the resolution, in kB
+	long peakMemory ;
+};
+
+#endif
@@ -0,0 +1,59 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include "StopToken.h"
+#include <signal.h>
+
+StopToken * StopToken::tokenSignaux = NULL ;
+
+StopToken::StopToken()
+{
+	reset();
+}
+
+void StopToken::setDeadline (double secondes)
+{
+	deadline = chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(secondes)) ;
+	hasDeadline = true ;
+}
+
+void StopToken::reset ()
+{
+	isStopRequested.store(false);
+	hasDeadline = false ;
+}
+
+void StopToken::handlerSignaux (int signal)
+{
+	// Only async-signal-safe operations here
+	if (tokenSignaux == NULL || tokenSignaux->isStopRequested.load(memory_order_relaxed))
+	{
+		::signal(signal, SIG_DFL);
+		raise(signal);
+		return ;
+	}
+	tokenSignaux->requestStop();
+}
+
+void StopToken::installSignalHandlers (StopToken * token)
+{
+	static_assert(ATOMIC_BOOL_LOCK_FREE == 2, "the stop request must be lock-free to be set from a signal handler");
+	tokenSignaux = token ;
+	signal(SIGINT, handlerSignaux);
+	signal(SIGTERM, handlerSignaux);
+}
@@ -0,0 +1,74 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef STOP_TOKEN_H
+#define STOP_TOKEN_H
+
+#include <atomic>
+#include <chrono>
+using namespace std ;
+
+// Cooperative cancellation of the search
+// The search checks this token regularly (generations of the HGA, passes of the LS, loops on the fleet size or distance constraint),
+// and finishes as soon as possible with its best solution when a stop has been requested or when the wall-clock deadline is reached.
+class StopToken
+{
+
+private:
+
+	// says if a stop has been requested (lock-free, such that it can be set from another thread or from a signal handler)
+	atomic <bool> isStopRequested ;
+
+	// wall-clock deadline, and says if there is one
+	chrono::steady_clock::time_point deadline ;
+	bool hasDeadline ;
+
+	// token stopped by the signals SIGINT and SIGTERM (NULL if the signals are not handled)
+	static StopToken * tokenSignaux ;
+
+	// handler of SIGINT and SIGTERM : the first signal requests a graceful stop, a second one terminates the program
+	static void handlerSignaux (int signal);
+
+public:
+
+	// requests a stop of the search
+	void requestStop () { isStopRequested.store(true, memory_order_relaxed); }
+
+	// sets the deadline to a number of seconds from now
+	void setDeadline (double secondes);
+
+	// removes the deadline and the stop request (after a resolution)
+	void reset ();
+
+	// says if a stop has been requested (regardless of the deadline)
+	bool hasStopRequest () const { return isStopRequested.load(memory_order_relaxed) ; }
+
+	// says if the search should stop
+	bool isStopped () const
+	{
+		return isStopRequested.load(memory_order_relaxed) || (hasDeadline && chrono::steady_clock::now() >= deadline) ;
+	}
+
+	// SIGINT and SIGTERM will request a stop on this token
+	static void installSignalHandlers (StopToken * token);
+
+	// constructor
+	StopToken ();
+};
+
+#endif
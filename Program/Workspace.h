@@ -0,0 +1,64 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include <vector>
+using namespace std ;
+
+// Pre-definition, to allow compilation with self-references
+class Noeud ;
+struct EC_element ;
+
+// Scratch buffers of a search context (one for each Params, shared by the population, the individuals and their local searches)
+// Their capacity is reserved once, when the data of the instance is known, such that a generation of the HGA does not allocate any memory.
+// The buffers only keep temporary data during one call of the method that uses them.
+struct Workspace
+{
+	// ejection chains : random order of the routes, and ends of the chains
+	vector < Noeud * > ordreBins ;
+	vector < EC_element * > orderEnds ;
+
+	// biased fitness : ranking of the individuals, and their distances to the closest individuals
+	vector < int > classement ;
+	vector < double > distances ;
+
+	// crossover PIX : days in random order, end positions of the copied segments, kept visits of the first parent
+	vector < int > joursPerturb ;
+	vector < int > tableauFin ;
+	vector < int > garder ;
+	vector < vector < int > > garder2 ;
+
+	// reserves the capacity of all buffers for an instance
+	void reserve (int nbServices, int nbDays, int nbRoutes, int nbIndividus)
+	{
+		ordreBins.reserve(nbRoutes);
+		orderEnds.reserve(nbRoutes);
+		classement.reserve(nbIndividus);
+		distances.reserve(nbIndividus);
+		joursPerturb.reserve(nbDays+1);
+		tableauFin.reserve(nbDays+1);
+		garder.reserve(nbServices);
+		garder2 = vector < vector < int > > (nbDays+1);
+		for (int k=0 ; k <= nbDays ; k++)
+			garder2[k].reserve(nbServices);
+	}
+};
+
+#endif
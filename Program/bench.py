@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+#  ---------------------------------------------------------------------- #
+#   Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+#   Copyright (C) 2016 Thibaut VIDAL
+#
+#   This program is free software: you can redistribute it and/or modify
+#   it under the terms of the GNU General Public License as published by
+#   the Free Software Foundation, either version 3 of the License, or
+#   (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU General Public License for more details.
+#
+#   You should have received a copy of the GNU General Public License
+#   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#  ---------------------------------------------------------------------- #
+
+# Benchmark suite : runs gencarp on a curated subset of the instances, with fixed seeds and fixed iteration budgets,
+# measures the speed (iterations/s, LS moves/s, Split calls/s), the peak memory and the gap to the best known solution,
+# and compares these measures with the stored baseline (bench-baseline.json).
+# Exits with a non-zero status if a measure regresses beyond the thresholds of the baseline.
+#
+# Usage : python3 bench.py [--update] [--only name] [--gencarp path] [--gencarp-tp path] [--baseline path]
+#   --update      stores the measures of this run as the new baseline (the instances and thresholds are kept)
+#   --only        runs only the instances whose name contains the given string
+#   --gencarp-tp  program compiled with the flag TURN_PENALTIES (make TURN_PENALTIES=1), for the instances
+#                 with turn penalties, which are skipped otherwise
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+def run_instance(gencarp, inst, workdir):
+	# All output files go to a temporary directory, the BKS files of the Program directory are never touched
+	stats = os.path.join(workdir, inst["name"] + ".json")
+	cmd = [gencarp, inst["path"], "-type", str(inst["type"]), "-seed", str(inst["seed"]), "-iter", str(inst["iter"]),
+		"-t", "100000", "-sol", os.path.join(workdir, inst["name"] + ".sol"), "-bks", os.path.join(workdir, inst["name"] + ".bks"),
+		"-stats", stats] + inst.get("args", [])
+	proc = subprocess.run(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+	if proc.returncode != 0 or not os.path.exists(stats):
+		raise RuntimeError("run failed : " + " ".join(cmd) + "\n" + proc.stderr.decode(errors="replace"))
+	with open(stats) as f:
+		s = json.load(f)
+
+	# Objective : length of the maximum route for the MM-kWRPP, distance otherwise
+	cost = s["maxRoute"] if inst["type"] == 35 else s["distance"]
+	return {
+		"cost": cost if s["feasible"] else None,
+		"gap": (cost - inst["bks"]) / inst["bks"] if s["feasible"] else None,
+		"iterations": s["iterations"],
+		"wallTime": s["wallTime"],
+		"iterPerSec": s["iterations"] / s["wallTime"],
+		"movesPerSec": s["movesLS"] / s["wallTime"],
+		"splitsPerSec": s["splits"] / s["wallTime"],
+		"peakMemoryKB": s["peakMemoryKB"],
+	}
+
+def compare(inst, m, th):
+	# Returns the list of the regressions of the measures "m" with respect to the baseline of the instance
+	b = inst.get("baseline")
+	if b is None:
+		return ["no baseline"]
+	problems = []
+	if m["gap"] is None:
+		problems.append("no feasible solution")
+	elif b["gap"] is not None and m["gap"] > b["gap"] + th["gap"]:
+		problems.append("gap %.4f > baseline %.4f" % (m["gap"], b["gap"]))
+	for key in ("iterPerSec", "movesPerSec", "splitsPerSec"):
+		if m[key] < b[key] * (1.0 - th["speed"]):
+			problems.append("%s %.1f < baseline %.1f" % (key, m[key], b[key]))
+	if m["peakMemoryKB"] > b["peakMemoryKB"] * (1.0 + th["memory"]):
+		problems.append("peakMemoryKB %d > baseline %d" % (m["peakMemoryKB"], b["peakMemoryKB"]))
+	return problems
+
+def main():
+	here = os.path.dirname(os.path.abspath(__file__))
+	parser = argparse.ArgumentParser(description="HGS-CARP benchmark suite")
+	parser.add_argument("--update", action="store_true")
+	parser.add_argument("--only", default="")
+	parser.add_argument("--gencarp", default=os.path.join(here, "gencarp"))
+	parser.add_argument("--gencarp-tp", default="")
+	parser.add_argument("--baseline", default=os.path.join(here, "bench-baseline.json"))
+	args = parser.parse_args()
+
+	with open(args.baseline) as f:
+		config = json.load(f)
+	th = config["thresholds"]
+	workdir = tempfile.mkdtemp(prefix="gencarp-bench-")
+	nbRegressions = 0
+
+	print("%-22s %10s %8s %9s %11s %11s %9s  %s" % ("instance", "cost", "gap", "iter/s", "moves/s", "splits/s", "RSS(kB)", "status"))
+	try:
+		for inst in config["instances"]:
+			if args.only not in inst["name"]:
+				continue
+			if inst.get("turnPenalties", False) and args.gencarp_tp == "":
+				print("%-22s skipped (requires --gencarp-tp)" % inst["name"])
+				continue
+			inst["path"] = os.path.normpath(os.path.join(here, inst["path"]))
+			m = run_instance(args.gencarp_tp if inst.get("turnPenalties", False) else args.gencarp, inst, workdir)
+			problems = [] if args.update else compare(inst, m, th)
+			nbRegressions += len(problems)
+			print("%-22s %10s %8s %9.1f %11.1f %11.1f %9d  %s" % (inst["name"],
+				"NONE" if m["cost"] is None else "%g" % m["cost"],
+				"-" if m["gap"] is None else "%.2f%%" % (100 * m["gap"]),
+				m["iterPerSec"], m["movesPerSec"], m["splitsPerSec"], m["peakMemoryKB"],
+				"OK" if not problems else "REGRESSION : " + " ; ".join(problems)))
+			sys.stdout.flush()
+			inst["path"] = os.path.relpath(inst["path"], here)
+			if args.update:
+				inst["baseline"] = {key: (m[key] if m[key] is None else round(m[key], 6)) for key in ("gap", "iterPerSec", "movesPerSec", "splitsPerSec", "peakMemoryKB")}
+	finally:
+		shutil.rmtree(workdir, ignore_errors=True)
+
+	if args.update:
+		with open(args.baseline, "w") as f:
+			json.dump(config, f, indent=2)
+			f.write("\n")
+		print("Baseline updated : " + args.baseline)
+		return 0
+	if nbRegressions > 0:
+		print("%d regression(s) with respect to the baseline" % nbRegressions)
+		return 1
+	print("No regression with respect to the baseline")
+	return 0
+
+if __name__ == "__main__":
+	sys.exit(main())
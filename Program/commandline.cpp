@@ -31,17 +31,19 @@ void commandline::SetDefaultOutput(string to_parse)
 	{
 		output_name =  "sol-" + to_parse.substr(position+1,to_parse.length() - 1)  ;
 		BKS_name = "bks-" + to_parse.substr(position+1,to_parse.length() - 1)  ;
+		profile_name = "profile-" + to_parse.substr(position+1,to_parse.length() - 1) + ".json" ;
 	}
 	else
 	{
 		output_name = "sol-" + to_parse ;
 		BKS_name = "bks-" + to_parse ;
+		profile_name = "profile-" + to_parse + ".json" ;
 	}
 }
 
 commandline::commandline(int argc, char* argv[])
 {
-	if (argc%2 != 0 || argc > 14 || argc < 2)
+	if (argc%2 != 0 || argc > 58 || argc < 2)
 	{
 		cout << "incorrect command line" << endl ;
 		command_ok = false;
@@ -52,16 +54,42 @@ commandline::commandline(int argc, char* argv[])
 	instance_name = string(argv[1]);
 	SetDefaultOutput(string(argv[1]));
 	cpu_time = 300; // Five minutes is default CPU time
+	deadline = 0 ;
 	seed = 0;
 	type = -1 ;
 	nbVeh = -1 ;
 	nbDep = -1 ;
+	anytime_name = "" ;
+	cache_name = "" ;
+	checkpoint_name = "" ;
+	checkpoint_freq = 60 ;
+	resume_name = "" ;
+	init_name = "" ;
+	trace_name = "" ;
+	trace_interval = 100 ;
+	max_iterations = 0 ;
+	max_evaluations = 0 ;
+	max_splits = 0 ;
+	isTimeGiven = false ;
+	stats_name = "" ;
+	decomp_size = 0 ;
+	decomp_interval = 5000 ;
+	nbDep_proches = 0 ;
+	island_name = "" ;
+	island_interval = 100 ;
+	adaptive_ls = false ;
+	adaptive_granular = false ;
+	lb_stop = true ;
+	max_memory = 0 ;
 
 	// reading the commandline parameters
 	for ( int i = 2 ; i < argc ; i += 2 )
 	{
 		if ( string(argv[i]) == "-t" )
+		{
 			cpu_time = atoi(argv[i+1]);
+			isTimeGiven = true ;
+		}
 		else if ( string(argv[i]) == "-sol" )
 			output_name = string(argv[i+1]);
 		else if ( string(argv[i]) == "-bks" )
@@ -74,6 +102,52 @@ commandline::commandline(int argc, char* argv[])
 			nbVeh = atoi(argv[i+1]);
 		else if ( string(argv[i]) == "-dep" )
 			nbDep = atoi(argv[i+1]);
+		else if ( string(argv[i]) == "-anytime" )
+			anytime_name = string(argv[i+1]);
+		else if ( string(argv[i]) == "-cache" )
+			cache_name = string(argv[i+1]);
+		else if ( string(argv[i]) == "-checkpoint" )
+			checkpoint_name = string(argv[i+1]);
+		else if ( string(argv[i]) == "-checkpointfreq" )
+			checkpoint_freq = atoi(argv[i+1]);
+		else if ( string(argv[i]) == "-resume" )
+			resume_name = string(argv[i+1]);
+		else if ( string(argv[i]) == "-init" )
+			init_name = string(argv[i+1]);
+		else if ( string(argv[i]) == "-profile" )
+			profile_name = string(argv[i+1]);
+		else if ( string(argv[i]) == "-deadline" )
+			deadline = atof(argv[i+1]);
+		else if ( string(argv[i]) == "-trace" )
+			trace_name = string(argv[i+1]);
+		else if ( string(argv[i]) == "-traceinterval" )
+			trace_interval = atoi(argv[i+1]);
+		else if ( string(argv[i]) == "-iter" )
+			max_iterations = atoi(argv[i+1]);
+		else if ( string(argv[i]) == "-maxevals" )
+			max_evaluations = atoll(argv[i+1]);
+		else if ( string(argv[i]) == "-maxsplits" )
+			max_splits = atoll(argv[i+1]);
+		else if ( string(argv[i]) == "-stats" )
+			stats_name = string(argv[i+1]);
+		else if ( string(argv[i]) == "-decomp" )
+			decomp_size = atoi(argv[i+1]);
+		else if ( string(argv[i]) == "-decompinterval" )
+			decomp_interval = atoi(argv[i+1]);
+		else if ( string(argv[i]) == "-depk" )
+			nbDep_proches = atoi(argv[i+1]);
+		else if ( string(argv[i]) == "-island" )
+			island_name = string(argv[i+1]);
+		else if ( string(argv[i]) == "-islandinterval" )
+			island_interval = atoi(argv[i+1]);
+		else if ( string(argv[i]) == "-adaptivels" )
+			adaptive_ls = (atoi(argv[i+1]) != 0);
+		else if ( string(argv[i]) == "-adaptivegranular" )
+			adaptive_granular = (atoi(argv[i+1]) != 0);
+		else if ( string(argv[i]) == "-lbstop" )
+			lb_stop = (atoi(argv[i+1]) != 0);
+		else if ( string(argv[i]) == "-maxmem" )
+			max_memory = atof(argv[i+1]);
 		else
 		{
 			cout << "Non-recognized command : " << string(argv[i]) << endl ;
@@ -109,6 +183,14 @@ commandline::commandline(int argc, char* argv[])
 		return ;
 	}
 
+	// With a work budget, the run should not depend on the speed of the machine : no time limit unless one is given
+	if (!isTimeGiven && (max_iterations > 0 || max_evaluations > 0 || max_splits > 0))
+		cpu_time = INT_MAX ;
+
+	// When resuming a run, the checkpoints continue in the same file unless another one is given
+	if (resume_name != "" && checkpoint_name == "")
+		checkpoint_name = resume_name ;
+
 	command_ok = true;
 }
 
@@ -129,6 +211,116 @@ string commandline::get_path_to_BKS()
 	return BKS_name;
 }
 
+string commandline::get_path_to_anytime()
+{
+	return anytime_name;
+}
+
+string commandline::get_path_to_cache()
+{
+	return cache_name;
+}
+
+string commandline::get_path_to_checkpoint()
+{
+	return checkpoint_name;
+}
+
+string commandline::get_path_to_resume()
+{
+	return resume_name;
+}
+
+string commandline::get_path_to_init()
+{
+	return init_name;
+}
+
+string commandline::get_path_to_profile()
+{
+	return profile_name;
+}
+
+string commandline::get_path_to_trace()
+{
+	return trace_name;
+}
+
+int commandline::get_trace_interval()
+{
+	return trace_interval;
+}
+
+int commandline::get_max_iterations()
+{
+	return max_iterations;
+}
+
+string commandline::get_path_to_stats()
+{
+	return stats_name;
+}
+
+int commandline::get_decomp_size()
+{
+	return decomp_size;
+}
+
+int commandline::get_decomp_interval()
+{
+	return decomp_interval;
+}
+
+int commandline::get_nbDep_proches()
+{
+	return nbDep_proches;
+}
+
+string commandline::get_island_name()
+{
+	return island_name;
+}
+
+int commandline::get_island_interval()
+{
+	return island_interval;
+}
+
+bool commandline::get_adaptive_ls()
+{
+	return adaptive_ls;
+}
+
+bool commandline::get_adaptive_granular()
+{
+	return adaptive_granular;
+}
+
+bool commandline::get_lb_stop()
+{
+	return lb_stop;
+}
+
+double commandline::get_max_memory()
+{
+	return max_memory;
+}
+
+long long commandline::get_max_evaluations()
+{
+	return max_evaluations;
+}
+
+long long commandline::get_max_splits()
+{
+	return max_splits;
+}
+
+int commandline::get_checkpoint_freq()
+{
+	return checkpoint_freq;
+}
+
 int commandline::get_type()
 {
 	return type;
@@ -144,6 +336,11 @@ int commandline::get_nbDep()
 	return nbDep ;
 }
 
+double commandline::get_deadline()
+{
+	return deadline;
+}
+
 int commandline::get_cpu_time()
 {
 	return cpu_time;
@@ -21,6 +21,7 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <climits>
 #include <string>
 using namespace std;
 
@@ -31,9 +32,12 @@ class commandline
         // say if the commandline is valid
         bool command_ok;
 
-        // CPU time allowed
+        // time allowed for each run of the HGA (wall-clock seconds)
         int cpu_time;
 
+		// time allowed for the whole resolution (wall-clock seconds, 0 if no deadline)
+		double deadline;
+
 		// seed
 		int seed;
 
@@ -55,6 +59,66 @@ class commandline
 		// BKS path (used to replace it if a better solution is found)
 		string BKS_name;
 
+		// path of the file where each new best solution is written during the search (empty if not used)
+		string anytime_name;
+
+		// directory of the cache of preprocessed instances (empty if not used)
+		string cache_name;
+
+		// path of the checkpoint file where the state of the search is regularly saved (empty if not used)
+		string checkpoint_name;
+
+		// number of seconds between two checkpoints
+		int checkpoint_freq;
+
+		// path of the checkpoint file from which the search should be resumed (empty if not used)
+		string resume_name;
+
+		// path of a solution file used to warm start the population (empty if not used)
+		string init_name;
+
+		// path of the JSON file receiving the counters of the profiler (only for a program compiled with the flag PROFILING)
+		string profile_name;
+
+		// path of the CSV or JSONL trace of the convergence (empty if not used), and number of iterations between two periodic records
+		string trace_name;
+		int trace_interval;
+
+		// work budgets of each run of the HGA (0 if no limit) : iterations, move evaluations of the local search, calls to Split
+		int max_iterations;
+		long long max_evaluations;
+		long long max_splits;
+
+		// says if the time limit has been given
+		bool isTimeGiven;
+
+		// path of the JSON file receiving the solution value and the statistics of the resolution (empty if not used)
+		string stats_name;
+
+		// decomposition phases : target number of services of each subproblem (0 if not used), and number of iterations between two phases
+		int decomp_size;
+		int decomp_interval;
+
+		// (MDCARP) number of closest depots from which each service can be serviced (0 for all depots)
+		int nbDep_proches;
+
+		// name of the shared-memory segment used to exchange individuals with other processes solving the same instance (empty if not used),
+		// and number of iterations between two migrations
+		string island_name;
+		int island_interval;
+
+		// says if the neighbourhoods of the local search are scheduled from their recent success rates
+		bool adaptive_ls;
+
+		// says if the number of close customers of each customer is adapted to the ranks of its improving moves
+		bool adaptive_granular;
+
+		// says if the search stops when its best solution reaches the lower bound (CARP, NEARP and MDCARP)
+		bool lb_stop;
+
+		// memory budget in MB (0 if no budget), see MemoryEstimate.h
+		double max_memory;
+
 		// simple setters
         void SetDefaultOutput(string to_parse);
 
@@ -69,7 +133,30 @@ class commandline
         string get_path_to_instance();
         string get_path_to_solution();
         string get_path_to_BKS();
+        string get_path_to_anytime();
+        string get_path_to_cache();
+        string get_path_to_checkpoint();
+        string get_path_to_resume();
+        string get_path_to_init();
+        string get_path_to_profile();
+        string get_path_to_trace();
+        int get_trace_interval();
+        int get_max_iterations();
+        long long get_max_evaluations();
+        long long get_max_splits();
+        string get_path_to_stats();
+        int get_decomp_size();
+        int get_decomp_interval();
+        int get_nbDep_proches();
+        string get_island_name();
+        int get_island_interval();
+        bool get_adaptive_ls();
+        bool get_adaptive_granular();
+        bool get_lb_stop();
+        double get_max_memory();
+        int get_checkpoint_freq();
         int get_cpu_time();
+        double get_deadline();
 		int get_type();
 		int get_nbVeh();
 		int get_nbDep();
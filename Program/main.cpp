@@ -19,27 +19,17 @@
 #include <stdlib.h>
 #include <stdio.h> 
 #include <string>
-#include "Genetic.h"
+#include <unistd.h>
+#include "Solver.h"
+#include "Daemon.h"
 #include "commandline.h"
 
 using namespace std;
 
-int main (int argc, char *argv[])
+// Solves the problem described by a gencarp commandline
+// (called directly by main, or in the jobs of the daemon)
+int runCommandline (int argc, char *argv[])
 {
-	bool minFleetSize ;
-	bool minMaxTour ;
-	int nbpop = 0;
-	vector < Population * > populationTab ;
-	vector < Params * > mesParametresTab ;
-	Population * lastPop = NULL ;
-	Population * population2 ; 
-	Population * population ; 
-	Params * mesParametres ;
-	Params * mesParametres2 ;
-	clock_t nb_ticks_allowed;
-	int veh ;
-	double distConstraint ;
-	int nbOverallLoop = 0 ;
 	cout << endl ;
 
 	try
@@ -48,144 +38,47 @@ int main (int argc, char *argv[])
 		commandline c(argc, argv);
 
 		if (!c.is_valid())
-			throw string("Commandline could not be read, Usage : gencarp instance -type problemType [-t cpu-time] [-sol solutionPath]  [-s seed] [-veh nbVehicles] [-dep nbDepots]");
-
-		minFleetSize = (c.get_type() == 32) ; // For the PCARP, we need to minimize fleet size as first objective, then minimize distance as second objective
-		minMaxTour = (c.get_type() == 35) ; // For the MM-kWRPP, we need to minimize the length of the maximum route
-
-		/* CLASSIC CASE OF OPTIMIZATION, BASED ON DISTANCE : for the CVRP, CARP, NEARP, MDCARP... */
-		/* THIS IS THE MAIN START OF THE PROGRAM */
-		if (!minFleetSize && !minMaxTour)
-		{
-			// Number of clock ticks allowed for the program
-			nb_ticks_allowed = c.get_cpu_time() * CLOCKS_PER_SEC;
-
-			// initialisation of the Parameters
-			mesParametres = new Params(c.get_path_to_instance(),c.get_path_to_solution(),c.get_path_to_BKS(),c.get_seed(),c.get_type(),c.get_nbVeh(),c.get_nbDep(),false) ;
-
-			// Running the algorithm
-			population = new Population(mesParametres) ;
-			Genetic solver(mesParametres,population,nb_ticks_allowed,true);
-
-			solver.evolve(20000,1); // First parameter (20000) controls the number of iterations without improvement before termination
-
-			// Printing the solution
-			population->ExportBest(c.get_path_to_solution());
-			population->ExportBKS(c.get_path_to_BKS());
-
-			delete population ;
-			delete mesParametres ;
-			cout << endl ;
-			return 0 ;
-		}
-
-
-		/* SOME PROBLEMS CONSIDERED IN THE PAPER INVOLVE ANOTHER OBJECTIVE, such as fleet size minimization, or minimization of the maximum tour */
-		/* THIS IS DONE HERE BY RUNNING ITERATIVELY THE ALGORITHM with a decreasing fleet or distance constraint */
-		// fleet size minimization (minFleetSize = true) -- applying the algorithm with a decreasing fleet size, as long as a feasible solution is found
-		// or minimization of the maximum tour (minMaxTour = true) -- applying the algorithm with a decreasing tour duration constraint
-		else
-		{
-			veh = c.get_nbVeh(); // start with an upper bound on the number of vehicles
-			nb_ticks_allowed = c.get_cpu_time() * CLOCKS_PER_SEC;
-			distConstraint = 1.e30 ; // or with a permissive distance constraint
-			bool validExist = true;
-			while (validExist) // A feasible solution has been found, we can continue to decrease (either the number of vehicles or the distance constraint, depending on the case)
-			{	
-				// Setting the parameters of the next problem
-				mesParametresTab.push_back(new Params(c.get_path_to_instance(),c.get_path_to_solution(),c.get_path_to_BKS(),c.get_seed(),c.get_type(),veh,c.get_nbDep(),true)) ;
-				nbpop = (int)mesParametresTab.size() ;
-				nbOverallLoop ++ ; // counting the number of subproblems which have been resolved
-
-				// For safety, to evacuate any chance of infinite loop and printout.
-				// No considered instances should lead to more than 10000 overall modifications of the fleet size or distance constraint
-				if (nbOverallLoop >= 10000)
-					throw string ("Fleet or distance minimization, too many overall loops, there must be a problem, aborting the run");
-
-				// Setting the distance constraint (only effective for the MM-kWRPP)
-				for (int v=0 ; v < mesParametresTab[nbpop-1]->nbVehiculesPerDep ; v++) 
-					mesParametresTab[nbpop-1]->ordreVehicules[1][v].maxRouteTime = distConstraint ;
-				
-				if (minMaxTour && minFleetSize) throw string("This program was not designed to optimize jointly the fleet size and length of the maximum tour");
-
-				// Keeping the current penalty values
-				if (lastPop != NULL) 
-				{
-					mesParametresTab[nbpop-1]->penalityCapa = lastPop->params->penalityCapa ; 
-					mesParametresTab[nbpop-1]->penalityLength = lastPop->params->penalityLength ;
-				}
-
-				// Constructing the new population
-				populationTab.push_back (new Population(mesParametresTab[nbpop-1])) ;
-
-				// Adding the individuals found in previous iterations to help the search to start
-				if (nbpop >= 2) populationTab[nbpop-1]->addAllIndividus(populationTab[nbpop-2]);
-				if (nbpop >= 3) populationTab[nbpop-1]->addAllIndividus(populationTab[nbpop-3]);
-				// Solving
-				Genetic solver(mesParametresTab[nbpop-1],populationTab[nbpop-1],nb_ticks_allowed,true);
-				cout << "######### GA evolution ######### : " << "| FLEET SIZE : " << veh << " | DIST CONSTRAINT : " << mesParametresTab[nbpop-1]->ordreVehicules[1][0].maxRouteTime <<  endl ;
-				solver.evolve(2000,1);
-				
-				// Checking if we need to go to the next fleet or distance constraint value
-				if (populationTab[nbpop-1]->getIndividuBestValide () != NULL)
-				{
-					if (minFleetSize) 
-						veh -- ; // reducing the fleet size (PCARP)
-					else if (minMaxTour) 
-						distConstraint = populationTab[nbpop-1]->getIndividuBestValide()->maxRoute -1 ; // or reducing the distance below the best current solution (MM-kWRPP)
-				}
-				else 
-					validExist = false ;
-				
-				// in the case of fleet size minimization for the PCARP (type == 32), we can test to see if there is enough capacity left to service all customers (trivial lower bound on fleet size)
-				// in this case, don't need to pursue the search further
-				if (c.get_type() == 32 && mesParametresTab[nbpop-1]->totalDemand > veh*mesParametresTab[nbpop-1]->ordreVehicules[1][0].vehicleCapacity*mesParametresTab[nbpop-1]->nbDays) 
-				{
-					cout << "Insufficient capacity -- we can stop decreasing the fleet size" << endl ;
-					validExist = false ;
-				}
-
-				cout << "  " << endl ;
-			}
-
-			// Case of the minimization of the max route length
-			// At the end of the process, the search is finished, we return the solution
-			if (minMaxTour)
-			{
-				populationTab[nbpop-2]->ExportBest(c.get_path_to_solution());
-				populationTab[nbpop-2]->ExportBKS(c.get_path_to_BKS());
-			}
-			else
-			// Case of the minimization of the fleet size
-			// We should not forget the secondary objective in the hierarchy, which is now to minimize the distance for the resulting fleet size
-			// Thus, a last optimization run is done
-			{
-				veh ++ ;
-				cout << "######### Second phase : minimizing Distance with " << veh << " vehicles" << endl ;
-				mesParametres2 = new Params(c.get_path_to_instance(),c.get_path_to_solution(),c.get_path_to_BKS(),c.get_seed(),c.get_type(),veh,c.get_nbDep(),false) ;
-				population2 = new Population(mesParametres2) ;
-				if (nbpop >= 1 && populationTab[nbpop-1]->getIndividuBestValide() != NULL) 
-					population2->addAllIndividus(populationTab[nbpop-1]);
-				else if (nbpop >= 2) 
-					population2->addAllIndividus(populationTab[nbpop-2]);
-				Genetic solver(mesParametres2,population2,nb_ticks_allowed,true);
-				solver.evolve(10000,1);
-
-				// Returning the final solution
-				population2->ExportBest(c.get_path_to_solution());
-				population2->ExportBKS(c.get_path_to_BKS());
-				
-				// Clearing the data structures
-				delete population2 ;
-				delete mesParametres2 ;
-			}
-
-			// Clearing the data structures
-			FreeClear (populationTab) ;
-			FreeClear (mesParametresTab) ;
-			cout << endl ;
-			return 0;
-		}
+			throw string("Commandline could not be read, Usage : gencarp instance -type problemType [-t cpu-time] [-sol solutionPath]  [-s seed] [-veh nbVehicles] [-dep nbDepots] [-anytime anytimeSolutionPath] [-cache cacheDirectory] [-checkpoint checkpointPath] [-checkpointfreq seconds] [-resume checkpointPath] [-init initialSolutionPath] [-deadline seconds] [-profile profilePath] [-trace tracePath] [-traceinterval nbIterations] [-iter maxIterations] [-maxevals maxEvaluationsLS] [-maxsplits maxSplits] [-stats statisticsPath] [-decomp nbServices] [-decompinterval nbIterations] [-depk nbClosestDepots] [-island segmentName] [-islandinterval nbIterations] [-adaptivels 0|1] [-adaptivegranular 0|1] [-lbstop 0|1] [-maxmem megabytes], or : gencarp -daemon socketPath [-workers nbJobs] [-cachesize nbInstances]");
+
+		// Setting the solver from the commandline
+		Solver solver(c.get_type());
+		solver.seed = c.get_seed();
+		solver.timeLimit = c.get_cpu_time();
+		solver.deadline = c.get_deadline();
+		solver.nbVeh = c.get_nbVeh();
+		solver.nbDep = c.get_nbDep();
+		solver.pathToSolution = c.get_path_to_solution();
+		solver.pathToBKS = c.get_path_to_BKS();
+		solver.pathToAnytime = c.get_path_to_anytime();
+		solver.pathToCache = c.get_path_to_cache();
+		solver.pathToCheckpoint = c.get_path_to_checkpoint();
+		solver.checkpointFreq = c.get_checkpoint_freq();
+		solver.pathToResume = c.get_path_to_resume();
+		solver.pathToInit = c.get_path_to_init();
+		solver.pathToProfile = c.get_path_to_profile();
+		solver.pathToTrace = c.get_path_to_trace();
+		solver.traceInterval = c.get_trace_interval();
+		solver.maxIterations = c.get_max_iterations();
+		solver.maxEvaluationsLS = c.get_max_evaluations();
+		solver.maxSplits = c.get_max_splits();
+		solver.pathToStatistics = c.get_path_to_stats();
+		solver.decompositionSize = c.get_decomp_size();
+		solver.decompositionInterval = c.get_decomp_interval();
+		solver.nbDepotsProches = c.get_nbDep_proches();
+		solver.islandName = c.get_island_name();
+		solver.islandInterval = c.get_island_interval();
+		solver.adaptiveScheduling = c.get_adaptive_ls();
+		solver.adaptiveGranularity = c.get_adaptive_granular();
+		solver.stopAtLowerBound = c.get_lb_stop();
+		solver.maxMemory = c.get_max_memory();
+
+		// SIGINT and SIGTERM stop the search gracefully, with the best solution written as usual
+		StopToken::installSignalHandlers(&solver.stopToken);
+
+		// Running the algorithm, the solution is written in the solution file
+		solver.solve(c.get_path_to_instance());
+		cout << endl ;
+		return 0 ;
 	}
 	catch(const string& e)
 	{
@@ -194,3 +87,34 @@ int main (int argc, char *argv[])
 		return 0 ;
 	}
 }
+
+int main (int argc, char *argv[])
+{
+	// Daemon mode : the requests of gencarp-client are solved by this process, with the preprocessed instances kept in memory
+	if (argc >= 3 && string(argv[1]) == "-daemon")
+	{
+		int nbWorkers = (int)sysconf(_SC_NPROCESSORS_ONLN) ;
+		int capaciteCache = 16 ;
+		bool isValid = (argc % 2 == 1) ;
+		for (int i=3 ; i+1 < argc ; i += 2)
+		{
+			if (string(argv[i]) == "-workers") nbWorkers = atoi(argv[i+1]);
+			else if (string(argv[i]) == "-cachesize") capaciteCache = atoi(argv[i+1]);
+			else isValid = false ;
+		}
+		try
+		{
+			if (!isValid)
+				throw string("Commandline could not be read, Usage : gencarp -daemon socketPath [-workers nbJobs] [-cachesize nbInstances]");
+			Daemon daemon (argv[2], max(nbWorkers,1), max(capaciteCache,0), runCommandline) ;
+			daemon.run();
+		}
+		catch(const string& e)
+		{
+			cout << e << endl ;
+		}
+		return 0 ;
+	}
+
+	return runCommandline(argc, argv);
+}
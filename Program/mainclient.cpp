@@ -0,0 +1,128 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include <stdlib.h>
+#include <stdio.h> 
+#include <string.h>
+#include <errno.h>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "Daemon.h"
+
+using namespace std;
+
+// Client of the gencarp daemon (see Daemon.h)
+// Usage : gencarp-client socketPath [-inline] instance -type problemType [other options of gencarp]
+// The request is solved by the daemon with the same options as gencarp, and the output of the search is printed here.
+// With -inline, the content of the instance file is sent to the daemon, otherwise the daemon reads the file itself.
+
+// Writes all the data on the socket
+static bool ecrireDonnees (int fd, const char * data, size_t size)
+{
+	while (size > 0)
+	{
+		ssize_t n = write(fd, data, size);
+		if (n < 0 && errno == EINTR) continue ;
+		if (n <= 0) return false ;
+		data += n ;
+		size -= n ;
+	}
+	return true ;
+}
+
+int main (int argc, char *argv[])
+{
+	struct sockaddr_un adresse ;
+	ostringstream requete ;
+	vector <string> arguments ;
+	string contenu ;
+	char repertoire [4096] ;
+	char buffer [4096] ;
+	ssize_t n ;
+
+	int debut = 2 ;
+	bool isInline = (argc >= 3 && string(argv[2]) == "-inline") ;
+	if (isInline) debut = 3 ;
+	if (argc < debut + 1)
+	{
+		cout << "Commandline could not be read, Usage : gencarp-client socketPath [-inline] instance -type problemType [other options of gencarp]" << endl ;
+		return 1 ;
+	}
+	for (int i=debut ; i < argc ; i++)
+		arguments.push_back(argv[i]);
+
+	if (isInline)
+	{
+		ifstream fichier (arguments[0].c_str(), ios::binary);
+		if (!fichier.is_open())
+		{
+			cout << "Impossible to find instance file " << arguments[0] << endl ;
+			return 1 ;
+		}
+		ostringstream lecture ;
+		lecture << fichier.rdbuf();
+		contenu = lecture.str();
+	}
+	if (getcwd(repertoire, sizeof(repertoire)) == NULL)
+	{
+		cout << "Impossible to get the working directory" << endl ;
+		return 1 ;
+	}
+
+	// Building the request
+	requete << DAEMON_MAGIC << "\n" << repertoire << "\n" << arguments.size() << "\n" ;
+	for (int i=0 ; i < (int)arguments.size() ; i++)
+		requete << arguments[i] << "\n" ;
+	requete << contenu.size() << "\n" << contenu ;
+
+	// Connecting to the daemon
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	memset(&adresse, 0, sizeof(adresse));
+	adresse.sun_family = AF_UNIX ;
+	strncpy(adresse.sun_path, argv[1], sizeof(adresse.sun_path) - 1);
+	if (fd < 0 || connect(fd, (struct sockaddr *)&adresse, sizeof(adresse)) != 0)
+	{
+		cout << "Impossible to connect to the daemon on " << argv[1] << endl ;
+		return 1 ;
+	}
+
+	// Sending the request, then printing the output of the job until the daemon closes the connection
+	string texte = requete.str() ;
+	if (!ecrireDonnees(fd, texte.data(), texte.size()))
+	{
+		cout << "Impossible to send the request to the daemon" << endl ;
+		close(fd);
+		return 1 ;
+	}
+	shutdown(fd, SHUT_WR);
+	while ((n = read(fd, buffer, sizeof(buffer))) != 0)
+	{
+		if (n < 0 && errno == EINTR) continue ;
+		if (n < 0) break ;
+		fwrite(buffer, 1, n, stdout);
+		fflush(stdout);
+	}
+	close(fd);
+	return 0 ;
+}
@@ -0,0 +1,313 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include "Params.h"
+#include "Individu.h"
+#include "LocalSearch.h"
+#include "Route.h"
+#include "SeqData.h"
+
+using namespace std ;
+
+// Microbenchmarks of the hot kernels of the search : SeqData concatenations and evaluations, Split, Route::updateRouteData and ejection chains
+// The kernels are measured in isolation on synthetic routes of controlled length, built from the services of a real instance
+// Usage : gencarp-microbench instance -type problemType [-veh nbVehicles] [-dep nbDepots] [-len routeLength] [-reps repetitions] [-seed seed]
+// The SeqData structure used depends on the build : two service modes by default, or any number of modes with "make TURN_PENALTIES=1"
+
+// value accumulated from the results of the kernels, such that the compiler does not remove the measured calls
+static double puits = 0 ;
+
+// Chronometer, in nanoseconds per operation
+struct Chrono
+{
+	chrono::steady_clock::time_point debut ;
+	void start () { debut = chrono::steady_clock::now() ; }
+	double nsPerOp (long long nbOps) { return chrono::duration<double,nano>(chrono::steady_clock::now() - debut).count() / (double)max(nbOps,1LL) ; }
+};
+
+static void afficheMesure (string nom, double nsPerOp, long long nbOps)
+{
+	cout.setf(ios::fixed);
+	cout.precision(1);
+	cout << "  " << nom ;
+	for (int i = (int)nom.length() ; i < 34 ; i++) cout << " " ;
+	cout << nsPerOp << " ns/op  (" << nbOps << " ops)" << endl ;
+}
+
+// Loads in the local search synthetic routes of "longueur" services, following the giant tour of the individual
+// (the last route of each day receives all remaining services if the fleet is too small)
+static void chargerRoutes (Individu * indiv, Params * params, int longueur)
+{
+	for (int k = 1 ; k <= params->nbDays ; k++)
+	{
+		int nbVeh = params->nombreVehicules[k] ;
+		int j = (int)indiv->chromT[k].size() ;
+		for (int jj = 0 ; jj < nbVeh ; jj++)
+		{
+			int i = (jj < nbVeh - 1) ? max(0, j - longueur) : 0 ;
+			indiv->pred[k][nbVeh - jj][j] = i ;
+			j = i ;
+		}
+	}
+	indiv->updateLS();
+}
+
+int main (int argc, char *argv[])
+{
+	string nomInstance ;
+	int type = -1 ;
+	int nbVeh = -1 ;
+	int nbDep = -1 ;
+	int longueur = 10 ;
+	int nbReps = 200 ;
+	int seed = 1 ;
+
+	if (argc < 4 || argc % 2 != 0)
+	{
+		cout << "Usage : gencarp-microbench instance -type problemType [-veh nbVehicles] [-dep nbDepots] [-len routeLength] [-reps repetitions] [-seed seed]" << endl ;
+		return 1 ;
+	}
+	nomInstance = string(argv[1]);
+	for (int i = 2 ; i < argc ; i += 2)
+	{
+		if (string(argv[i]) == "-type") type = atoi(argv[i+1]);
+		else if (string(argv[i]) == "-veh") nbVeh = atoi(argv[i+1]);
+		else if (string(argv[i]) == "-dep") nbDep = atoi(argv[i+1]);
+		else if (string(argv[i]) == "-len") longueur = max(1,atoi(argv[i+1]));
+		else if (string(argv[i]) == "-reps") nbReps = max(1,atoi(argv[i+1]));
+		else if (string(argv[i]) == "-seed") seed = atoi(argv[i+1]);
+		else
+		{
+			cout << "Non-recognized command : " << string(argv[i]) << endl ;
+			return 1 ;
+		}
+	}
+
+	try
+	{
+		Params * params = new Params(nomInstance,"","",seed,type,nbVeh,nbDep,false,"") ;
+		Individu * indiv = new Individu(params,true) ;
+		indiv->localSearch = new LocalSearch(params,indiv) ;
+		Chrono chrono ;
+		long long nbOps ;
+
+		#ifndef TURN_PENALTIES
+		cout << "SeqData build : two service modes" << endl ;
+		#else
+		cout << "SeqData build : turn penalties (" << params->ar_maxNbModes << " modes)" << endl ;
+		#endif
+		cout << "Instance : " << nomInstance << " | Services : " << params->nbClients << " | Route length : " << longueur << " | Repetitions : " << nbReps << endl ;
+
+		/* SEQDATA CONCATENATIONS AND EVALUATIONS, on the routes of day 1 */
+		// prefixes[r][p] : depot followed by the p first services of route r
+		// suffixes[r][p] : services p+1 ... of route r followed by the depot
+		// uniques[r][p] : service p+1 of route r alone
+		vector <int> & tour = indiv->chromT[1] ;
+		int depot = params->ordreVehicules[1][0].depotNumber ;
+		Vehicle * vehicle = &params->ordreVehicules[1][0] ;
+		int nbRoutes = ((int)tour.size() + longueur - 1) / longueur ;
+		vector < vector <SeqData *> > prefixes (nbRoutes), suffixes (nbRoutes), uniques (nbRoutes) ;
+		vector < int > tailles (nbRoutes) ;
+		for (int r = 0 ; r < nbRoutes ; r++)
+		{
+			tailles[r] = min(longueur, (int)tour.size() - r*longueur) ;
+			for (int p = 0 ; p <= tailles[r] ; p++)
+			{
+				prefixes[r].push_back(new SeqData(params));
+				suffixes[r].push_back(new SeqData(params));
+				uniques[r].push_back(new SeqData(params));
+			}
+		}
+		SeqData evaluateur (params) ;
+
+		cout << endl << "SeqData" << endl ;
+		chrono.start();
+		nbOps = 0 ;
+		for (int rep = 0 ; rep < nbReps ; rep++)
+			for (int r = 0 ; r < nbRoutes ; r++)
+			{
+				prefixes[r][0]->initialisation(depot,params,indiv,1,false);
+				for (int p = 0 ; p < tailles[r] ; p++)
+					prefixes[r][p+1]->concatOneAfter(prefixes[r][p],tour[r*longueur+p],indiv,1);
+				nbOps += tailles[r] ;
+			}
+		afficheMesure("concatOneAfter",chrono.nsPerOp(nbOps),nbOps);
+
+		chrono.start();
+		nbOps = 0 ;
+		for (int rep = 0 ; rep < nbReps ; rep++)
+			for (int r = 0 ; r < nbRoutes ; r++)
+			{
+				suffixes[r][tailles[r]]->initialisation(depot,params,indiv,1,false);
+				for (int p = tailles[r]-1 ; p >= 0 ; p--)
+					suffixes[r][p]->concatOneBefore(suffixes[r][p+1],tour[r*longueur+p],indiv,1);
+				nbOps += tailles[r] ;
+			}
+		afficheMesure("concatOneBefore",chrono.nsPerOp(nbOps),nbOps);
+
+		// complete routes, from the depot to the depot
+		vector <SeqData *> routesCompletes ;
+		for (int r = 0 ; r < nbRoutes ; r++)
+		{
+			for (int p = 0 ; p < tailles[r] ; p++)
+				uniques[r][p]->initialisation(tour[r*longueur+p],params,indiv,1,false);
+			routesCompletes.push_back(new SeqData(params));
+			routesCompletes[r]->concatOneAfter(prefixes[r][tailles[r]],depot,indiv,1);
+		}
+
+		// Evaluations, with the arity of the moves : complete route (1), split of the route (2), relocate (3) and swap (4) of services
+		vector <SeqData *> seqs (3) ;
+		for (int lb = 0 ; lb <= 1 ; lb++)
+		{
+			string suffixe = (lb == 0) ? "" : "LB" ;
+			chrono.start();
+			nbOps = 0 ;
+			for (int rep = 0 ; rep < nbReps ; rep++)
+				for (int r = 0 ; r < nbRoutes ; r++)
+				{
+					puits += (lb == 0) ? evaluateur.evaluation(routesCompletes[r],vehicle) : evaluateur.evaluationLB(routesCompletes[r],vehicle) ;
+					nbOps ++ ;
+				}
+			afficheMesure("evaluation" + suffixe + " (1 sequence)",chrono.nsPerOp(nbOps),nbOps);
+
+			chrono.start();
+			nbOps = 0 ;
+			for (int rep = 0 ; rep < nbReps ; rep++)
+				for (int r = 0 ; r < nbRoutes ; r++)
+					for (int p = 0 ; p <= tailles[r] ; p++)
+					{
+						puits += (lb == 0) ? evaluateur.evaluation(prefixes[r][p],suffixes[r][p],vehicle) : evaluateur.evaluationLB(prefixes[r][p],suffixes[r][p],vehicle) ;
+						nbOps ++ ;
+					}
+			afficheMesure("evaluation" + suffixe + " (2 sequences)",chrono.nsPerOp(nbOps),nbOps);
+
+			chrono.start();
+			nbOps = 0 ;
+			for (int rep = 0 ; rep < nbReps ; rep++)
+				for (int r = 0 ; r < nbRoutes ; r++)
+					for (int p = 0 ; p < tailles[r] ; p++)
+					{
+						puits += (lb == 0) ? evaluateur.evaluation(prefixes[r][p],uniques[r][p],suffixes[r][p+1],vehicle) : evaluateur.evaluationLB(prefixes[r][p],uniques[r][p],suffixes[r][p+1],vehicle) ;
+						nbOps ++ ;
+					}
+			afficheMesure("evaluation" + suffixe + " (3 sequences)",chrono.nsPerOp(nbOps),nbOps);
+
+			chrono.start();
+			nbOps = 0 ;
+			for (int rep = 0 ; rep < nbReps ; rep++)
+				for (int r = 0 ; r < nbRoutes ; r++)
+					for (int p = 0 ; p+1 < tailles[r] ; p++)
+					{
+						puits += (lb == 0) ? evaluateur.evaluation(prefixes[r][p],uniques[r][p+1],uniques[r][p],suffixes[r][p+2],vehicle) : evaluateur.evaluationLB(prefixes[r][p],uniques[r][p+1],uniques[r][p],suffixes[r][p+2],vehicle) ;
+						nbOps ++ ;
+					}
+			afficheMesure("evaluation" + suffixe + " (4 sequences)",chrono.nsPerOp(nbOps),nbOps);
+
+			chrono.start();
+			nbOps = 0 ;
+			for (int rep = 0 ; rep < nbReps ; rep++)
+				for (int r = 0 ; r < nbRoutes ; r++)
+					for (int p = 0 ; p < tailles[r] ; p++)
+					{
+						seqs[0] = prefixes[r][p] ;
+						seqs[1] = uniques[r][p] ;
+						seqs[2] = suffixes[r][p+1] ;
+						puits += (lb == 0) ? evaluateur.evaluation(seqs,vehicle) : evaluateur.evaluationLB(seqs,vehicle) ;
+						nbOps ++ ;
+					}
+			afficheMesure("evaluation" + suffixe + " (vector of 3)",chrono.nsPerOp(nbOps),nbOps);
+		}
+
+		/* SPLIT, on the giant tour of each day */
+		cout << endl << "Split (complete giant tours, " << params->nbDays << " day(s))" << endl ;
+		chrono.start();
+		nbOps = 0 ;
+		for (int rep = 0 ; rep < nbReps ; rep++)
+			for (int k = 1 ; k <= params->nbDays ; k++)
+				if (!indiv->chromT[k].empty())
+				{
+					puits += indiv->splitSimple(k) ;
+					nbOps ++ ;
+				}
+		afficheMesure("splitSimple",chrono.nsPerOp(nbOps),nbOps);
+
+		chrono.start();
+		nbOps = 0 ;
+		for (int rep = 0 ; rep < nbReps ; rep++)
+			for (int k = 1 ; k <= params->nbDays ; k++)
+				if (!indiv->chromT[k].empty())
+				{
+					indiv->splitLF(k);
+					nbOps ++ ;
+				}
+		afficheMesure("splitLF",chrono.nsPerOp(nbOps),nbOps);
+
+		/* LOCAL SEARCH STRUCTURES, on synthetic routes */
+		cout << endl << "Local search" << endl ;
+		chargerRoutes(indiv,params,longueur);
+		chrono.start();
+		nbOps = 0 ;
+		for (int rep = 0 ; rep < nbReps ; rep++)
+			for (int k = 1 ; k <= params->nbDays ; k++)
+				for (int r = 0 ; r < params->nombreVehicules[k] ; r++)
+				{
+					indiv->localSearch->routes[k][r].updateRouteData(false);
+					nbOps ++ ;
+				}
+		afficheMesure("Route::updateRouteData",chrono.nsPerOp(nbOps),nbOps);
+
+		// The ejection chains modify the solution, the synthetic routes are loaded again before each call (not measured)
+		double total = 0 ;
+		nbOps = 0 ;
+		for (int rep = 0 ; rep < nbReps ; rep++)
+			for (int k = 1 ; k <= params->nbDays ; k++)
+			{
+				chargerRoutes(indiv,params,longueur);
+				chrono.start();
+				puits += indiv->localSearch->ejectionChains(k) ;
+				total += chrono.nsPerOp(1) ;
+				nbOps ++ ;
+			}
+		afficheMesure("LocalSearch::ejectionChains",total/(double)max(nbOps,1LL),nbOps);
+
+		cout << endl << "(checksum " << puits << ")" << endl ;
+		for (int r = 0 ; r < nbRoutes ; r++)
+		{
+			for (int p = 0 ; p <= tailles[r] ; p++)
+			{
+				delete prefixes[r][p] ;
+				delete suffixes[r][p] ;
+				delete uniques[r][p] ;
+			}
+			delete routesCompletes[r] ;
+		}
+		delete indiv ;
+		delete params ;
+	}
+	catch(const string& e)
+	{
+		cout << "EXCEPTION | " << e << endl ;
+		return 1 ;
+	}
+	return 0 ;
+}
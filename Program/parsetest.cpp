@@ -0,0 +1,182 @@
+/*  ---------------------------------------------------------------------- //
+    Hybrid Genetic Search for Arc Routing Problems -- HGS-CARP
+    Copyright (C) 2016 Thibaut VIDAL
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//  ---------------------------------------------------------------------- */
+
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include "Params.h"
+#include "InstanceReader.h"
+
+using namespace std ;
+
+// Test of the memory-mapped tokenizer of the instances (see InstanceReader.h)
+// Each instance of a directory is parsed twice, once with the original stream operations (reference mode of InstanceReader) and once with the tokenizer,
+// and all the data resulting from the parsing and the preprocessing (the data stored in the cache files, see InstanceCache.h, and the vehicles) must be identical
+// Usage : gencarp-parsetest directory -type problemType [-veh nbVehicles] [-dep nbDepots]
+
+// Writes the values of a vector or a matrix
+template <class T> static void decrire (ostringstream & out, const vector <T> & valeurs)
+{
+	out << valeurs.size() << " :" ;
+	for (int i = 0 ; i < (int)valeurs.size() ; i++) out << " " << valeurs[i] ;
+	out << endl ;
+}
+
+template <class T> static void decrire (ostringstream & out, const vector < vector <T> > & valeurs)
+{
+	for (int i = 0 ; i < (int)valeurs.size() ; i++) decrire(out,valeurs[i]);
+}
+
+// Describes all the data of the Params which results from the parsing and the preprocessing (the same data as in the cache files, see InstanceCache.cpp, and the vehicles)
+// The coordinates are not part of the description as the instances do not define them, and the services are described by their extremities and costs,
+// or by their service modes for the instances with turn penalties
+static string decrire (Params * params)
+{
+	ostringstream out ;
+	int nbNoeuds = params->nbClients + params->nbDepots ;
+	out.precision(17);
+	out << params->multiDepot << " " << params->periodique << " " << params->isTurnPenalties << " " << params->ar_NodesRequired << " " << params->ar_NodesNonRequired << " "
+		<< params->ar_EdgesRequired << " " << params->ar_EdgesNonRequired << " " << params->ar_ArcsRequired << " " << params->ar_ArcsNonRequired << " "
+		<< params->ar_nbArcsDistance << " " << params->ar_nbTurns << " " << params->ar_maxNbModes << " " << params->ar_tempIndexDepot << " " << params->parsing_courNbArcs << " "
+		<< params->nbClients << " " << params->nbTotalServices << " " << params->totalDemand << " " << params->nbDays << " " << params->ancienNbDays << " "
+		<< params->nbDepots << " " << params->nbVehiculesFichier << " " << params->vehicleCapacity << endl ;
+
+	decrire(out,params->ar_distanceNodes);
+	decrire(out,params->ar_distanceArcs);
+	for (int i = 0 ; i < (int)params->ar_Arcs.size() ; i++)
+		out << params->ar_Arcs[i].indexArc << " " << params->ar_Arcs[i].nodeBegin << " " << params->ar_Arcs[i].nodeEnd << " " << params->ar_Arcs[i].cost << " " << params->ar_Arcs[i].nb_Turns << endl ;
+	for (int i = 0 ; i < nbNoeuds ; i++)
+	{
+		for (int j = 0 ; j < nbNoeuds ; j++) out << " " << params->timeCost[i][j] << " " << params->isCorrelated[i][j] ;
+		out << endl ;
+	}
+
+	for (int i = 0 ; i < nbNoeuds ; i++)
+	{
+		Client * c = &params->cli[i] ;
+		out << c->custNum << " " << c->serviceDuration << " " << c->demand << " " << c->freq << " " << (int)c->ar_nodeType << endl ;
+		if (!params->isTurnPenalties)
+			out << c->ar_nodesExtr0 << " " << c->ar_nodesExtr1 << " " << c->ar_serviceCost01 << " " << c->ar_serviceCost10 << endl ;
+		else
+		{
+			out << c->ar_nbModes << " :" ;
+			for (int k = 0 ; k < (int)c->ar_Modes.size() ; k++) out << " " << (int)(c->ar_Modes[k] - &params->ar_Arcs[0]) ;
+			out << endl ;
+		}
+		for (int k = 0 ; k < (int)c->visits.size() ; k++) out << " " << c->visits[k].pat << " " << c->visits[k].dep << " " << c->visits[k].cost ;
+		out << endl ;
+		for (int k = 0 ; k < (int)c->visitsOrigin.size() ; k++) out << " " << c->visitsOrigin[k].pat << " " << c->visitsOrigin[k].dep << " " << c->visitsOrigin[k].cost ;
+		out << endl ;
+		decrire(out,c->jourSuiv);
+		decrire(out,c->demandPatDay);
+		decrire(out,c->ordreProximiteDepots);
+		decrire(out,c->sommetsVoisins);
+		decrire(out,c->sommetsVoisinsAvant);
+	}
+
+	for (int k = 1 ; k <= params->nbDays ; k++)
+		for (int i = 0 ; i < (int)params->ordreVehicules[k].size() ; i++)
+			out << params->ordreVehicules[k][i].depotNumber << " " << params->ordreVehicules[k][i].vehicleCapacity << endl ;
+	return out.str() ;
+}
+
+// Builds the Params of an instance and describes its data (or returns the error message if the instance can not be read)
+static string lireInstance (string nomInstance, int type, int nbVeh, int nbDep, bool isReference)
+{
+	string resultat ;
+	InstanceReader::isReference = isReference ;
+	try
+	{
+		Params * params = new Params(nomInstance,"","",1,type,nbVeh,nbDep,false,"") ;
+		resultat = decrire(params);
+		delete params ;
+	}
+	catch (const string & e)
+	{
+		resultat = "ERROR" + e ;
+	}
+	InstanceReader::isReference = false ;
+	return resultat ;
+}
+
+int main (int argc, char *argv[])
+{
+	string nomDossier ;
+	int type = -1 ;
+	int nbVeh = -1 ;
+	int nbDep = -1 ;
+	vector <string> instances ;
+	int nbDifferences = 0 ;
+
+	if (argc < 4 || argc % 2 != 0)
+	{
+		cout << "Usage : gencarp-parsetest directory -type problemType [-veh nbVehicles] [-dep nbDepots]" << endl ;
+		return 1 ;
+	}
+	nomDossier = string(argv[1]);
+	for (int i = 2 ; i < argc ; i += 2)
+	{
+		if (string(argv[i]) == "-type") type = atoi(argv[i+1]);
+		else if (string(argv[i]) == "-veh") nbVeh = atoi(argv[i+1]);
+		else if (string(argv[i]) == "-dep") nbDep = atoi(argv[i+1]);
+		else
+		{
+			cout << "Non-recognized command : " << string(argv[i]) << endl ;
+			return 1 ;
+		}
+	}
+
+	// Listing the instances of the directory (the README files are not instances)
+	DIR * dossier = opendir(nomDossier.c_str());
+	if (dossier == NULL)
+	{
+		cout << "Impossible to open the directory " << nomDossier << endl ;
+		return 1 ;
+	}
+	struct dirent * entree ;
+	while ((entree = readdir(dossier)) != NULL)
+	{
+		string nom = string(entree->d_name) ;
+		if (nom[0] != '.' && nom.find("README") == string::npos)
+			instances.push_back(nomDossier + "/" + nom);
+	}
+	closedir(dossier);
+	sort(instances.begin(),instances.end());
+
+	// The output of the parsers is not of interest here
+	streambuf * sortie = cout.rdbuf();
+	for (int i = 0 ; i < (int)instances.size() ; i++)
+	{
+		cout.rdbuf(NULL);
+		string reference = lireInstance(instances[i],type,nbVeh,nbDep,true);
+		string tokenizer = lireInstance(instances[i],type,nbVeh,nbDep,false);
+		cout.rdbuf(sortie);
+		if (reference != tokenizer)
+		{
+			cout << "DIFFERENCE : " << instances[i] << " -type " << type << endl ;
+			nbDifferences ++ ;
+		}
+	}
+	cout << nomDossier << " -type " << type << " : " << instances.size() << " instances, " << nbDifferences << " differences" << endl ;
+	return (nbDifferences == 0) ? 0 : 1 ;
+}